@@ -0,0 +1,10 @@
+#pragma once
+
+// ------------------ Allocation counter ------------------
+// The global operator new is replaced (AllocationCounter.cpp) with a thin
+// malloc wrapper that counts calls, so the benchmark can check that
+// steady-state frames make no heap allocations. Counting is one relaxed
+// atomic increment per allocation.
+
+// Heap allocations made through operator new since the process started
+long long heapAllocations();
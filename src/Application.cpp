@@ -2,29 +2,58 @@
 #include <GLFW/glfw3.h>
 #include <windows.h>
 #include <GL/glu.h>
+#include <algorithm>
 #include <cmath>   
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "Batch.h"
+#include "Benchmark.h"
+#include "FrameArena.h"
+#include "FrameCache.h"
+#include "FramePipeline.h"
+#include "FrameStats.h"
+#include "GeometryBuffer.h"
+#include "Headless.h"
+#include "ImmediateMode.h"
+#include "Instancing.h"
+#include "LineBatch.h"
+#include "LineCleanup.h"
+#include "Lod.h"
+#include "Picking.h"
+#include "Scene.h"
+#include "SheetView.h"
+#include "SpatialIndex.h"
+#include "Stroke.h"
+#include "ThreadPool.h"
+#include "TileCache.h"
+#include "UnitCircle.h"
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 // ------------------ Camera Controls ------------------
-float scrollX = 0.0f;
-float scrollY = 0.0f;
+double scrollX = 0.0; // world units; double so a site kilometres across pans smoothly
+double scrollY = 0.0;
 float zoomLevel = 50.0f; // Initial zoom
 
 // ------------------ CLASSES ------------------
 
-void drawBrownWindow(float x_left, float y_bottom, float x_right, float y_top) {
+void drawBrownWindow(GeometryBuffer& out, float x_left, float y_bottom, float x_right, float y_top) {
     float window_width = x_right - x_left;
     float window_height = y_top - y_bottom;
 
     float line_r = 0.94f;
     float line_g = 0.49f;
     float line_b = 0.17f; // A bright orange/brown frame
-    glColor3f(line_r, line_g, line_b);
-    glLineWidth(3.1f); // Increase line thickness to better represent the image's structure 
+    out.Color3f(line_r, line_g, line_b);
+    out.LineWidth(3.1f); // Increase line thickness to better represent the image's structure 
 
-    glBegin(GL_LINES);
+    out.Begin(GL_LINES);
 
     // A. Draw the Horizontal Slats 
     // The frame has about 20 horizontal divisions for the slats.
@@ -33,110 +62,129 @@ void drawBrownWindow(float x_left, float y_bottom, float x_right, float y_top) {
     // We only need to draw 'horizontal_slats - 1' lines
     for (int i = 1; i < horizontal_slats; ++i) {
         float y = y_bottom + (window_height / horizontal_slats) * i;
-        glVertex2f(x_left, y);
-        glVertex2f(x_right, y);
+        out.Vertex2f(x_left, y);
+        out.Vertex2f(x_right, y);
     }
 
     // B. Draw the Diagonal Cross-Bracing Lines (the 'X')
 
     // 1. Bottom-left to top-right
-    glVertex2f(x_left, y_bottom);
-    glVertex2f(x_right, y_top);
+    out.Vertex2f(x_left, y_bottom);
+    out.Vertex2f(x_right, y_top);
 
     // 2. Top-left to bottom-right
-    glVertex2f(x_left, y_top);
-    glVertex2f(x_right, y_bottom);
+    out.Vertex2f(x_left, y_top);
+    out.Vertex2f(x_right, y_bottom);
 
     // C. Draw a simple frame for the window edge (Optional, but helps define the border)
     // Left border
-    glVertex2f(x_left, y_bottom);
-    glVertex2f(x_left, y_top);
+    out.Vertex2f(x_left, y_bottom);
+    out.Vertex2f(x_left, y_top);
     // Right border
-    glVertex2f(x_right, y_bottom);
-    glVertex2f(x_right, y_top);
+    out.Vertex2f(x_right, y_bottom);
+    out.Vertex2f(x_right, y_top);
     // Bottom border
-    glVertex2f(x_left, y_bottom);
-    glVertex2f(x_right, y_bottom);
+    out.Vertex2f(x_left, y_bottom);
+    out.Vertex2f(x_right, y_bottom);
     // Top border
-    glVertex2f(x_left, y_top);
-    glVertex2f(x_right, y_top);
+    out.Vertex2f(x_left, y_top);
+    out.Vertex2f(x_right, y_top);
 
-    glEnd();
-    glLineWidth(1.0f); // Reset line thickness
+    out.End();
+    out.LineWidth(1.0f); // Reset line thickness
 }
 
 void drawRectangle(float x1, float y1, float x2, float y2, float r, float g, float b) {
-    glColor3f(r, g, b);
-    glBegin(GL_POLYGON);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y1);
-    glVertex2f(x2, y2);
-    glVertex2f(x1, y2);
-    glEnd();
+    imColor3f(r, g, b);
+    imBegin(GL_POLYGON);
+    imVertex2f(x1, y1);
+    imVertex2f(x2, y1);
+    imVertex2f(x2, y2);
+    imVertex2f(x1, y2);
+    imEnd();
 
     // Outline in dark grey
-    glColor3f(0.3f, 0.3f, 0.3f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y1);
-    glVertex2f(x2, y2);
-    glVertex2f(x1, y2);
-    glEnd();
+    imColor3f(0.3f, 0.3f, 0.3f);
+    imBegin(GL_LINE_LOOP);
+    imVertex2f(x1, y1);
+    imVertex2f(x2, y1);
+    imVertex2f(x2, y2);
+    imVertex2f(x1, y2);
+    imEnd();
+}
+
+// Same rectangle, recorded into 'out'
+void drawRectangle(GeometryBuffer& out, float x1, float y1, float x2, float y2, float r, float g, float b) {
+    out.Color3f(r, g, b);
+    out.Begin(GL_POLYGON);
+    out.Vertex2f(x1, y1);
+    out.Vertex2f(x2, y1);
+    out.Vertex2f(x2, y2);
+    out.Vertex2f(x1, y2);
+    out.End();
+
+    // Outline in dark grey
+    out.Color3f(0.3f, 0.3f, 0.3f);
+    out.Begin(GL_LINE_LOOP);
+    out.Vertex2f(x1, y1);
+    out.Vertex2f(x2, y1);
+    out.Vertex2f(x2, y2);
+    out.Vertex2f(x1, y2);
+    out.End();
 }
 
 // Utility to draw a U-shape curve
 void drawUShape(float cx, float cy, float radius, int segments) {
-    glBegin(GL_LINE_STRIP);
-    for (int i = 0; i <= segments; i++) {
-        float theta = M_PI * (float)i / (float)segments; // half-circle
-        float x = cx + radius * cos(theta);
-        float y = cy - radius * sin(theta);
-        glVertex2f(x, y);
-    }
-    glEnd();
+    ArcTable arc = unitArc(segments, 0.0f, (float)M_PI); // half-circle
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(arc, cx, cy, radius, -radius, xs, ys);
+
+    imBegin(GL_LINE_STRIP);
+    for (int i = 0; i <= arc.segments; i++) {
+        imVertex2f(xs[i], ys[i]);
+    }
+    imEnd();
 }
 
 // Utility to draw a filled circle (supports alpha)
-void drawCircleFilled(float cx, float cy, float r, int segments, float cr, float cg, float cb, float ca) {
-    glColor4f(cr, cg, cb, ca);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(cx, cy);
-    for (int i = 0; i <= segments; ++i) {
-        float theta = 2.0f * (float)M_PI * (float)i / (float)segments;
-        float x = cx + r * cosf(theta);
-        float y = cy + r * sinf(theta);
-        glVertex2f(x, y);
-    }
-    glEnd();
+void drawCircleFilled(GeometryBuffer& out, float cx, float cy, float r, int segments, float cr, float cg, float cb, float ca) {
+    out.Color4f(cr, cg, cb, ca);
+    ArcTable circle = unitCircle(segments);
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(circle, cx, cy, r, r, xs, ys);
+
+    out.Begin(GL_TRIANGLE_FAN);
+    out.Vertex2f(cx, cy);
+    for (int i = 0; i <= circle.segments; ++i) {
+        out.Vertex2f(xs[i], ys[i]);
+    }
+    out.End();
 }
 
 // Utility to draw a realistic 3D flower with petals and center
-void drawRealisticFlower(float cx, float cy, float size, float r, float g, float b) {
+void drawRealisticFlower(GeometryBuffer& out, float cx, float cy, float size, float r, float g, float b) {
     // Draw shadow first (darker, slightly offset)
-    drawCircleFilled(cx + size * 0.1f, cy - size * 0.1f, size * 1.1f, 8, 0.0f, 0.0f, 0.0f, 0.2f);
+    drawCircleFilled(out, cx + size * 0.1f, cy - size * 0.1f, size * 1.1f, 8, 0.0f, 0.0f, 0.0f, 0.2f);
 
     // Draw outer petals (larger, lighter)
     float petalSize = size * 1.2f;
-    glColor3f(r * 0.8f, g * 0.8f, b * 0.8f); // slightly darker outer petals
+    float petalX[6], petalY[6];
+    arcPoints(unitCircle(5), cx, cy, size * 0.3f, size * 0.3f, petalX, petalY);
+    out.Color3f(r * 0.8f, g * 0.8f, b * 0.8f); // slightly darker outer petals
     for (int i = 0; i < 5; i++) {
-        float angle = (float)i * 2.0f * M_PI / 5.0f;
-        float petalX = cx + cosf(angle) * size * 0.3f;
-        float petalY = cy + sinf(angle) * size * 0.3f;
-        drawCircleFilled(petalX, petalY, petalSize * 0.4f, 6, r * 0.8f, g * 0.8f, b * 0.8f, 1.0f);
+        drawCircleFilled(out, petalX[i], petalY[i], petalSize * 0.4f, 6, r * 0.8f, g * 0.8f, b * 0.8f, 1.0f);
     }
 
     // Draw main flower body
-    drawCircleFilled(cx, cy, size, 8, r, g, b, 1.0f);
+    drawCircleFilled(out, cx, cy, size, 8, r, g, b, 1.0f);
 
     // Draw inner petals (smaller, brighter)
-    glColor3f(r * 1.2f > 1.0f ? 1.0f : r * 1.2f,
+    out.Color3f(r * 1.2f > 1.0f ? 1.0f : r * 1.2f,
         g * 1.2f > 1.0f ? 1.0f : g * 1.2f,
         b * 1.2f > 1.0f ? 1.0f : b * 1.2f);
+    arcPoints(unitArc(3, 0.5f, 0.5f + 2.0f * (float)M_PI), cx, cy, size * 0.15f, size * 0.15f, petalX, petalY);
     for (int i = 0; i < 3; i++) {
-        float angle = (float)i * 2.0f * M_PI / 3.0f + 0.5f;
-        float petalX = cx + cosf(angle) * size * 0.15f;
-        float petalY = cy + sinf(angle) * size * 0.15f;
-        drawCircleFilled(petalX, petalY, size * 0.25f, 4,
+        drawCircleFilled(out, petalX[i], petalY[i], size * 0.25f, 4,
             r * 1.2f > 1.0f ? 1.0f : r * 1.2f,
             g * 1.2f > 1.0f ? 1.0f : g * 1.2f,
             b * 1.2f > 1.0f ? 1.0f : b * 1.2f, 1.0f);
@@ -146,82 +194,120 @@ void drawRealisticFlower(float cx, float cy, float size, float r, float g, float
     float centerR = (r > 0.5f) ? 0.2f : 0.8f;
     float centerG = (g > 0.5f) ? 0.2f : 0.8f;
     float centerB = (b > 0.5f) ? 0.2f : 0.8f;
-    drawCircleFilled(cx, cy, size * 0.2f, 6, centerR, centerG, centerB, 1.0f);
+    drawCircleFilled(out, cx, cy, size * 0.2f, 6, centerR, centerG, centerB, 1.0f);
 
     // Add tiny center highlight
-    drawCircleFilled(cx - size * 0.05f, cy + size * 0.05f, size * 0.08f, 4, 1.0f, 1.0f, 1.0f, 0.8f);
+    drawCircleFilled(out, cx - size * 0.05f, cy + size * 0.05f, size * 0.08f, 4, 1.0f, 1.0f, 1.0f, 0.8f);
 }
 
 // Utility to draw a circle outline
 void drawCircleLine(float cx, float cy, float r, int segments, float cr, float cg, float cb) {
-    glColor3f(cr, cg, cb);
-    glBegin(GL_LINE_LOOP);
-    for (int i = 0; i < segments; ++i) {
-        float theta = 2.0f * (float)M_PI * (float)i / (float)segments;
-        float x = cx + r * cosf(theta);
-        float y = cy + r * sinf(theta);
-        glVertex2f(x, y);
-    }
-    glEnd();
+    imColor3f(cr, cg, cb);
+    ArcTable circle = unitCircle(segments);
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(circle, cx, cy, r, r, xs, ys);
+
+    imBegin(GL_LINE_LOOP);
+    for (int i = 0; i < circle.segments; ++i) {
+        imVertex2f(xs[i], ys[i]);
+    }
+    imEnd();
 }
 
-// Utility to draw rectangular flower box matching window width
-void drawFlowerBox(float x1, float y1, float x2, float y2, float height) {
+// Flower boxes come in three detail levels: a flat band of greenery and
+// bloom colour, then stems with plain discs for the flowers and the filler
+// blooms, then the full planting with shaded flowers, tiny blooms and leaves
+const int kFlowerBoxLevels = 3;
+
+// Box height on screen (pixels) above which each finer level is used
+const float kFlowerBoxLevelPixels[kFlowerBoxLevels - 1] = { 20.0f, 80.0f };
+
+// Main flower of a box: the realistic flower at full detail, a disc of its colour below that
+void drawBoxFlower(GeometryBuffer& out, int level, float cx, float cy, float size, float r, float g, float b) {
+    if (level >= 2)
+        drawRealisticFlower(out, cx, cy, size, r, g, b);
+    else
+        drawCircleFilled(out, cx, cy, size, 6, r, g, b, 1.0f);
+}
+
+// Tessellates a rectangular flower box matching window width into 'out' at
+// the given detail level
+void buildFlowerBox(GeometryBuffer& out, float x1, float y1, float x2, float y2, float height, int level) {
     // Box base (rectangular to match window width)
-    glColor3f(0.6f, 0.4f, 0.2f); // brown box
-    glBegin(GL_QUADS);
-    glVertex2f(x1, y1 - height * 0.4f);
-    glVertex2f(x2, y1 - height * 0.4f);
-    glVertex2f(x2, y1 + height * 0.2f);
-    glVertex2f(x1, y1 + height * 0.2f);
-    glEnd();
+    out.Color3f(0.6f, 0.4f, 0.2f); // brown box
+    out.Begin(GL_QUADS);
+    out.Vertex2f(x1, y1 - height * 0.4f);
+    out.Vertex2f(x2, y1 - height * 0.4f);
+    out.Vertex2f(x2, y1 + height * 0.2f);
+    out.Vertex2f(x1, y1 + height * 0.2f);
+    out.End();
 
     // Box rim
-    glColor3f(0.5f, 0.3f, 0.15f);
-    glBegin(GL_QUADS);
-    glVertex2f(x1 - 0.01f, y1 + height * 0.15f);
-    glVertex2f(x2 + 0.01f, y1 + height * 0.15f);
-    glVertex2f(x2, y1 + height * 0.2f);
-    glVertex2f(x1, y1 + height * 0.2f);
-    glEnd();
+    out.Color3f(0.5f, 0.3f, 0.15f);
+    out.Begin(GL_QUADS);
+    out.Vertex2f(x1 - 0.01f, y1 + height * 0.15f);
+    out.Vertex2f(x2 + 0.01f, y1 + height * 0.15f);
+    out.Vertex2f(x2, y1 + height * 0.2f);
+    out.Vertex2f(x1, y1 + height * 0.2f);
+    out.End();
 
     // Soil
-    glColor3f(0.4f, 0.2f, 0.1f);
-    glBegin(GL_QUADS);
-    glVertex2f(x1 + 0.01f, y1 + height * 0.1f);
-    glVertex2f(x2 - 0.01f, y1 + height * 0.1f);
-    glVertex2f(x2 - 0.01f, y1 + height * 0.2f);
-    glVertex2f(x1 + 0.01f, y1 + height * 0.2f);
-    glEnd();
+    out.Color3f(0.4f, 0.2f, 0.1f);
+    out.Begin(GL_QUADS);
+    out.Vertex2f(x1 + 0.01f, y1 + height * 0.1f);
+    out.Vertex2f(x2 - 0.01f, y1 + height * 0.1f);
+    out.Vertex2f(x2 - 0.01f, y1 + height * 0.2f);
+    out.Vertex2f(x1 + 0.01f, y1 + height * 0.2f);
+    out.End();
+
+    if (level == 0) {
+        // Greenery band with the average bloom colour on top
+        out.Color3f(0.2f, 0.6f, 0.2f);
+        out.Begin(GL_QUADS);
+        out.Vertex2f(x1, y1 + height * 0.2f);
+        out.Vertex2f(x2, y1 + height * 0.2f);
+        out.Vertex2f(x2, y1 + height * 0.4f);
+        out.Vertex2f(x1, y1 + height * 0.4f);
+        out.End();
+
+        out.Color3f(0.85f, 0.6f, 0.62f);
+        out.Begin(GL_QUADS);
+        out.Vertex2f(x1, y1 + height * 0.4f);
+        out.Vertex2f(x2, y1 + height * 0.4f);
+        out.Vertex2f(x2, y1 + height * 0.6f);
+        out.Vertex2f(x1, y1 + height * 0.6f);
+        out.End();
+        return;
+    }
 
     // Extremely dense flower stems and greenery (no empty spaces)
-    glColor3f(0.2f, 0.6f, 0.2f);
-    glLineWidth(2.0f);
-    glBegin(GL_LINES);
+    out.Color3f(0.2f, 0.6f, 0.2f);
+    out.LineWidth(2.0f);
+    out.Begin(GL_LINES);
     float boxWidth = x2 - x1;
     float cx = (x1 + x2) * 0.5f; // center x
     int numStems = (int)(boxWidth * 80.0f); // overflowing dense stems
     for (int i = 0; i < numStems; i++) {
         float stemX = x1 + 0.005f + (boxWidth - 0.01f) * (float)i / (float)(numStems - 1);
         float stemHeight = height * (0.15f + 0.3f * sinf(stemX * 30.0f + (float)i * 0.3f)); // shorter stems
-        glVertex2f(stemX, y1 + height * 0.2f);
-        glVertex2f(stemX, y1 + height * 0.2f + stemHeight);
+        out.Vertex2f(stemX, y1 + height * 0.2f);
+        out.Vertex2f(stemX, y1 + height * 0.2f + stemHeight);
     }
-    glEnd();
+    out.End();
 
     // Add dense greenery/foliage stems
-    glColor3f(0.15f, 0.5f, 0.15f); // darker green for variety
-    glLineWidth(1.5f);
-    glBegin(GL_LINES);
+    out.Color3f(0.15f, 0.5f, 0.15f); // darker green for variety
+    out.LineWidth(1.5f);
+    out.Begin(GL_LINES);
     int greeneryStems = (int)(boxWidth * 60.0f);
     for (int i = 0; i < greeneryStems; i++) {
         float stemX = x1 + 0.008f + (boxWidth - 0.016f) * (float)i / (float)(greeneryStems - 1);
         float stemHeight = height * (0.1f + 0.2f * sinf(stemX * 35.0f + (float)i * 0.8f)); // shorter greenery stems
-        glVertex2f(stemX, y1 + height * 0.2f);
-        glVertex2f(stemX, y1 + height * 0.2f + stemHeight);
+        out.Vertex2f(stemX, y1 + height * 0.2f);
+        out.Vertex2f(stemX, y1 + height * 0.2f + stemHeight);
     }
-    glEnd();
-    glLineWidth(1.0f);
+    out.End();
+    out.LineWidth(1.0f);
 
     // Extremely dense summer flowers (no empty spaces)
     for (int i = 0; i < numStems; i++) {
@@ -231,21 +317,21 @@ void drawFlowerBox(float x1, float y1, float x2, float y2, float height) {
 
         // Expanded summer flower colors (15 different colors)
         switch (i % 15) {
-        case 0: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.2f, 0.2f); break; // red
-        case 1: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.8f, 0.0f); break; // yellow
-        case 2: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.8f, 0.2f, 0.8f); break; // purple
-        case 3: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.4f, 0.7f); break; // pink
-        case 4: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.2f, 0.6f, 1.0f); break; // blue
-        case 5: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 1.0f, 0.2f); break; // bright yellow
-        case 6: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.9f, 0.5f, 0.1f); break; // orange
-        case 7: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.8f, 0.8f, 1.0f); break; // light blue
-        case 8: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.6f, 0.8f); break; // light pink
-        case 9: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.7f, 1.0f, 0.7f); break; // light green
-        case 10: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.9f, 0.6f); break; // cream
-        case 11: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.9f, 0.7f, 1.0f); break; // lavender
-        case 12: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.5f, 0.5f); break; // coral
-        case 13: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.5f, 1.0f, 0.8f); break; // mint green
-        case 14: drawRealisticFlower(stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.8f, 0.9f); break; // pale rose
+        case 0: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.2f, 0.2f); break; // red
+        case 1: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.8f, 0.0f); break; // yellow
+        case 2: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.8f, 0.2f, 0.8f); break; // purple
+        case 3: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.4f, 0.7f); break; // pink
+        case 4: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.2f, 0.6f, 1.0f); break; // blue
+        case 5: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 1.0f, 0.2f); break; // bright yellow
+        case 6: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.9f, 0.5f, 0.1f); break; // orange
+        case 7: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.8f, 0.8f, 1.0f); break; // light blue
+        case 8: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.6f, 0.8f); break; // light pink
+        case 9: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.7f, 1.0f, 0.7f); break; // light green
+        case 10: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.9f, 0.6f); break; // cream
+        case 11: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.9f, 0.7f, 1.0f); break; // lavender
+        case 12: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.5f, 0.5f); break; // coral
+        case 13: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 0.5f, 1.0f, 0.8f); break; // mint green
+        case 14: drawBoxFlower(out, level, stemX, y1 + height * 0.2f + stemHeight, flowerSize, 1.0f, 0.8f, 0.9f); break; // pale rose
         }
     }
 
@@ -258,17 +344,20 @@ void drawFlowerBox(float x1, float y1, float x2, float y2, float height) {
 
         // Small filler flowers in bright summer colors
         switch (i % 8) {
-        case 0: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.3f, 0.3f, 1.0f); break; // bright red
-        case 1: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 1.0f, 1.0f, 0.3f, 1.0f); break; // bright yellow
-        case 2: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 0.3f, 0.3f, 1.0f, 1.0f); break; // bright blue
-        case 3: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.3f, 1.0f, 1.0f); break; // bright magenta
-        case 4: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 0.3f, 1.0f, 0.3f, 1.0f); break; // bright green
-        case 5: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.6f, 0.3f, 1.0f); break; // bright orange
-        case 6: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 0.8f, 0.3f, 0.8f, 1.0f); break; // bright purple
-        case 7: drawCircleFilled(flowerX, flowerY, smallFlowerSize, 6, 0.3f, 0.8f, 0.8f, 1.0f); break; // bright cyan
+        case 0: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.3f, 0.3f, 1.0f); break; // bright red
+        case 1: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 1.0f, 1.0f, 0.3f, 1.0f); break; // bright yellow
+        case 2: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 0.3f, 0.3f, 1.0f, 1.0f); break; // bright blue
+        case 3: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.3f, 1.0f, 1.0f); break; // bright magenta
+        case 4: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 0.3f, 1.0f, 0.3f, 1.0f); break; // bright green
+        case 5: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 1.0f, 0.6f, 0.3f, 1.0f); break; // bright orange
+        case 6: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 0.8f, 0.3f, 0.8f, 1.0f); break; // bright purple
+        case 7: drawCircleFilled(out, flowerX, flowerY, smallFlowerSize, 6, 0.3f, 0.8f, 0.8f, 1.0f); break; // bright cyan
         }
     }
 
+    if (level < 2)
+        return;
+
     // Third layer of tiny flowers to fill remaining gaps
     int tinyFlowers = (int)(boxWidth * 120.0f); // even more tiny blooms
     for (int i = 0; i < tinyFlowers; i++) {
@@ -278,16 +367,16 @@ void drawFlowerBox(float x1, float y1, float x2, float y2, float height) {
 
         // Tiny flowers in pastel colors
         switch (i % 10) {
-        case 0: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.7f, 0.7f, 1.0f); break; // pale red
-        case 1: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 1.0f, 0.7f, 1.0f); break; // pale yellow
-        case 2: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 0.7f, 1.0f, 1.0f); break; // pale blue
-        case 3: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.7f, 1.0f, 1.0f); break; // pale magenta
-        case 4: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 1.0f, 0.7f, 1.0f); break; // pale green
-        case 5: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.9f, 0.7f, 1.0f); break; // pale orange
-        case 6: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 0.9f, 0.7f, 1.0f, 1.0f); break; // pale purple
-        case 7: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 1.0f, 1.0f, 1.0f); break; // pale cyan
-        case 8: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.8f, 0.8f, 1.0f); break; // pale pink
-        case 9: drawCircleFilled(flowerX, flowerY, tinyFlowerSize, 4, 0.8f, 1.0f, 0.8f, 1.0f); break; // pale mint
+        case 0: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.7f, 0.7f, 1.0f); break; // pale red
+        case 1: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 1.0f, 0.7f, 1.0f); break; // pale yellow
+        case 2: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 0.7f, 1.0f, 1.0f); break; // pale blue
+        case 3: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.7f, 1.0f, 1.0f); break; // pale magenta
+        case 4: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 1.0f, 0.7f, 1.0f); break; // pale green
+        case 5: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.9f, 0.7f, 1.0f); break; // pale orange
+        case 6: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 0.9f, 0.7f, 1.0f, 1.0f); break; // pale purple
+        case 7: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 0.7f, 1.0f, 1.0f, 1.0f); break; // pale cyan
+        case 8: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 1.0f, 0.8f, 0.8f, 1.0f); break; // pale pink
+        case 9: drawCircleFilled(out, flowerX, flowerY, tinyFlowerSize, 4, 0.8f, 1.0f, 0.8f, 1.0f); break; // pale mint
         }
     }
 
@@ -300,38 +389,92 @@ void drawFlowerBox(float x1, float y1, float x2, float y2, float height) {
 
         // Green leaves in various shades
         switch (i % 5) {
-        case 0: drawCircleFilled(leafX, leafY, leafSize, 3, 0.2f, 0.6f, 0.2f, 1.0f); break; // dark green
-        case 1: drawCircleFilled(leafX, leafY, leafSize, 3, 0.3f, 0.7f, 0.3f, 1.0f); break; // medium green
-        case 2: drawCircleFilled(leafX, leafY, leafSize, 3, 0.4f, 0.8f, 0.4f, 1.0f); break; // light green
-        case 3: drawCircleFilled(leafX, leafY, leafSize, 3, 0.1f, 0.5f, 0.1f, 1.0f); break; // very dark green
-        case 4: drawCircleFilled(leafX, leafY, leafSize, 3, 0.5f, 0.9f, 0.5f, 1.0f); break; // very light green
+        case 0: drawCircleFilled(out, leafX, leafY, leafSize, 3, 0.2f, 0.6f, 0.2f, 1.0f); break; // dark green
+        case 1: drawCircleFilled(out, leafX, leafY, leafSize, 3, 0.3f, 0.7f, 0.3f, 1.0f); break; // medium green
+        case 2: drawCircleFilled(out, leafX, leafY, leafSize, 3, 0.4f, 0.8f, 0.4f, 1.0f); break; // light green
+        case 3: drawCircleFilled(out, leafX, leafY, leafSize, 3, 0.1f, 0.5f, 0.1f, 1.0f); break; // very dark green
+        case 4: drawCircleFilled(out, leafX, leafY, leafSize, 3, 0.5f, 0.9f, 0.5f, 1.0f); break; // very light green
         }
     }
 }
 
-// Forward declaration for the OPEN sign's text rendering helper
-void drawOpenText(float cx, float cy, float letterWidth, float letterHeight, float spacing);
+// Flower boxes depend only on their placement, so each level of each box is
+// tessellated once, when it is first shown, and replayed on later frames.
+// The cached geometry is already placed on the sheet, so a box is keyed by
+// its rectangle in its view's drawing space together with that placement.
+struct FlowerBoxKey {
+    float x1, y1, x2, y2, height;
+    float a, b, c, d, tx, ty;   // placement
+
+    FlowerBoxKey(float x1, float y1, float x2, float y2, float height, const Affine2D& m)
+        : x1(x1), y1(y1), x2(x2), y2(y2), height(height), a(m.a), b(m.b), c(m.c), d(m.d), tx(m.tx), ty(m.ty) {}
+
+    bool operator<(const FlowerBoxKey& o) const {
+        return std::tie(x1, y1, x2, y2, height, a, b, c, d, tx, ty) <
+            std::tie(o.x1, o.y1, o.x2, o.y2, o.height, o.a, o.b, o.c, o.d, o.tx, o.ty);
+    }
+};
+
+struct FlowerBox {
+    LodSelector lod;
+    GeometryBuffer levels[kFlowerBoxLevels];
+};
+
+std::map<FlowerBoxKey, FlowerBox> flowerBoxCache;
+
+static void buildPlacedFlowerBox(GeometryBuffer& out, float x1, float y1, float x2, float y2, float height,
+    int level, const Affine2D& placement) {
+    buildFlowerBox(out, x1, y1, x2, y2, height, level);
+    out.Transform(placement);
+}
+
+// Utility to draw rectangular flower box matching window width, placed on
+// the sheet by 'placement'. 'unitPixels' is the on-screen size of one unit
+// of the box's drawing space.
+void drawFlowerBox(float x1, float y1, float x2, float y2, float height, const Affine2D& placement, float unitPixels) {
+    FlowerBox& box = flowerBoxCache[FlowerBoxKey(x1, y1, x2, y2, height, placement)];
+    int level = box.lod.Select(height * unitPixels, kFlowerBoxLevelPixels, kFlowerBoxLevels - 1);
+
+    GeometryBuffer& geometry = box.levels[level];
+    if (geometry.Empty())
+        buildPlacedFlowerBox(geometry, x1, y1, x2, y2, height, level, placement);
+    geometry.Draw();
+}
+
+// Queues the tessellation of every level of a flower box on 'pool'. The
+// cache entry is created here, on the calling thread; each task only fills
+// its own buffer.
+void prepareFlowerBox(ThreadPool& pool, float x1, float y1, float x2, float y2, float height, const Affine2D& placement) {
+    FlowerBox& box = flowerBoxCache[FlowerBoxKey(x1, y1, x2, y2, height, placement)];
+    for (int level = 0; level < kFlowerBoxLevels; ++level) {
+        GeometryBuffer* geometry = &box.levels[level];
+        if (geometry->Empty())
+            pool.Submit([=] { buildPlacedFlowerBox(*geometry, x1, y1, x2, y2, height, level, placement); });
+    }
+}
+
+void drawOpenText(GeometryBuffer& out, float cx, float cy, float letterWidth, float letterHeight, float spacing);
 
 // Utility to draw text-like rectangles for OPEN sign
-void drawOpenSign(float cx, float cy, float width, float height) {
+void drawOpenSign(GeometryBuffer& out, float cx, float cy, float width, float height) {
     // Sign background (brighter fluorescent effect)
-    glColor4f(0.1f, 1.0f, 0.3f, 0.85f); // Brighter green
-    glBegin(GL_QUADS);
-    glVertex2f(cx - width * 0.5f, cy - height * 0.5f);
-    glVertex2f(cx + width * 0.5f, cy - height * 0.5f);
-    glVertex2f(cx + width * 0.5f, cy + height * 0.5f);
-    glVertex2f(cx - width * 0.5f, cy + height * 0.5f);
-    glEnd();
+    out.Color4f(0.1f, 1.0f, 0.3f, 0.85f); // Brighter green
+    out.Begin(GL_QUADS);
+    out.Vertex2f(cx - width * 0.5f, cy - height * 0.5f);
+    out.Vertex2f(cx + width * 0.5f, cy - height * 0.5f);
+    out.Vertex2f(cx + width * 0.5f, cy + height * 0.5f);
+    out.Vertex2f(cx - width * 0.5f, cy + height * 0.5f);
+    out.End();
 
     // Sign border
-    glColor3f(0.0f, 0.5f, 0.1f); // Darker green
-    glLineWidth(1.5f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(cx - width * 0.5f, cy - height * 0.5f);
-    glVertex2f(cx + width * 0.5f, cy - height * 0.5f);
-    glVertex2f(cx + width * 0.5f, cy + height * 0.5f);
-    glVertex2f(cx - width * 0.5f, cy + height * 0.5f);
-    glEnd();
+    out.Color3f(0.0f, 0.5f, 0.1f); // Darker green
+    out.LineWidth(1.5f);
+    out.Begin(GL_LINE_LOOP);
+    out.Vertex2f(cx - width * 0.5f, cy - height * 0.5f);
+    out.Vertex2f(cx + width * 0.5f, cy - height * 0.5f);
+    out.Vertex2f(cx + width * 0.5f, cy + height * 0.5f);
+    out.Vertex2f(cx - width * 0.5f, cy + height * 0.5f);
+    out.End();
 
     // "OPEN" text with neon glow effect
     float letterWidth = width * 0.12f;
@@ -339,65 +482,65 @@ void drawOpenSign(float cx, float cy, float width, float height) {
     float spacing = width * 0.18f;
 
     // Draw glow first (thicker, semi-transparent)
-    glColor4f(0.6f, 1.0f, 0.7f, 0.6f); // Light green glow
-    glLineWidth(5.0f);
-    drawOpenText(cx, cy, letterWidth, letterHeight, spacing);
+    out.Color4f(0.6f, 1.0f, 0.7f, 0.6f); // Light green glow
+    out.LineWidth(5.0f);
+    drawOpenText(out, cx, cy, letterWidth, letterHeight, spacing);
 
     // Draw main text (thinner, solid color)
-    glColor3f(1.0f, 1.0f, 1.0f); // Bright white text
-    glLineWidth(2.0f);
-    drawOpenText(cx, cy, letterWidth, letterHeight, spacing);
+    out.Color3f(1.0f, 1.0f, 1.0f); // Bright white text
+    out.LineWidth(2.0f);
+    drawOpenText(out, cx, cy, letterWidth, letterHeight, spacing);
 
-    glLineWidth(1.0f); // Reset line width
+    out.LineWidth(1.0f); // Reset line width
 }
 
 // Helper function to draw the OPEN letters
-void drawOpenText(float cx, float cy, float letterWidth, float letterHeight, float spacing) {
+void drawOpenText(GeometryBuffer& out, float cx, float cy, float letterWidth, float letterHeight, float spacing) {
     // O
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(cx - spacing * 1.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx - spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx - spacing * 1.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx - spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glEnd();
+    out.Begin(GL_LINE_LOOP);
+    out.Vertex2f(cx - spacing * 1.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx - spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx - spacing * 1.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx - spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.End();
 
     // P
-    glBegin(GL_LINES);
-    glVertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glEnd();
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy);
-    glVertex2f(cx - spacing * 0.5f + letterWidth * 0.5f, cy);
-    glVertex2f(cx - spacing * 0.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glEnd();
+    out.Begin(GL_LINES);
+    out.Vertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.End();
+    out.Begin(GL_LINE_LOOP);
+    out.Vertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy);
+    out.Vertex2f(cx - spacing * 0.5f + letterWidth * 0.5f, cy);
+    out.Vertex2f(cx - spacing * 0.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx - spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.End();
 
     // E
-    glBegin(GL_LINES);
-    glVertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 0.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy);
-    glVertex2f(cx + spacing * 0.5f + letterWidth * 0.3f, cy);
-    glVertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 0.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glEnd();
+    out.Begin(GL_LINES);
+    out.Vertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 0.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy);
+    out.Vertex2f(cx + spacing * 0.5f + letterWidth * 0.3f, cy);
+    out.Vertex2f(cx + spacing * 0.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 0.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.End();
 
     // N
-    glBegin(GL_LINES);
-    glVertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
-    glVertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
-    glEnd();
+    out.Begin(GL_LINES);
+    out.Vertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 1.5f - letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy - letterHeight * 0.5f);
+    out.Vertex2f(cx + spacing * 1.5f + letterWidth * 0.5f, cy + letterHeight * 0.5f);
+    out.End();
 }
 
 // Utility to draw a chimney-like extractor on the roof
-void drawExtractor(float cx, float cy, float width, float height, float slope) {
+void drawExtractor(GeometryBuffer& out, float cx, float cy, float width, float height, float slope) {
     // Calculate the y-offsets for the angled base
     float y_offset_left = -width / 2 * slope;
     float y_offset_right = width / 2 * slope;
@@ -405,638 +548,582 @@ void drawExtractor(float cx, float cy, float width, float height, float slope) {
     // Flashing at the base for integration (angled with the roof)
     float flashingWidth = width * 0.7f;
     float flashingHeight = 0.02f;
-    glColor3f(0.35f, 0.12f, 0.12f); // Roof eave/shadow color for better blending
-    glBegin(GL_QUADS);
-    glVertex2f(cx - flashingWidth, cy - flashingWidth * slope);
-    glVertex2f(cx + flashingWidth, cy + flashingWidth * slope);
-    glVertex2f(cx + flashingWidth, cy + flashingWidth * slope - flashingHeight);
-    glVertex2f(cx - flashingWidth, cy - flashingWidth * slope - flashingHeight);
-    glEnd();
+    out.Color3f(0.35f, 0.12f, 0.12f); // Roof eave/shadow color for better blending
+    out.Begin(GL_QUADS);
+    out.Vertex2f(cx - flashingWidth, cy - flashingWidth * slope);
+    out.Vertex2f(cx + flashingWidth, cy + flashingWidth * slope);
+    out.Vertex2f(cx + flashingWidth, cy + flashingWidth * slope - flashingHeight);
+    out.Vertex2f(cx - flashingWidth, cy - flashingWidth * slope - flashingHeight);
+    out.End();
 
     // Main body with metallic gradient and angled base
-    glBegin(GL_QUADS);
-    glColor3f(0.65f, 0.65f, 0.7f); // Lighter top
-    glVertex2f(cx - width / 2, cy + y_offset_left + height);
-    glVertex2f(cx + width / 2, cy + y_offset_right + height);
-    glColor3f(0.45f, 0.45f, 0.5f); // Darker bottom
-    glVertex2f(cx + width / 2, cy + y_offset_right);
-    glVertex2f(cx - width / 2, cy + y_offset_left);
-    glEnd();
+    out.Begin(GL_QUADS);
+    out.Color3f(0.65f, 0.65f, 0.7f); // Lighter top
+    out.Vertex2f(cx - width / 2, cy + y_offset_left + height);
+    out.Vertex2f(cx + width / 2, cy + y_offset_right + height);
+    out.Color3f(0.45f, 0.45f, 0.5f); // Darker bottom
+    out.Vertex2f(cx + width / 2, cy + y_offset_right);
+    out.Vertex2f(cx - width / 2, cy + y_offset_left);
+    out.End();
 
     // Cap on top (adjusted to be horizontal)
     float cap_y = cy + height + (y_offset_left + y_offset_right) / 2.0f;
-    drawRectangle(cx - width * 0.6f, cap_y, cx + width * 0.6f, cap_y + 0.02f, 0.3f, 0.3f, 0.3f);
+    drawRectangle(out, cx - width * 0.6f, cap_y, cx + width * 0.6f, cap_y + 0.02f, 0.3f, 0.3f, 0.3f);
 }
 
 
 
-class Toilet {
+// ------------------ Roof tiles ------------------
+// A tiled roof is described by its eave edge (at baseY) and ridge edge (at
+// peakY); the sloping sides are interpolated between them. The tiling is a
+// set of horizontal course lines plus staggered vertical separators, each
+// drawn as a shadow line with a lighter line on top.
+struct RoofTiling {
+    float baseY, peakY;
+    float eaveLeftX, eaveRightX;
+    float ridgeLeftX, ridgeRightX;
+    float rowSpacing;           // distance between tile courses
+    float tileWidth;            // distance between separators in a course
+    float inset;                // lines stay this far inside the roof edges
+    float rowStop;              // courses stop this far below the peak
+    float separatorStop;        // separators stop this far below the peak
+    float rowShadowDrop;        // course shadow sits this far below its line
+    float separatorShadowShift; // separator shadow sits this far to the right
+};
+
+const LineStyle kTileShadow = { 0.65f, 0.35f, 0.35f, 1.0f };
+const LineStyle kTileLine = { 0.75f, 0.45f, 0.45f, 1.0f };
+
+void generateRoofTiles(const RoofTiling& roof, LineBatch& courses, LineBatch& separators) {
+    auto edgesAt = [&](float y, float& left, float& right) {
+        float yProgress = (y - roof.baseY) / (roof.peakY - roof.baseY);
+        left = roof.eaveLeftX + (roof.ridgeLeftX - roof.eaveLeftX) * yProgress + roof.inset;
+        right = roof.eaveRightX + (roof.ridgeRightX - roof.eaveRightX) * yProgress - roof.inset;
+    };
+
+    // Tile courses
+    for (float y = roof.baseY + roof.rowSpacing; y < roof.peakY - roof.rowStop; y += roof.rowSpacing) {
+        float left, right;
+        edgesAt(y, left, right);
+        courses.Add(kTileShadow, left, y - roof.rowShadowDrop, right, y - roof.rowShadowDrop);
+        courses.Add(kTileLine, left, y, right, y);
+    }
+
+    // Separators, staggered by half a tile on every other course
+    float halfHeight = roof.rowSpacing * 0.3f;
+    int row = 0;
+    for (float y = roof.baseY + roof.rowSpacing * 0.5f; y < roof.peakY - roof.separatorStop; y += roof.rowSpacing, row++) {
+        float left, right;
+        edgesAt(y, left, right);
+
+        float offset = (row % 2 == 0) ? 0.0f : roof.tileWidth * 0.5f;
+        for (float x = left - roof.inset + offset; x < right; x += roof.tileWidth) {
+            if (x > left) {
+                float shadowX = x + roof.separatorShadowShift;
+                separators.Add(kTileShadow, shadowX, y - halfHeight, shadowX, y + halfHeight);
+                separators.Add(kTileLine, x, y - halfHeight, x, y + halfHeight);
+            }
+        }
+    }
+}
+
+// Course spacing on screen (pixels) above which the courses, then the
+// separators, are drawn. Below the first the roof fill alone stands in for
+// the tiles.
+const float kRoofTileLevelPixels[] = { 2.5f, 4.5f };
+
+// A tiled roof that drops detail as it shrinks on screen
+class RoofTiles {
 public:
-    void Draw(float x, float y, float orientation = 0.0f) {
-        // orientation: 0 = tank on right, 1 = tank on left, 2 = tank on top, 3 = tank on bottom
+    // Generates the tile lines on first use; CPU only
+    void Prepare(const RoofTiling& roof) {
+        if (!courses.Empty() || !separators.Empty())
+            return;
+        // Anchored at the left eave, so the tile lines are stored small
+        courses.SetAnchor(roof.eaveLeftX, roof.baseY);
+        separators.SetAnchor(roof.eaveLeftX, roof.baseY);
+        generateRoofTiles(roof, courses, separators);
+    }
 
-        glBegin(GL_LINES);
-        glColor3f(1.0f, 1.0f, 1.0f); // White
+    // 'unitPixels' is the on-screen size of one unit of the roof's drawing space
+    void Draw(const RoofTiling& roof, float unitPixels) {
+        Prepare(roof);
 
-        float bowlRadius = 0.2f;
-        float innerRadius = 0.12f;
-        float tankSize = 0.15f; // Square tank
+        int level = lod.Select(roof.rowSpacing * unitPixels, kRoofTileLevelPixels, 2);
+        if (level >= 1)
+            courses.Draw();
+        if (level >= 2)
+            separators.Draw();
+    }
 
-        if (orientation == 0) { // Tank on right (default)
-            // Outer circle (bowl)
-            DrawCircle(x, y, bowlRadius, 16);
+private:
+    LineBatch courses;      // built by Prepare()
+    LineBatch separators;
+    LodSelector lod;
+};
 
-            // Inner circle
-            DrawCircle(x, y, innerRadius, 12);
+// Gable roof shared by the front and rear elevations (unit-scaled drawing space)
+const RoofTiling kGableRoofTiling = {
+    0.3f, 1.0f,         // eave and peak heights
+    -1.3f, 1.3f,        // eaves
+    0.0f, 0.0f,         // ridge
+    0.04f, 0.08f,       // course spacing, tile width
+    0.02f, 0.03f, 0.08f, // inset, course and separator stops
+    0.005f, 0.002f      // shadow offsets
+};
 
-            // Tank (square on right)
-            float tankX = x + bowlRadius + tankSize / 2;
-            glVertex2f(tankX - tankSize / 2, y - tankSize / 2); glVertex2f(tankX + tankSize / 2, y - tankSize / 2);
-            glVertex2f(tankX + tankSize / 2, y - tankSize / 2); glVertex2f(tankX + tankSize / 2, y + tankSize / 2);
-            glVertex2f(tankX + tankSize / 2, y + tankSize / 2); glVertex2f(tankX - tankSize / 2, y + tankSize / 2);
-            glVertex2f(tankX - tankSize / 2, y + tankSize / 2); glVertex2f(tankX - tankSize / 2, y - tankSize / 2);
+// The tiling moved onto the sheet by an axis-aligned placement (scale and
+// offset only), so the tile lines are generated where they are drawn
+RoofTiling placeRoofTiling(const RoofTiling& roof, const Affine2D& placement) {
+    float sx = placement.a, sy = placement.d;
+    RoofTiling placed = roof;
+    placed.baseY = roof.baseY * sy + placement.ty;
+    placed.peakY = roof.peakY * sy + placement.ty;
+    placed.eaveLeftX = roof.eaveLeftX * sx + placement.tx;
+    placed.eaveRightX = roof.eaveRightX * sx + placement.tx;
+    placed.ridgeLeftX = roof.ridgeLeftX * sx + placement.tx;
+    placed.ridgeRightX = roof.ridgeRightX * sx + placement.tx;
+    placed.rowSpacing = roof.rowSpacing * sy;
+    placed.tileWidth = roof.tileWidth * sx;
+    placed.inset = roof.inset * sx;
+    placed.rowStop = roof.rowStop * sy;
+    placed.separatorStop = roof.separatorStop * sy;
+    placed.rowShadowDrop = roof.rowShadowDrop * sy;
+    placed.separatorShadowShift = roof.separatorShadowShift * sx;
+    return placed;
+}
 
-        }
-        else if (orientation == 1) { // Tank on left
-            // Outer circle (bowl)
-            DrawCircle(x, y, bowlRadius, 16);
+// Grid the floor plan's wall ends are snapped to on load: a millimetre
+const float kWallSnap = 0.001f;
 
-            // Inner circle
-            DrawCircle(x, y, innerRadius, 12);
+// Stroked wall levels by on-screen wall width in pixels. Below the first
+// threshold the walls are drawn as hairlines; each stroked level rounds
+// its joins and caps finely enough for walls up to the next threshold
+// (and the last for walls up to twice its own).
+const int kWallStrokeLevels = 3;
+const float kWallStrokeLevelPixels[kWallStrokeLevels] = { 1.0f, 4.0f, 16.0f };
 
-            // Tank (square on left)
-            float tankX = x - bowlRadius - tankSize / 2;
-            glVertex2f(tankX - tankSize / 2, y - tankSize / 2); glVertex2f(tankX + tankSize / 2, y - tankSize / 2);
-            glVertex2f(tankX + tankSize / 2, y - tankSize / 2); glVertex2f(tankX + tankSize / 2, y + tankSize / 2);
-            glVertex2f(tankX + tankSize / 2, y + tankSize / 2); glVertex2f(tankX - tankSize / 2, y + tankSize / 2);
-            glVertex2f(tankX - tankSize / 2, y + tankSize / 2); glVertex2f(tankX - tankSize / 2, y - tankSize / 2);
+class FloorPlan {
+public:
+    // 'wallWidth' is the walls' stroke width in plan units; 0 draws them as hairlines
+    FloorPlan(const std::string& path, float wallWidth) : scenePath(path), wallWidth(wallWidth) {
+        wallStyle.width = wallWidth;
+        wallStyle.join = StrokeJoin::Miter;
+        wallStyle.cap = StrokeCap::Round;
+    }
+
+    // Loads the scene and stamps the fixtures at every detail level if the
+    // cache is stale. CPU only, so it can run on a pool thread.
+    void Prepare() {
+        if (!dirty)
+            return;
+        Build();
+        dirty = false;
+    }
 
+    // Replays the cached plan; the geometry is only rebuilt after Invalidate().
+    // The walls are laid out in spatial index order, so the segments inside
+    // the camera window come back from the index as a few vertex runs and
+    // only those are drawn. Walls at least a pixel wide on screen are drawn
+    // from the stroke level that suits their width, thinner ones as lines.
+    // Each fixture group keeps its own buffer and is skipped whole when
+    // outside the window; the groups come from coarser or finer templates as
+    // the plan's on-screen scale changes.
+    void Draw() {
+        Prepare();
+
+        int level = fixtureLod.Select(lodPixelsPerUnit(), kFixtureLevelPixels, kFixtureDetailLevels - 1);
+
+        int stroke = 0;
+        if (wallWidth > 0.0f)
+            stroke = wallLod.Select(wallWidth * lodPixelsPerUnit(), kWallStrokeLevelPixels, kWallStrokeLevels);
+        GeometryBuffer& wallBuffer = stroke > 0 ? wallStrokes[stroke - 1] : walls;
+
+        if (!cullingEnabled || boundsCapture.active) {
+            wallBuffer.Draw();
+        } else if (isVisible(wallBuffer.WorldBounds())) {
+            // The index holds centre lines; a stroke reaches up to a miter
+            // past them
+            Bounds window = toPlan(cameraBounds());
+            if (stroke > 0) {
+                float reach = 0.5f * wallWidth * wallStyle.miterLimit;
+                window.minX -= reach;
+                window.minY -= reach;
+                window.maxX += reach;
+                window.maxY += reach;
+            }
+            visibleRuns.clear();
+            wallIndex.QueryRanges(window, visibleRuns);
+            for (IndexRange& run : visibleRuns) {
+                if (stroke == 0) {
+                    run.first *= 2; // two vertices per segment
+                    run.count *= 2;
+                    continue;
+                }
+                const std::vector<size_t>& starts = strokeRuns[stroke - 1];
+                size_t first = starts[run.first];
+                run.count = starts[run.first + run.count] - first;
+                run.first = first;
+            }
+            wallBuffer.DrawRanges(visibleRuns);
+        }
+        for (GeometryBuffer& group : fixtureGroups[level]) {
+            if (isVisible(group.WorldBounds()))
+                group.Draw();
         }
-        else if (orientation == 2) { // Tank on top
-            // Outer circle (bowl)
-            DrawCircle(x, y, bowlRadius, 16);
+    }
 
-            // Inner circle
-            DrawCircle(x, y, innerRadius, 12);
+    // Marks the plan geometry as changed so the next Draw() rebuilds the cache
+    void Invalidate() { dirty = true; }
+
+    // False when the last Prepare() could not load the scene (the plan is then empty)
+    bool Loaded() const { return loaded; }
+
+    // What the last Prepare()'s line cleanup did to the walls
+    const LineCleanupStats& CleanupStats() const { return cleanupStats; }
+
+    // ---- Queries ----
+    // Wall segments (door leaves and swing arcs included) and fixture
+    // instances each live in a SpatialIndex over plan coordinates. The
+    // queries take world positions; call Prepare() first.
+
+    struct Hit {
+        bool fixture;       // false for a wall segment
+        FixtureType type;   // fixtures only
+        unsigned index;     // wall segment in index order, or instance of 'type'
+        float distance;
+    };
+
+    // Everything within 'radius' of world point (x, y), for hit testing
+    void HitTest(double x, double y, float radius, std::vector<Hit>& out) const {
+        float px = (float)(x - walls.Anchor().x), py = (float)(y - walls.Anchor().y);
+        queryHits.clear();
+        wallIndex.QueryPoint(px, py, radius, queryHits);
+        for (const SpatialHit& hit : queryHits)
+            out.push_back({ false, FixtureType::Count, (unsigned)hit.order, hit.distance });
+        queryHits.clear();
+        fixtureIndex.QueryPoint(px, py, radius, queryHits);
+        for (const SpatialHit& hit : queryHits)
+            out.push_back(FixtureHit(hit));
+    }
 
-            // Tank (square on top)
-            float tankY = y + bowlRadius + tankSize / 2;
-            glVertex2f(x - tankSize / 2, tankY - tankSize / 2); glVertex2f(x + tankSize / 2, tankY - tankSize / 2);
-            glVertex2f(x + tankSize / 2, tankY - tankSize / 2); glVertex2f(x + tankSize / 2, tankY + tankSize / 2);
-            glVertex2f(x + tankSize / 2, tankY + tankSize / 2); glVertex2f(x - tankSize / 2, tankY + tankSize / 2);
-            glVertex2f(x - tankSize / 2, tankY + tankSize / 2); glVertex2f(x - tankSize / 2, tankY - tankSize / 2);
+    // The primitive closest to world point (x, y) within 'maxDistance', for
+    // snapping. Returns false when there is none.
+    bool Nearest(double x, double y, float maxDistance, Hit& hit) const {
+        float px = (float)(x - walls.Anchor().x), py = (float)(y - walls.Anchor().y);
+        SpatialHit wall, fixture;
+        bool foundWall = wallIndex.Nearest(px, py, maxDistance, wall);
+        bool foundFixture = fixtureIndex.Nearest(px, py, foundWall ? wall.distance : maxDistance, fixture);
+        if (foundFixture)
+            hit = FixtureHit(fixture);
+        else if (foundWall)
+            hit = { false, FixtureType::Count, (unsigned)wall.order, wall.distance };
+        return foundWall || foundFixture;
+    }
 
+    const SpatialIndex& WallIndex() const { return wallIndex; }
+    const SpatialIndex& FixtureIndex() const { return fixtureIndex; }
+
+    // ---- Picking ----
+
+    // The wall, door or fixture nearest world point (x, y) within 'radius'
+    PlanPick Pick(double x, double y, float radius) const {
+        PlanPick pick;
+        Hit hit;
+        if (!Nearest(x, y, radius, hit))
+            return pick;
+        if (hit.fixture) {
+            pick.kind = PickKind::Fixture;
+            pick.fixture = hit.type;
+            pick.index = hit.index;
+        } else {
+            unsigned record = RecordOf(wallLines.sources[wallIndex.Items()[hit.index].id]);
+            pick.kind = (records[record].shape == SceneShape::Door) ? PickKind::Door : PickKind::Wall;
+            pick.index = record;
         }
-        else if (orientation == 3) { // Tank on bottom
-            // Outer circle (bowl)
-            DrawCircle(x, y, bowlRadius, 16);
-
-            // Inner circle
-            DrawCircle(x, y, innerRadius, 12);
-
-            // Tank (square on bottom)
-            float tankY = y - bowlRadius - tankSize / 2;
-            glVertex2f(x - tankSize / 2, tankY - tankSize / 2); glVertex2f(x + tankSize / 2, tankY - tankSize / 2);
-            glVertex2f(x + tankSize / 2, tankY - tankSize / 2); glVertex2f(x + tankSize / 2, tankY + tankSize / 2);
-            glVertex2f(x + tankSize / 2, tankY + tankSize / 2); glVertex2f(x - tankSize / 2, tankY + tankSize / 2);
-            glVertex2f(x - tankSize / 2, tankY + tankSize / 2); glVertex2f(x - tankSize / 2, tankY - tankSize / 2);
+        return pick;
+    }
+
+    // What 'pick' is and where, in world coordinates, e.g.
+    // "DOOR  LINE 20  HINGE 4.00 1.50"
+    void Describe(const PlanPick& pick, char* text, size_t size) const {
+        static const char* kFixtureNames[(int)FixtureType::Count] = {
+            "TOILET", "EXTINGUISHER", "BIN", "TABLE", "CHAIR"
+        };
+        const WorldPoint& origin = walls.Anchor();
+        if (pick.kind == PickKind::Fixture) {
+            const FixtureInstance& instance = fixtures.Instances(pick.fixture)[pick.index];
+            std::snprintf(text, size, "%s %u  %.2f %.2f", kFixtureNames[(int)pick.fixture], pick.index + 1,
+                instance.x + origin.x, instance.y + origin.y);
+        } else if (pick.kind == PickKind::Door) {
+            const LineSegment& leaf = Segment(records[pick.index].firstSegment);
+            std::snprintf(text, size, "DOOR  LINE %d  HINGE %.2f %.2f", records[pick.index].line,
+                leaf.a.x + origin.x, leaf.a.y + origin.y);
+        } else if (pick.kind == PickKind::Wall) {
+            const LineSegment& wall = Segment(records[pick.index].firstSegment);
+            std::snprintf(text, size, "WALL  LINE %d  %.2f %.2f / %.2f %.2f", records[pick.index].line,
+                wall.a.x + origin.x, wall.a.y + origin.y, wall.b.x + origin.x, wall.b.y + origin.y);
+        } else if (size > 0) {
+            text[0] = '\0';
         }
+    }
 
+    // Outlines 'pick' under the current sheet camera: a record's segments
+    // (as written in the scene, before cleanup) redrawn thick, or a fixture's box. Raw GL, like the stats overlay, so
+    // the highlight does not count towards the view's numbers.
+    void DrawHighlight(const PlanPick& pick) const {
+        if (pick.kind == PickKind::None)
+            return;
+        const WorldPoint& origin = walls.Anchor();
+        float ox = toRenderX(origin.x), oy = toRenderY(origin.y);
+
+        glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LINE_BIT);
+        glLineWidth(3.0f);
+        glColor3f(1.0f, 0.55f, 0.0f);
+        glBegin(GL_LINES);
+        if (pick.kind == PickKind::Fixture) {
+            Bounds box = fixtureBox(pick.fixture, fixtures.Instances(pick.fixture)[pick.index]);
+            const float x[4] = { box.minX, box.maxX, box.maxX, box.minX };
+            const float y[4] = { box.minY, box.minY, box.maxY, box.maxY };
+            for (int i = 0; i < 4; ++i) {
+                glVertex2f(x[i] + ox, y[i] + oy);
+                glVertex2f(x[(i + 1) % 4] + ox, y[(i + 1) % 4] + oy);
+            }
+        } else {
+            unsigned last = (pick.index + 1 < records.size()) ? records[pick.index + 1].firstSegment
+                : (unsigned)sceneSegments.size();
+            for (unsigned i = records[pick.index].firstSegment; i < last; ++i) {
+                const LineSegment& segment = Segment(i);
+                glVertex2f(segment.a.x + ox, segment.a.y + oy);
+                glVertex2f(segment.b.x + ox, segment.b.y + oy);
+            }
+        }
         glEnd();
+        glPopAttrib();
     }
 
 private:
-    void DrawCircle(float cx, float cy, float radius, int segments) {
-        for (int i = 0; i < segments; i++) {
-            float theta1 = 2.0f * M_PI * i / segments;
-            float theta2 = 2.0f * M_PI * (i + 1) / segments;
-            glVertex2f(cx + radius * cos(theta1), cy + radius * sin(theta1));
-            glVertex2f(cx + radius * cos(theta2), cy + radius * sin(theta2));
+    // Loads the plan's walls, doors and fixture placements from the scene
+    // file, indexes them, then stamps a copy of the matching template at
+    // every placement. The fixtures share the plan's site origin.
+    void Build() {
+        GeometryBuffer scene;
+        fixtures.Clear();
+        loaded = loadScene(scenePath.c_str(), scene, fixtures, &records);
+
+        BuildWalls(scene);
+        BuildFixtureIndex();
+
+        const WorldPoint& origin = walls.Anchor();
+        for (int level = 0; level < kFixtureDetailLevels; ++level) {
+            for (int type = 0; type < (int)FixtureType::Count; ++type) {
+                GeometryBuffer& group = fixtureGroups[level][type];
+                group.Clear();
+                fixtures.Expand((FixtureType)type, group, level);
+                group.SetAnchor(origin.x, origin.y);
+            }
         }
     }
-};
 
-class FireExtinguisher {
-public:
-    void Draw(float x, float y) {
-        glBegin(GL_LINES);
-        glColor3f(1.0f, 0.0f, 0.0f); // Red color for fire safety
-
-        // Main body (circle from top-down view)
-        float radius = 0.15f;
-        int segments = 12;
-
-        // Draw circle for extinguisher body
-        for (int i = 0; i < segments; i++) {
-            float theta1 = 2.0f * M_PI * i / segments;
-            float theta2 = 2.0f * M_PI * (i + 1) / segments;
-            glVertex2f(x + radius * cos(theta1), y + radius * sin(theta1));
-            glVertex2f(x + radius * cos(theta2), y + radius * sin(theta2));
+    // Cleans up the segments of the loaded lines and doors (window marks
+    // lying on walls, zero-length lines and the like; see LineCleanup.h),
+    // indexes what is left, then records it into 'walls' in index order so
+    // that index runs are vertex runs. The backends draw vertex arrays, so
+    // the indexed list is expanded again here; the vertex count still drops
+    // by the segments merged away.
+    void BuildWalls(const GeometryBuffer& scene) {
+        const VertexStream& v = scene.Vertices();
+        sceneSegments.clear();
+        sceneSegments.reserve(v.Size() / 2);
+        for (const DrawBatch& batch : scene.Batches()) {
+            if (batch.mode != GL_LINES)
+                continue;
+            for (GLint i = batch.first; i + 1 < batch.first + batch.count; i += 2)
+                sceneSegments.push_back({ v.At(i), v.At(i + 1) });
         }
+        cleanupStats = cleanupLines(sceneSegments, kWallSnap, wallLines);
+
+        const std::vector<PackedVertex>& welded = wallLines.vertices;
+        const std::vector<unsigned>& ends = wallLines.indices;
+        std::vector<SpatialItem> segments;
+        segments.reserve(wallLines.SegmentCount());
+        for (unsigned i = 0; i < (unsigned)wallLines.SegmentCount(); ++i) {
+            const PackedVertex& a = welded[ends[2 * i]];
+            const PackedVertex& b = welded[ends[2 * i + 1]];
+            segments.push_back({ a.x, a.y, b.x, b.y, SpatialShape::Segment, i });
+        }
+        wallIndex.Build(std::move(segments));
+
+        // Every item its own run at worst, so culling never grows it while drawing
+        visibleRuns.clear();
+        visibleRuns.reserve(wallIndex.Size());
+
+        walls.Clear();
+        walls.SetAnchor(scene.Anchor().x, scene.Anchor().y);
+        walls.Begin(GL_LINES);
+        for (const SpatialItem& segment : wallIndex.Items()) {
+            for (unsigned end = 2 * segment.id; end < 2 * segment.id + 2; ++end) {
+                const PackedVertex& p = welded[ends[end]];
+                walls.Color4f(p.r / 255.0f, p.g / 255.0f, p.b / 255.0f, p.a / 255.0f);
+                walls.Vertex2f(p.x, p.y);
+            }
+        }
+        walls.End();
 
-        // Add "FE" text indicator (using lines)
-        // F shape
-        glVertex2f(x - radius * 0.3f, y + radius * 0.5f); glVertex2f(x - radius * 0.3f, y - radius * 0.5f);
-        glVertex2f(x - radius * 0.3f, y + radius * 0.5f); glVertex2f(x - radius * 0.1f, y + radius * 0.5f);
-        glVertex2f(x - radius * 0.3f, y); glVertex2f(x - radius * 0.1f, y);
-
-        // E shape  
-        glVertex2f(x + radius * 0.1f, y + radius * 0.5f); glVertex2f(x + radius * 0.1f, y - radius * 0.5f);
-        glVertex2f(x + radius * 0.1f, y + radius * 0.5f); glVertex2f(x + radius * 0.3f, y + radius * 0.5f);
-        glVertex2f(x + radius * 0.1f, y); glVertex2f(x + radius * 0.3f, y);
-        glVertex2f(x + radius * 0.1f, y - radius * 0.5f); glVertex2f(x + radius * 0.3f, y - radius * 0.5f);
+        StrokeWalls(scene.Anchor());
+    }
 
-        glEnd();
+    // Strokes the cleaned walls once per stroke level, in index order like
+    // 'walls': mitred corners, round ends and round T-junctions
+    void StrokeWalls(const WorldPoint& anchor) {
+        std::vector<unsigned> order;
+        order.reserve(wallIndex.Size());
+        for (const SpatialItem& segment : wallIndex.Items())
+            order.push_back(segment.id);
+
+        StrokeStyle style = wallStyle;
+        for (int level = 0; level < kWallStrokeLevels; ++level) {
+            GeometryBuffer& strokes = wallStrokes[level];
+            strokes.Clear();
+            strokeRuns[level].clear();
+            if (wallWidth <= 0.0f)
+                continue;
+            float widest = level + 1 < kWallStrokeLevels ? kWallStrokeLevelPixels[level + 1]
+                : 2.0f * kWallStrokeLevelPixels[level];
+            style.roundSegments = circleSegments(0.5f * widest, 8, 64);
+            strokes.SetAnchor(anchor.x, anchor.y);
+            strokeLines(wallLines, style, order, strokes, strokeRuns[level]);
+        }
     }
-};
 
-void DrawDoorArc(float cx, float cy, float radius, float startAngle, float endAngle, int segments = 20) {
-    for (int i = 0; i < segments; i++) {
-        float theta1 = startAngle + (endAngle - startAngle) * (i / (float)segments);
-        float theta2 = startAngle + (endAngle - startAngle) * ((i + 1) / (float)segments);
-        glVertex2f(cx + radius * cos(theta1), cy + radius * sin(theta1));
-        glVertex2f(cx + radius * cos(theta2), cy + radius * sin(theta2));
+    // One box per fixture instance: its full-detail template's box, placed.
+    // Ids count the instances type by type, in FixtureType order.
+    void BuildFixtureIndex() {
+        std::vector<SpatialItem> boxes;
+        boxes.reserve(fixtures.Count());
+        unsigned id = 0;
+        for (int type = 0; type < (int)FixtureType::Count; ++type) {
+            fixtureIds[type] = id;
+            for (const FixtureInstance& instance : fixtures.Instances((FixtureType)type)) {
+                Bounds box = fixtureBox((FixtureType)type, instance);
+                boxes.push_back({ box.minX, box.minY, box.maxX, box.maxY, SpatialShape::Box, id++ });
+            }
+        }
+        fixtureIndex.Build(std::move(boxes));
     }
-}
 
-class Bin {
-public:
-    void Draw(float x, float y, float size = 0.25f) {
-        glBegin(GL_LINES);
-        glColor3f(0.6f, 0.6f, 0.6f); // Gray color for bins
+    // Plan-space box of an instance: its full-detail template's box, placed
+    static Bounds fixtureBox(FixtureType type, const FixtureInstance& instance) {
+        const Bounds& local = fixtureTemplate(type).LocalBounds();
+        Affine2D m = instancePlacement(instance);
+        Bounds box;
+        const float corners[4][2] = { { local.minX, local.minY }, { local.maxX, local.minY },
+            { local.maxX, local.maxY }, { local.minX, local.maxY } };
+        for (const float* p : corners)
+            box.Add(m.a * p[0] + m.c * p[1] + m.tx, m.b * p[0] + m.d * p[1] + m.ty);
+        return box;
+    }
 
-        float outerSize = size;
-        float innerSize = size * 0.6f; // Smaller inner square
+    // Scene segment 'i' (in file order), as loaded
+    const LineSegment& Segment(unsigned i) const { return sceneSegments[i]; }
 
-        // Outer square
-        glVertex2f(x - outerSize / 2, y - outerSize / 2); glVertex2f(x + outerSize / 2, y - outerSize / 2);
-        glVertex2f(x + outerSize / 2, y - outerSize / 2); glVertex2f(x + outerSize / 2, y + outerSize / 2);
-        glVertex2f(x + outerSize / 2, y + outerSize / 2); glVertex2f(x - outerSize / 2, y + outerSize / 2);
-        glVertex2f(x - outerSize / 2, y + outerSize / 2); glVertex2f(x - outerSize / 2, y - outerSize / 2);
+    // Record that scene segment 'segment' was read from
+    unsigned RecordOf(unsigned segment) const {
+        auto after = std::upper_bound(records.begin(), records.end(), segment,
+            [](unsigned s, const SceneRecord& record) { return s < record.firstSegment; });
+        return (unsigned)(after - records.begin()) - 1;
+    }
 
-        // Inner square
-        glVertex2f(x - innerSize / 2, y - innerSize / 2); glVertex2f(x + innerSize / 2, y - innerSize / 2);
-        glVertex2f(x + innerSize / 2, y - innerSize / 2); glVertex2f(x + innerSize / 2, y + innerSize / 2);
-        glVertex2f(x + innerSize / 2, y + innerSize / 2); glVertex2f(x - innerSize / 2, y + innerSize / 2);
-        glVertex2f(x - innerSize / 2, y + innerSize / 2); glVertex2f(x - innerSize / 2, y - innerSize / 2);
+    Hit FixtureHit(const SpatialHit& hit) const {
+        int type = (int)FixtureType::Count - 1;
+        while (type > 0 && hit.id < fixtureIds[type])
+            --type;
+        return { true, (FixtureType)type, hit.id - fixtureIds[type], hit.distance };
+    }
 
-        glEnd();
+    // World rectangle to plan coordinates
+    Bounds toPlan(const Bounds& world) const {
+        Bounds plan;
+        plan.Add((float)(world.minX - walls.Anchor().x), (float)(world.minY - walls.Anchor().y));
+        plan.Add((float)(world.maxX - walls.Anchor().x), (float)(world.maxY - walls.Anchor().y));
+        return plan;
     }
+
+    std::string scenePath;
+    FixtureInstances fixtures;
+    GeometryBuffer walls;
+    std::vector<SceneRecord> records;
+    std::vector<LineSegment> sceneSegments;                // lines and doors in file order, as loaded
+    IndexedLines wallLines;                                // after cleanup; ids in wallIndex point here
+    LineCleanupStats cleanupStats;
+    SpatialIndex wallIndex;
+    float wallWidth;
+    StrokeStyle wallStyle;                                 // mitred corners, round ends
+    GeometryBuffer wallStrokes[kWallStrokeLevels];         // walls as triangles, one buffer per level
+    std::vector<size_t> strokeRuns[kWallStrokeLevels];     // first vertex of each index position, then the end
+    LodSelector wallLod;
+    SpatialIndex fixtureIndex;
+    unsigned fixtureIds[(int)FixtureType::Count] = {};    // first id of each type
+    std::vector<IndexRange> visibleRuns;                   // reused every frame
+    mutable std::vector<SpatialHit> queryHits;
+    GeometryBuffer fixtureGroups[kFixtureDetailLevels][(int)FixtureType::Count];
+    LodSelector fixtureLod;
+    bool dirty = true;
+    bool loaded = false;
 };
 
-class FloorPlan {
+class RearElevation {
 public:
+    // Tessellates the elevation and generates the roof tiles on first use;
+    // CPU only, so it can run on a pool thread
+    void Prepare() {
+        if (!body.Empty())
+            return;
+
+        Affine2D placement = sheetPlacement();
+        buildBody(body);
+        body.Transform(placement);
+        buildRidge(ridge);
+        ridge.Transform(placement);
+        roofTiles.Prepare(placeRoofTiling(kGableRoofTiling, placement));
+    }
+
     void Draw() {
-        glBegin(GL_LINES);
-        glColor3f(1.0f, 1.0f, 1.0f); // White floor plan
-
-        // Outer square
-		glVertex2f(-6, -10); glVertex2f(6, -10);// bottom
-        glVertex2f(-6, -10); glVertex2f(-6, 10);//left
-        glVertex2f(-6, 10); glVertex2f(6, 10);//top
-        glVertex2f(6, -10); glVertex2f(6,10);//right     
-
-        //Counter space Kitchen
-		glVertex2f(5.4f,9.4f); glVertex2f(1.5f, 9.4f);
-        glVertex2f(5.4f, 10.0f); glVertex2f(5.4f, 2.0f); 
-        glVertex2f(5.4f, 2.0f); glVertex2f(6.0f, 2.0f);
-        //sinks
-		glVertex2f(2.5f, 10.0f); glVertex2f(2.5f, 9.4f);
-        glVertex2f(1.5f, 9.8f); glVertex2f(2.0f, 9.8f);
-        glVertex2f(1.5f, 9.7f); glVertex2f(2.0f, 9.7f);
-        glVertex2f(1.5f, 9.6f); glVertex2f(2.0f, 9.6f);
-        glVertex2f(1.5f, 9.5f); glVertex2f(2.0f, 9.5f);
-
-        glVertex2f(3.5f, 10.0f); glVertex2f(3.5f, 9.4f);
-        glVertex2f(2.5f, 9.8f); glVertex2f(3.0f, 9.8f);
-        glVertex2f(2.5f, 9.7f); glVertex2f(3.0f, 9.7f);
-        glVertex2f(2.5f, 9.6f); glVertex2f(3.0f, 9.6f);
-        glVertex2f(2.5f, 9.5f); glVertex2f(3.0f, 9.5f);
-
-        glVertex2f(4.5f, 10.0f); glVertex2f(4.5f, 9.4f);
-        glVertex2f(3.5f, 9.8f); glVertex2f(4.0f, 9.8f);
-        glVertex2f(3.5f, 9.7f); glVertex2f(4.0f, 9.7f);
-        glVertex2f(3.5f, 9.6f); glVertex2f(4.0f, 9.6f);
-        glVertex2f(3.5f, 9.5f); glVertex2f(4.0f, 9.5f);
-
-        //stoves and grills
-        glVertex2f(5.5f, 2.1); glVertex2f(5.9f, 2.1f);
-        glVertex2f(5.5f, 2.8f); glVertex2f(5.5f, 2.1f);
-        glVertex2f(5.9f, 2.1f); glVertex2f(5.9f, 2.8f);
-        glVertex2f(5.9f, 2.8f); glVertex2f(5.5f, 2.8f);
-
-        glVertex2f(5.5f, 3.1); glVertex2f(5.9f, 3.1f);
-        glVertex2f(5.5f, 3.8f); glVertex2f(5.5f, 3.1f);
-        glVertex2f(5.9f, 3.1f); glVertex2f(5.9f, 3.8f);
-        glVertex2f(5.9f, 3.8f); glVertex2f(5.5f, 3.8f);
-
-        glVertex2f(5.5f, 4.1); glVertex2f(5.9f, 4.1f);
-        glVertex2f(5.5f, 4.8f); glVertex2f(5.5f, 4.1f);
-        glVertex2f(5.9f, 4.1f); glVertex2f(5.9f, 4.8f);
-        glVertex2f(5.9f, 4.8f); glVertex2f(5.5f, 4.8f);
-
-        glVertex2f(5.5f, 5.1); glVertex2f(5.7f, 5.1f);
-        glVertex2f(5.5f, 5.8f); glVertex2f(5.5f, 5.1f);
-        glVertex2f(5.7f, 5.1f); glVertex2f(5.7f, 5.8f);
-        glVertex2f(5.7f, 5.8f); glVertex2f(5.5f, 5.8f);
-
-        glVertex2f(5.5f, 6.1); glVertex2f(5.7f, 6.1f);
-        glVertex2f(5.5f, 6.8f); glVertex2f(5.5f, 6.1f);
-        glVertex2f(5.7f, 6.1f); glVertex2f(5.7f, 6.8f);
-        glVertex2f(5.7f, 6.8f); glVertex2f(5.5f, 6.8f);
-
-        glVertex2f(5.5f, 7.1); glVertex2f(5.7f, 7.1f);
-        glVertex2f(5.5f, 7.8f); glVertex2f(5.5f, 7.1f);
-        glVertex2f(5.7f, 7.1f); glVertex2f(5.7f, 7.8f);
-        glVertex2f(5.7f, 7.8f); glVertex2f(5.5f, 7.8f);
-
-        //Kitchen counter
-		glVertex2f(3.5f, 4.5f); glVertex2f(3.5f, 5.0f);
-		glVertex2f(3.5f, 5.0f); glVertex2f(-0.5f, 5.0f);
-		glVertex2f(-0.5f, 5.0f); glVertex2f(-0.5f, 4.5f);
-		glVertex2f(-0.5f, 4.5f); glVertex2f(3.5f, 4.5f);
-        
-        glVertex2f(3.5f, 3.0f); glVertex2f(3.5f, 3.5f);
-        glVertex2f(3.5f, 3.5f); glVertex2f(-0.5f, 3.5f);
-        glVertex2f(-0.5f, 3.5f); glVertex2f(-0.5f, 3.0f);
-        glVertex2f(-0.5f, 3.0f); glVertex2f(3.5f, 3.0f);
-
-        //Bottom windows
-        glVertex2f(-6, -9.85); glVertex2f(-1.05, -9.85);
-        glVertex2f(-4.7625, -9.85); glVertex2f(-4.7625, -10);
-        glVertex2f(-3.525, -9.85); glVertex2f(-3.525, -10);
-        glVertex2f(-2.2875, -9.85); glVertex2f(-2.2875, -10);
-        glVertex2f(-1.05, -9.85); glVertex2f(-1.05, -10);
-
-        glVertex2f(6, -9.85); glVertex2f(1.05, -9.85);
-        glVertex2f(4.7625, -9.85); glVertex2f(4.7625, -10);
-        glVertex2f(3.525, -9.85); glVertex2f(3.525, -10);
-        glVertex2f(2.2875, -9.85); glVertex2f(2.2875, -10);
-        glVertex2f(1.05, -9.85); glVertex2f(1.05, -10);
-
-        //bottom doors
-        glVertex2f(-1.05f, -10.0f);  glVertex2f(-1.05f, -8.95f);
-        DrawDoorArc(-1.05f, -10.0f, 1.05f, 0.0f, M_PI / 2.0f);
-        glVertex2f(1.05f, -10.0f);  glVertex2f(1.05f, -8.95f);
-        DrawDoorArc(1.05f, -10.0f, -1.05f, 0.0f, M_PI / -2.0f);
-
-        //West windows 1.225
-        glVertex2f(-5.85, -10); glVertex2f(-5.85, -0.2);
-        glVertex2f(-5.85, -0.2); glVertex2f(-6, -0.2);
-        glVertex2f(-5.85, -1.425); glVertex2f(-6, -1.425);
-        glVertex2f(-5.85, -2.65); glVertex2f(-6, -2.65);
-        glVertex2f(-5.85, -3.875); glVertex2f(-6, -3.875);
-        glVertex2f(-5.85, -5.1); glVertex2f(-6, -5.1);
-		glVertex2f(-5.85, -6.325); glVertex2f(-6, -6.325);
-		glVertex2f(-5.85, -7.55); glVertex2f(-6, -7.55);
-		glVertex2f(-5.85, -8.775); glVertex2f(-6, -8.775);
-		glVertex2f(-5.85, -9.85); glVertex2f(-6, -9.85);
-		glVertex2f(-5.85f, -0.2f); glVertex2f(-5.85f, 4.414f);
-		glVertex2f(-5.85f, 4.414f); glVertex2f(-6, 4.414f);
-        glVertex2f(-5.85f, 4.414f); glVertex2f(-6, 3.637f);
-		glVertex2f(-5.85f, 3.637f); glVertex2f(-6, 3.637f);
-		glVertex2f(-5.85f, 2.86f); glVertex2f(-6, 2.86f);
-        glVertex2f(-5.85f, 2.86f); glVertex2f(-6, 2.083f);
-        glVertex2f(-5.85f, 2.083f); glVertex2f(-6, 2.083f);
-		glVertex2f(-5.85f, 1.306f); glVertex2f(-6, 1.306f);
-		glVertex2f(-5.85f, 1.306f); glVertex2f(-6, 0.529f);
-		glVertex2f(-5.85f, 0.529f); glVertex2f(-6, 0.529f);
-        
-
-        //Wall separating dining area and kithcen
-		glVertex2f(-6, -0.2); glVertex2f(6, -0.2);
-
-        //Door to Office
-        glVertex2f(-5.8f, -0.2f);  glVertex2f(-5.8f, 0.8f);
-        DrawDoorArc(-5.8f, -0.2f, 1.0f, 0.0f, M_PI / 2.0f);
-        glVertex2f(-3.8f, 3.5f); glVertex2f(-3.0f, 3.5f); 
-        DrawDoorArc(-3.0f, 3.5f, -0.8f, 0.0f, M_PI / 2.0f);
-
-
-        //Office Walls
-		glVertex2f(-6, 4.414); glVertex2f(-3, 4.414);
-        glVertex2f(-3, -0.2); glVertex2f(-3, 4.414);
-
-        // ===== Desk (shifted left) =====
-// Rectangle desk along the wall (centered near top wall)
-        glVertex2f(-5.6f, 3.7f); glVertex2f(-4.2f, 3.7f);  // top edge
-        glVertex2f(-5.6f, 3.3f); glVertex2f(-4.2f, 3.3f);  // bottom edge
-        glVertex2f(-5.6f, 3.7f); glVertex2f(-5.6f, 3.3f);  // left side
-        glVertex2f(-4.2f, 3.7f); glVertex2f(-4.2f, 3.3f);  // right side
-
-        // ===== Chair Blocks (0.4 x 0.4) =====
-        // Chair below the desk
-        glVertex2f(-5.0f, 2.5f); glVertex2f(-4.6f, 2.5f);
-        glVertex2f(-5.0f, 2.1f); glVertex2f(-4.6f, 2.1f);
-        glVertex2f(-5.0f, 2.5f); glVertex2f(-5.0f, 2.1f);
-        glVertex2f(-4.6f, 2.5f); glVertex2f(-4.6f, 2.1f);
-
-        // Chair above the desk
-        glVertex2f(-5.0f, 4.1f); glVertex2f(-4.6f, 4.1f);
-        glVertex2f(-5.0f, 3.7f); glVertex2f(-4.6f, 3.7f);
-        glVertex2f(-5.0f, 4.1f); glVertex2f(-5.0f, 3.7f);
-        glVertex2f(-4.6f, 4.1f); glVertex2f(-4.6f, 3.7f);
-
-
-        //Door between office and storage
-		glVertex2f(-6.0f, 5.0f);  glVertex2f(-7.0f, 5.0f);
-        DrawDoorArc(-6.0f, 5.0f, -1.0f, 0.0f, M_PI / -2.0f);
-
-		//Dry Storage Walls
-		glVertex2f(-6.0, 7.0); glVertex2f(-3.0, 7.0);
-        glVertex2f(-3.0, 7.0); glVertex2f(-3.0, 10.0);
-        //Door to Storage
-        glVertex2f(-5.8f, 7.0f);  glVertex2f(-5.8f, 8.0f);
-        DrawDoorArc(-5.8f, 7.0f, 1.0f, 0.0f, M_PI / 2.0f);
-
-		//Freezer
-        glVertex2f(-0.5, 10.0); glVertex2f(-0.5, 7.0);
-        glVertex2f(-0.5, 7.0); glVertex2f(1.5, 7.0);
-        glVertex2f(1.5, 7.0); glVertex2f(1.5, 10.0);
-        //Freezer Door 
-        glVertex2f(-0.3f, 7.0f);  glVertex2f(-0.3f, 8.0f);
-        DrawDoorArc(-0.3f, 7.0f, 1.0f, 0.0f, M_PI / 2.0f);
-
-        //East windows
-        glVertex2f(5.85, -7.55); glVertex2f(6, -7.55);
-        glVertex2f(5.85, -8.775); glVertex2f(6, -8.775);
-        glVertex2f(5.85, -9.85); glVertex2f(6, -9.85);
-        glVertex2f(5.85, -6.325); glVertex2f(6, -6.325);
-        glVertex2f(5.85, -10); glVertex2f(5.85, -6.325);
-
-        //Toilet Walls
-        glVertex2f(6, -6.325); glVertex2f(2.2875, -6.325);
-        glVertex2f(2.2875, -6.325); glVertex2f(2.2875, -4.1625);
-        glVertex2f(2.2875, -3.1625); glVertex2f(6, -3.1625);
-        glVertex2f(2.2875, -3.1625); glVertex2f(2.2875, -1.2);
-		glVertex2f(4.14075, -1.2); glVertex2f(6, -1.2);
-        glVertex2f(4.14075, -2.2); glVertex2f(6, -2.2);
-        glVertex2f(4.14075, -4.1625); glVertex2f(6, -4.1625);
-        glVertex2f(4.14075, -5.1625); glVertex2f(6, -5.1625);
-
-        // Sink 1 (upper)
-        glVertex2f(2.35, -1.8); glVertex2f(2.75, -1.8);
-        glVertex2f(2.75, -1.8); glVertex2f(2.75, -1.4);
-        glVertex2f(2.35, -1.4); glVertex2f(2.75, -1.4);
-        glVertex2f(2.35, -1.8); glVertex2f(2.35, -1.4);
-
-        // Sink 2 (just below it)
-        glVertex2f(2.35, -2.7); glVertex2f(2.75, -2.7);
-        glVertex2f(2.75, -2.7); glVertex2f(2.75, -2.3);
-        glVertex2f(2.35, -2.3); glVertex2f(2.75, -2.3);
-        glVertex2f(2.35, -2.7); glVertex2f(2.35, -2.3);
-
-		//Sink 3 (upper)
-        glVertex2f(2.35, -4.8); glVertex2f(2.75, -4.8);
-        glVertex2f(2.75, -4.8); glVertex2f(2.75, -4.4);
-        glVertex2f(2.35, -4.4); glVertex2f(2.75, -4.4);
-        glVertex2f(2.35, -4.8); glVertex2f(2.35, -4.4);
-
-        // Sink 4 (just below it)
-        glVertex2f(2.35, -5.7); glVertex2f(2.75, -5.7);
-        glVertex2f(2.75, -5.7); glVertex2f(2.75, -5.3);
-        glVertex2f(2.35, -5.3); glVertex2f(2.75, -5.3);
-        glVertex2f(2.35, -5.7); glVertex2f(2.35, -5.3);
-
-		//Toilet Doors 1
-        glVertex2f(2.2875, -0.2); glVertex2f(2.2875, -1.2);
-        DrawDoorArc(2.2875, -0.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -0.2); glVertex2f(4.14075, -1.2);
-        DrawDoorArc(4.14075, -0.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -1.2); glVertex2f(4.14075, -2.2);
-        DrawDoorArc(4.14075, -1.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -2.2); glVertex2f(4.14075, -3.2);
-        DrawDoorArc(4.14075, -2.2, 1.0f, 0.0f, M_PI / -2.0f);
-        
-        //Toilet Doors 2
-        glVertex2f(2.2875, -3.2); glVertex2f(2.2875, -4.2);
-        DrawDoorArc(2.2875, -3.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -3.2); glVertex2f(4.14075, -4.2);
-        DrawDoorArc(4.14075, -3.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -4.2); glVertex2f(4.14075, -5.2);
-        DrawDoorArc(4.14075, -4.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-        glVertex2f(4.14075, -5.2); glVertex2f(4.14075, -6.2);
-        DrawDoorArc(4.14075, -5.2, 1.0f, 0.0f, M_PI / -2.0f);
-
-       //Doors to kitchen
-       // Left door
-        glVertex2f(-2.05f, -0.2f);  glVertex2f(-2.05f, -1.2f);
-        DrawDoorArc(-2.05f, -0.2f, 1.025f, 0.0f, -M_PI / 2.0f);
-
-        // Right door
-        glVertex2f(0.0f, -0.2f);  glVertex2f(0.0f, -1.2f);
-        DrawDoorArc(0.0f, -0.2f, 1.025f, M_PI, 3.0f * M_PI / 2.0f);
-        //Privacy wall 
-        glVertex2f(1.05f, 2.0f);  glVertex2f(-3.0f, 2.0f);
-
-        //Loading Doors
-        glVertex2f(-2.7f, 10.0f);  glVertex2f(-2.7f, 11.0);
-        DrawDoorArc(-2.7f, 10.0f, 1.0f, 0.0f, M_PI / 2.0f);
-        glVertex2f(-0.70f, 10.0f);  glVertex2f(-0.70f, 11.0f);
-        DrawDoorArc(-0.70f, 10.0f, -1.0f, 0.0f, M_PI / -2.0f);
-
-		// Dining tables
-		glVertex2f(-4.0f, -4.0f); glVertex2f(-3.0f, -4.0f);
-            glVertex2f(-3.7, -4.0); glVertex2f(-3.7f, -4.4);
-            glVertex2f(-3.7f, -4.4); glVertex2f(-3.3f, -4.4);
-            glVertex2f(-3.3f, -4.4); glVertex2f(-3.3f, -4.0);
-		glVertex2f(-4.0f, -3.0f); glVertex2f(-3.0f, -3.0f);
-            glVertex2f(-3.7f,-3.0f); glVertex2f(-3.7f, -2.6f);
-            glVertex2f(-3.7f, -2.6f); glVertex2f(-3.3f, -2.6f);
-            glVertex2f(-3.3f, -2.6f); glVertex2f(-3.3f, -3.0f);
-		glVertex2f(-4.0f, -4.0f); glVertex2f(-4.0f, -3.0f);
-            glVertex2f(-4.0f, -3.7f); glVertex2f(-4.4f, -3.7f);
-            glVertex2f(-4.4f, -3.7f); glVertex2f(-4.4f, -3.3f);
-            glVertex2f(-4.4f, -3.3f); glVertex2f(-4.0f, -3.3f);
-		glVertex2f(-3.0f, -4.0f); glVertex2f(-3.0f, -3.0f);
-            glVertex2f(-3.0f, -3.7f); glVertex2f(-2.6f, -3.7f);
-            glVertex2f(-2.6f, -3.7f); glVertex2f(-2.6f, -3.3f);
-            glVertex2f(-2.6f, -3.3f); glVertex2f(-3.0f, -3.3f);
-
-            glVertex2f(-4.0f, -7.0f); glVertex2f(-3.0f, -7.0f);
-            glVertex2f(-3.7, -7.0); glVertex2f(-3.7f, -7.4);
-            glVertex2f(-3.7f, -7.4); glVertex2f(-3.3f, -7.4);
-            glVertex2f(-3.3f, -7.4); glVertex2f(-3.3f, -7.0);
-            glVertex2f(-4.0f, -6.0f); glVertex2f(-3.0f, -6.0f);
-            glVertex2f(-3.7f, -6.0f); glVertex2f(-3.7f, -5.6f);
-            glVertex2f(-3.7f, -5.6f); glVertex2f(-3.3f, -5.6f);
-            glVertex2f(-3.3f, -5.6f); glVertex2f(-3.3f, -6.0f);
-            glVertex2f(-4.0f, -7.0f); glVertex2f(-4.0f, -6.0f);
-            glVertex2f(-4.0f, -6.7f); glVertex2f(-4.4f, -6.7f);
-            glVertex2f(-4.4f, -6.7f); glVertex2f(-4.4f, -6.3f);
-            glVertex2f(-4.4f, -6.3f); glVertex2f(-4.0f, -6.3f);
-            glVertex2f(-3.0f, -7.0f); glVertex2f(-3.0f, -6.0f);
-            glVertex2f(-3.0f, -6.7f); glVertex2f(-2.6f, -6.7f);
-            glVertex2f(-2.6f, -6.7f); glVertex2f(-2.6f, -6.3f);
-            glVertex2f(-2.6f, -6.3f); glVertex2f(-3.0f, -6.3f);
-
-            glVertex2f(-1.0f, -4.0f); glVertex2f(-0.0f, -4.0f);
-            glVertex2f(-0.7, -4.0); glVertex2f(-0.7f, -4.4);
-            glVertex2f(-0.7f, -4.4); glVertex2f(-0.3f, -4.4);
-            glVertex2f(-0.3f, -4.4); glVertex2f(-0.3f, -4.0);
-            glVertex2f(-1.0f, -3.0f); glVertex2f(-0.0f, -3.0f);
-            glVertex2f(-0.7f, -3.0f); glVertex2f(-0.7f, -2.6f);
-            glVertex2f(-0.7f, -2.6f); glVertex2f(-0.3f, -2.6f);
-            glVertex2f(-0.3f, -2.6f); glVertex2f(-0.3f, -3.0f);
-            glVertex2f(-1.0f, -4.0f); glVertex2f(-1.0f, -3.0f);
-            glVertex2f(-1.0f, -3.7f); glVertex2f(-1.4f, -3.7f);
-            glVertex2f(-1.4f, -3.7f); glVertex2f(-1.4f, -3.3f);
-            glVertex2f(-1.4f, -3.3f); glVertex2f(-1.0f, -3.3f);
-            glVertex2f(-0.0f, -4.0f); glVertex2f(-0.0f, -3.0f);
-            glVertex2f(-0.0f, -3.7f); glVertex2f(0.4f, -3.7f);
-            glVertex2f(0.4f, -3.7f); glVertex2f(0.4f, -3.3f);
-            glVertex2f(0.4f, -3.3f); glVertex2f(0.0f, -3.3f);
-
-            glVertex2f(-1.0f, -7.0f); glVertex2f(-0.0f, -7.0f);
-            glVertex2f(-0.7, -7.0); glVertex2f(-0.7f, -7.4);
-            glVertex2f(-0.7f, -7.4); glVertex2f(-0.3f, -7.4);
-            glVertex2f(-0.3f, -7.4); glVertex2f(-0.3f, -7.0);
-            glVertex2f(-1.0f, -6.0f); glVertex2f(-0.0f, -6.0f);
-            glVertex2f(-0.7f, -6.0f); glVertex2f(-0.7f, -5.6f);
-            glVertex2f(-0.7f, -5.6f); glVertex2f(-0.3f, -5.6f);
-            glVertex2f(-0.3f, -5.6f); glVertex2f(-0.3f, -6.0f);
-            glVertex2f(-1.0f, -7.0f); glVertex2f(-1.0f, -6.0f);
-            glVertex2f(-1.0f, -6.7f); glVertex2f(-1.4f, -6.7f);
-            glVertex2f(-1.4f, -6.7f); glVertex2f(-1.4f, -6.3f);
-            glVertex2f(-1.4f, -6.3f); glVertex2f(-1.0f, -6.3f);
-            glVertex2f(-0.0f, -7.0f); glVertex2f(-0.0f, -6.0f);
-            glVertex2f(-0.0f, -6.7f); glVertex2f(0.4f, -6.7f);
-            glVertex2f(0.4f, -6.7f); glVertex2f(0.4f, -6.3f);
-            glVertex2f(0.4f, -6.3f); glVertex2f(0.0f, -6.3f);
-
-            glVertex2f(3.6f, -8.6f); glVertex2f(4.6f, -8.6f);
-            glVertex2f(3.9f, -8.6f); glVertex2f(3.9f, -9.0f);
-            glVertex2f(3.9f, -9.0f); glVertex2f(4.3f, -9.0f);
-            glVertex2f(4.3f, -9.0f); glVertex2f(4.3f, -8.6f);
-
-            glVertex2f(3.6f, -7.6f); glVertex2f(4.6f, -7.6f);
-            glVertex2f(3.9f, -7.6f); glVertex2f(3.9f, -7.2f);
-            glVertex2f(3.9f, -7.2f); glVertex2f(4.3f, -7.2f);
-            glVertex2f(4.3f, -7.2f); glVertex2f(4.3f, -7.6f);
-
-            glVertex2f(3.6f, -8.6f); glVertex2f(3.6f, -7.6f);
-            glVertex2f(3.6f, -8.3f); glVertex2f(3.2f, -8.3f);
-            glVertex2f(3.2f, -8.3f); glVertex2f(3.2f, -7.9f);
-            glVertex2f(3.2f, -7.9f); glVertex2f(3.6f, -7.9f);
-
-            glVertex2f(4.6f, -8.6f); glVertex2f(4.6f, -7.6f);
-            glVertex2f(4.6f, -8.3f); glVertex2f(5.0f, -8.3f);
-            glVertex2f(5.0f, -8.3f); glVertex2f(5.0f, -7.9f);
-            glVertex2f(5.0f, -7.9f); glVertex2f(4.6f, -7.9f);
-
-            //That thing that i cant remember the name of right now
-			glVertex2f(0.5f, -8.0f); glVertex2f(0.5f, -8.5f);
-            glVertex2f(0.5f, -8.5f); glVertex2f(1.0f, -8.5f);
-            glVertex2f(1.0f, -8.5f); glVertex2f(1.0f, -8.0f);
-			glVertex2f(1.0f, -8.0f); glVertex2f(0.5f, -8.0f);
-
-            //Storage Details
-            glVertex2f(-5.5f, 9.8f); glVertex2f(-3.5f, 9.8f); 
-            glVertex2f(-5.5f, 9.8f); glVertex2f(-5.5f, 9.2f); 
-            glVertex2f(-3.5f, 9.8f); glVertex2f(-3.5f, 9.2f); 
-            glVertex2f(-5.5f, 9.2f); glVertex2f(-3.5f, 9.2f);
-            glVertex2f(-5.0f, 9.8f); glVertex2f(-5.0f, 9.2f);
-            glVertex2f(-4.5f, 9.8f); glVertex2f(-4.5f, 9.2f);
-            glVertex2f(-4.0f, 9.8f); glVertex2f(-4.0f, 9.2f);
-
-            //Freezer
-            glVertex2f(-0.3f, 9.8f); glVertex2f(1.3f, 9.8f);   // Back of shelving
-            glVertex2f(-0.3f, 9.8f); glVertex2f(-0.3f, 9.4f);  // Left side
-            glVertex2f(1.3f, 9.8f); glVertex2f(1.3f, 9.4f);    // Right side
-            glVertex2f(-0.3f, 9.4f); glVertex2f(1.3f, 9.4f);   // Front of shelving
-
-            // Shelf divider
-            glVertex2f(0.5f, 9.8f); glVertex2f(0.5f, 9.4f);
-            
-            //Fridge
-            glVertex2f(3.0f, 0.5f); glVertex2f(5.0f, 0.5f);  // Front of fridge
-            glVertex2f(3.0f, 0.5f); glVertex2f(3.0f, 0.0f);  // Left side
-            glVertex2f(5.0f, 0.5f); glVertex2f(5.0f, 0.0f);  // Right side
-            glVertex2f(3.0f, 0.0f); glVertex2f(5.0f, 0.0f);  // Back against wall
-
-            // Door division (center line)
-            glVertex2f(4.0f, -0.05f); glVertex2f(4.0f, -0.05f);
-
-            glVertex2f(3.0f, -0.1f); glVertex2f(5.0f, -0.1f);
-
-
-            FireExtinguisher extinguisher;
-
-            // Kitchen area
-            extinguisher.Draw(1.7f, 8.0f);
-            extinguisher.Draw(5.7f, 0.0f);
-            extinguisher.Draw(-5.8f, 4.8f);
-            //Office
-            extinguisher.Draw(-3.7f, 0.0f);
-            //Dinning
-            extinguisher.Draw(-2.0f, -9.6f);
-
-            Toilet toilet;
-
-            // Upper bathroom
-            toilet.Draw(5.65f, -1.6f, 0);
-            toilet.Draw(5.65f, -0.6f, 0);
-            toilet.Draw(5.65f, -2.6f, 0);
-            
-
-            // Lower bathroom  
-            toilet.Draw(5.65f, -4.6f, 0);
-            toilet.Draw(5.65f, -3.6f, 0);
-            toilet.Draw(5.65f, -5.6f, 0);
-           
-            Bin bin;
-
-            // Kitchen
-            bin.Draw(1.7f, 7.5f);
-            bin.Draw(-0.7f, 4.8f);
-            bin.Draw(-0.7f, 3.2f);
-            bin.Draw(3.7f, 4.8f);
-            bin.Draw(3.7f, 3.2f);
-
-            // Office
-			bin.Draw(-3.7f, 3.8f);
-
-            //Bathrooms 
-			bin.Draw(3.5f, -3.0f);
-            bin.Draw(3.5f, -6.0f);
+        Prepare();
 
-        glEnd();
+        imEnable(GL_BLEND);
+        imBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        imEnable(GL_LINE_SMOOTH);
+        imHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+
+        body.Draw();
+
+        // roof tiles
+        roofTiles.Draw(placeRoofTiling(kGableRoofTiling, sheetPlacement()), lodPixelsPerUnit());
+
+        ridge.Draw();
     }
-};
 
-class RearElevation {
-public:
-    void Draw() {
-        // The original parameters define the boundaries for the drawing:
- // X: [-15.0, 15.0], Y: [30.0, 60.0]
-        float size = 15.0f;     // half-size of rectangle
+private:
+    // The original parameters define the boundaries for the drawing:
+    // X: [-15.0, 15.0], Y: [30.0, 60.0]
+    static Affine2D sheetPlacement() {
         float offsetY = 45.0f;  // center vertically
         float offsetX = 0.0f;   // center horizontally
         float scale = 12.0f;
+        return Affine2D::Placement(scale, scale, offsetX, offsetY);
+    }
 
-        glPushMatrix();
-        glTranslatef(offsetX, offsetY, 0.0f);
-        glScalef(scale, scale, 1.0f);
-
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glEnable(GL_LINE_SMOOTH);
-        glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
-
+    // Walls, window and roof, in the unit-scaled drawing space
+    static void buildBody(GeometryBuffer& out) {
         /*-- Main building(Cream color)--*/
-        drawRectangle(-1.2f, -0.5f, 1.2f, 0.3f, 0.96f, 0.87f, 0.70f);
+        drawRectangle(out, -1.2f, -0.5f, 1.2f, 0.3f, 0.96f, 0.87f, 0.70f);
 
         /*---water pipe---*/
-        drawRectangle(-1.23f, -0.45f, -1.20f, 0.3f, 1.0f, 1.0f, 1.0f);
+        drawRectangle(out, -1.23f, -0.45f, -1.20f, 0.3f, 1.0f, 1.0f, 1.0f);
 
         /*---Extractor vent---*/
-        drawRectangle(-0.8f, 0.4f, -0.65f, 0.7f, 0.75f, 0.75f, 0.75f);  //change size & color
+        drawRectangle(out, -0.8f, 0.4f, -0.65f, 0.7f, 0.75f, 0.75f, 0.75f);  //change size & color
 
         // ----Main Window frame (orange/brown)----
 
@@ -1048,357 +1135,322 @@ public:
         float window_x2 = 0.6f;
         float window_y2 = 0.17f;
 
-        drawBrownWindow(window_x1, window_y1, window_x2, window_y2);
+        drawBrownWindow(out, window_x1, window_y1, window_x2, window_y2);
 
         // Triangle for Roof
 
-        glBegin(GL_TRIANGLES);
-        glColor3f(0.82f, 0.48f, 0.48f);
-        glVertex2f(-1.3f, 0.3f);
-        glColor3f(0.82f, 0.48f, 0.48f);
-        glVertex2f(1.3f, 0.3f);
-        glColor3f(0.90f, 0.62f, 0.62f);
-        glVertex2f(0.0f, 1.0f);
-        glEnd();
-
-
-        glBegin(GL_QUADS);
-        glColor3f(0.35f, 0.12f, 0.12f);
-        glVertex2f(-1.32f, 0.29f);
-        glVertex2f(1.32f, 0.29f);
-        glVertex2f(1.30f, 0.33f);
-        glVertex2f(-1.30f, 0.33f);
-        glEnd();
-
-
-        glBegin(GL_QUADS);
-        glColor4f(0.0f, 0.0f, 0.0f, 0.20f);
-        glVertex2f(-1.2f, 0.30f);
-        glVertex2f(1.2f, 0.30f);
-        glVertex2f(1.2f, 0.24f);
-        glVertex2f(-1.2f, 0.24f);
-        glEnd();
-
-        // roof tiles
-        glColor3f(0.6f, 0.25f, 0.25f);
-        glLineWidth(1.0f);
-
+        out.Begin(GL_TRIANGLES);
+        out.Color3f(0.82f, 0.48f, 0.48f);
+        out.Vertex2f(-1.3f, 0.3f);
+        out.Color3f(0.82f, 0.48f, 0.48f);
+        out.Vertex2f(1.3f, 0.3f);
+        out.Color3f(0.90f, 0.62f, 0.62f);
+        out.Vertex2f(0.0f, 1.0f);
+        out.End();
+
+
+        out.Begin(GL_QUADS);
+        out.Color3f(0.35f, 0.12f, 0.12f);
+        out.Vertex2f(-1.32f, 0.29f);
+        out.Vertex2f(1.32f, 0.29f);
+        out.Vertex2f(1.30f, 0.33f);
+        out.Vertex2f(-1.30f, 0.33f);
+        out.End();
+
+
+        out.Begin(GL_QUADS);
+        out.Color4f(0.0f, 0.0f, 0.0f, 0.20f);
+        out.Vertex2f(-1.2f, 0.30f);
+        out.Vertex2f(1.2f, 0.30f);
+        out.Vertex2f(1.2f, 0.24f);
+        out.Vertex2f(-1.2f, 0.24f);
+        out.End();
+    }
 
-        float tileRowSpacing = 0.04f;
-        float roofBaseY = 0.3f;
-        float roofPeakY = 1.0f;
-        float roofHalfWidth = 1.3f;
+    // Ridge, drawn over the roof tiles
+    static void buildRidge(GeometryBuffer& out) {
+        out.LineWidth(2.5f);
 
-        // tile texture effect
-        int row = 0;
-        for (float y = roofBaseY + tileRowSpacing; y < roofPeakY - 0.03f; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-            float widthAtY = roofHalfWidth * (1.0f - yProgress);
+        out.Color3f(0.3f, 0.10f, 0.10f);
+        out.Begin(GL_LINES);
+        out.Vertex2f(-0.07f, 0.955f);
+        out.Vertex2f(0.07f, 0.955f);
+        out.End();
 
 
-            glColor3f(0.65f, 0.35f, 0.35f);
-            glBegin(GL_LINES);
-            glVertex2f(-widthAtY + 0.02f, y - 0.005f);
-            glVertex2f(widthAtY - 0.02f, y - 0.005f);
-            glEnd();
+        out.Color3f(0.4f, 0.15f, 0.15f);
+        out.Begin(GL_LINES);
+        out.Vertex2f(-0.06f, 0.96f);
+        out.Vertex2f(0.06f, 0.96f);
+        out.End();
+        out.LineWidth(1.0f);
+    }
 
+    GeometryBuffer body;        // built by Prepare()
+    GeometryBuffer ridge;
+    RoofTiles roofTiles;
+};
 
-            glColor3f(0.75f, 0.45f, 0.45f);
-            glBegin(GL_LINES);
-            glVertex2f(-widthAtY + 0.02f, y);
-            glVertex2f(widthAtY - 0.02f, y);
-            glEnd();
+class FrontElevation {
+public:
+    // Tessellates the facade, queues every flower box level on 'pool' and
+    // generates the roof tiles
+    void Prepare(ThreadPool& pool) {
+        Affine2D placement = sheetPlacement();
+        WindowLayout layout = windowLayout();
+        for (float startX : { layout.leftStartX, layout.rightStartX }) {
+            for (int i = 0; i < layout.windowsPerSide; i++) {
+                float x = startX + i * (layout.windowWidth + layout.gap);
+                prepareFlowerBox(pool, x, layout.boxY, x + layout.windowWidth, layout.boxY, layout.boxHeight, placement);
+            }
         }
+        Prepare();
+    }
 
+    // The parts without flower boxes; CPU only
+    void Prepare() {
+        if (!facade.Empty())
+            return;
+
+        Affine2D placement = sheetPlacement();
+        buildFacade(facade);
+        facade.Transform(placement);
+        buildRoof(roof);
+        roof.Transform(placement);
+        buildRidge(ridge);
+        ridge.Transform(placement);
+        roofTiles.Prepare(placeRoofTiling(kGableRoofTiling, placement));
+    }
 
-        float tileWidth = 0.08f;
-        row = 0;
-        for (float y = roofBaseY + tileRowSpacing * 0.5f; y < roofPeakY - 0.08f; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-            float widthAtY = roofHalfWidth * (1.0f - yProgress);
-
-
-            float offset = (row % 2 == 0) ? 0.0f : tileWidth * 0.5f;
+    void Draw() {
+        Prepare();
 
+        Affine2D placement = sheetPlacement();
+        float scale = placement.a;
 
-            for (float x = -widthAtY + offset; x < widthAtY - 0.02f; x += tileWidth) {
-                if (x > -widthAtY + 0.02f && x < widthAtY - 0.02f) {
+        // Enable alpha blending for transparency effects
+        imEnable(GL_BLEND);
+        imBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        imEnable(GL_LINE_SMOOTH);
+        imHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
 
-                    glColor3f(0.65f, 0.35f, 0.35f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x + 0.002f, y - tileRowSpacing * 0.3f);
-                    glVertex2f(x + 0.002f, y + tileRowSpacing * 0.3f);
-                    glEnd();
+        facade.Draw();
 
+        // Flower boxes aligned with windows (same width as windows)
+        WindowLayout layout = windowLayout();
+        float windowWidth = layout.windowWidth;
+        float gap = layout.gap;
+        int windowsPerSide = layout.windowsPerSide;
+        float boxHeight = layout.boxHeight;
+        float boxY = layout.boxY;
 
-                    glColor3f(0.75f, 0.45f, 0.45f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x, y - tileRowSpacing * 0.3f);
-                    glVertex2f(x, y + tileRowSpacing * 0.3f);
-                    glEnd();
-                }
-            }
+        // Left side flower boxes (aligned with left windows)
+        for (int i = 0; i < windowsPerSide; i++) {
+            float x = layout.leftStartX + i * (windowWidth + gap);
+            drawFlowerBox(x, boxY, x + windowWidth, boxY, boxHeight, placement, lodPixelsPerUnit() * scale);
         }
 
-        // Ridge
-        glLineWidth(2.5f);
-
-        glColor3f(0.3f, 0.10f, 0.10f);
-        glBegin(GL_LINES);
-        glVertex2f(-0.07f, 0.955f);
-        glVertex2f(0.07f, 0.955f);
-        glEnd();
+        // Right side flower boxes (aligned with right windows)
+        for (int i = 0; i < windowsPerSide; i++) {
+            float x = layout.rightStartX + i * (windowWidth + gap);
+            drawFlowerBox(x, boxY, x + windowWidth, boxY, boxHeight, placement, lodPixelsPerUnit() * scale);
+        }
 
+        roof.Draw();
 
-        glColor3f(0.4f, 0.15f, 0.15f);
-        glBegin(GL_LINES);
-        glVertex2f(-0.06f, 0.96f);
-        glVertex2f(0.06f, 0.96f);
-        glEnd();
-        glLineWidth(1.0f);
+        // Roof tiling texture with overlapping dimension
+        roofTiles.Draw(placeRoofTiling(kGableRoofTiling, placement), lodPixelsPerUnit());
 
-        glPopMatrix();
+        ridge.Draw();
     }
-};
 
-class FrontElevation {
-public:
-    void Draw() {
-        // Position the restaurant front view in the front elevation area
+private:
+    // Position the restaurant front view in the front elevation area
+    static Affine2D sheetPlacement() {
         float offsetY = -45.0f; // center vertically below floor plan
         float offsetX = 0.0f;   // center horizontally
         float scale = 12.0f;    // scale to fit in the elevation area
+        return Affine2D::Placement(scale, scale, offsetX, offsetY);
+    }
 
-        glPushMatrix();
-        glTranslatef(offsetX, offsetY, 0.0f);
-        glScalef(scale, scale, 1.0f);
-
-        // Enable alpha blending for transparency effects
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glEnable(GL_LINE_SMOOTH);
-        glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
-
+    // Background, building, door, sign and windows, in the unit-scaled drawing space
+    static void buildFacade(GeometryBuffer& out) {
         // Black background for the restaurant view
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glBegin(GL_QUADS);
-        glVertex2f(-1.5f, -0.8f);
-        glVertex2f(1.5f, -0.8f);
-        glVertex2f(1.5f, 1.2f);
-        glVertex2f(-1.5f, 1.2f);
-        glEnd();
+        out.Color3f(0.0f, 0.0f, 0.0f);
+        out.Begin(GL_QUADS);
+        out.Vertex2f(-1.5f, -0.8f);
+        out.Vertex2f(1.5f, -0.8f);
+        out.Vertex2f(1.5f, 1.2f);
+        out.Vertex2f(-1.5f, 1.2f);
+        out.End();
 
         // Main building rectangle (beige color)
-        drawRectangle(-1.2f, -0.5f, 1.2f, 0.3f, 0.96f, 0.87f, 0.70f); // beige
+        drawRectangle(out, -1.2f, -0.5f, 1.2f, 0.3f, 0.96f, 0.87f, 0.70f); // beige
 
         // ---- Modern Glass Door (matching reference image) ----
         // Main door frame (orange/brown)
-        drawRectangle(-0.25f, -0.5f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f);
+        drawRectangle(out, -0.25f, -0.5f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f);
 
         // Large glass panels (blue tinted like the image)
-        drawRectangle(-0.23f, -0.48f, -0.02f, 0.13f, 0.6f, 0.75f, 0.9f); // left glass
-        drawRectangle(0.02f, -0.48f, 0.23f, 0.13f, 0.6f, 0.75f, 0.9f); // right glass
+        drawRectangle(out, -0.23f, -0.48f, -0.02f, 0.13f, 0.6f, 0.75f, 0.9f); // left glass
+        drawRectangle(out, 0.02f, -0.48f, 0.23f, 0.13f, 0.6f, 0.75f, 0.9f); // right glass
 
         // Vertical door frames
-        drawRectangle(-0.25f, -0.5f, -0.23f, 0.15f, 0.8f, 0.5f, 0.2f); // left frame
-        drawRectangle(0.23f, -0.5f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f); // right frame
-        drawRectangle(-0.02f, -0.5f, 0.02f, 0.15f, 0.8f, 0.5f, 0.2f); // center frame
+        drawRectangle(out, -0.25f, -0.5f, -0.23f, 0.15f, 0.8f, 0.5f, 0.2f); // left frame
+        drawRectangle(out, 0.23f, -0.5f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f); // right frame
+        drawRectangle(out, -0.02f, -0.5f, 0.02f, 0.15f, 0.8f, 0.5f, 0.2f); // center frame
 
         // Horizontal frames
-        drawRectangle(-0.25f, -0.5f, 0.25f, -0.48f, 0.8f, 0.5f, 0.2f); // bottom
-        drawRectangle(-0.25f, 0.13f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f); // top
+        drawRectangle(out, -0.25f, -0.5f, 0.25f, -0.48f, 0.8f, 0.5f, 0.2f); // bottom
+        drawRectangle(out, -0.25f, 0.13f, 0.25f, 0.15f, 0.8f, 0.5f, 0.2f); // top
 
         // Door handles (modern style)
-        drawRectangle(-0.04f, -0.15f, -0.03f, -0.05f, 0.3f, 0.3f, 0.3f); // left handle
-        drawRectangle(0.03f, -0.15f, 0.04f, -0.05f, 0.3f, 0.3f, 0.3f); // right handle
+        drawRectangle(out, -0.04f, -0.15f, -0.03f, -0.05f, 0.3f, 0.3f, 0.3f); // left handle
+        drawRectangle(out, 0.03f, -0.15f, 0.04f, -0.05f, 0.3f, 0.3f, 0.3f); // right handle
 
         // Horizontal window (aligned with tops of vertical windows) with frame
-        drawRectangle(-0.23f, 0.16f, 0.23f, 0.26f, 0.8f, 0.5f, 0.2f); // orange frame
-        drawRectangle(-0.21f, 0.17f, 0.21f, 0.25f, 0.6f, 0.75f, 0.9f); // blue glass
+        drawRectangle(out, -0.23f, 0.16f, 0.23f, 0.26f, 0.8f, 0.5f, 0.2f); // orange frame
+        drawRectangle(out, -0.21f, 0.17f, 0.21f, 0.25f, 0.6f, 0.75f, 0.9f); // blue glass
 
         // OPEN sign on the horizontal window
-        drawOpenSign(0.0f, 0.21f, 0.25f, 0.06f);
+        drawOpenSign(out, 0.0f, 0.21f, 0.25f, 0.06f);
 
         // ---- Vertical windows ----
-        float windowWidth = 0.20f; // thinner window panes
-        float gap = 0.02f;
-
-        // Compute centered layout for side windows (within main building rectangle)
-        float buildingLeft = -1.2f;
-        float buildingRight = 1.2f;
-        float doorLeft = -0.25f; // expanded for spacing
-        float doorRight = 0.25f;  // expanded for spacing
-        float leftContainerStart = buildingLeft;
-        float leftContainerEnd = doorLeft;
-        float rightContainerStart = doorRight;
-        float rightContainerEnd = buildingRight;
-        float leftContainerWidth = leftContainerEnd - leftContainerStart;   // -0.18 - (-1.2) = 1.02
-        float rightContainerWidth = rightContainerEnd - rightContainerStart; // 1.2 - 0.18 = 1.02
-        int windowsPerSide = 4;
-        float totalWindowsWidth = windowsPerSide * windowWidth + (windowsPerSide - 1) * gap;
-        // Center windows properly with some spacing from walls
-        float wallSpacing = 0.05f; // smaller spacing for better alignment
-        float leftAvailableWidth = leftContainerWidth - (2 * wallSpacing);
-        float rightAvailableWidth = rightContainerWidth - (2 * wallSpacing);
-        float leftStartX = leftContainerStart + wallSpacing + (leftAvailableWidth - totalWindowsWidth) * 0.5f;
-        float rightStartX = rightContainerStart + wallSpacing + (rightAvailableWidth - totalWindowsWidth) * 0.5f;
+        WindowLayout layout = windowLayout();
+        float windowWidth = layout.windowWidth;
+        float gap = layout.gap;
+        int windowsPerSide = layout.windowsPerSide;
+        float leftStartX = layout.leftStartX;
+        float rightStartX = layout.rightStartX;
 
         // Left side windows (centered within left side of building) with frames
         for (int i = 0; i < windowsPerSide; i++) {
             float x = leftStartX + i * (windowWidth + gap);
             // Window frame
-            drawRectangle(x - 0.01f, -0.49f, x + windowWidth + 0.01f, 0.26f, 0.8f, 0.5f, 0.2f);
+            drawRectangle(out, x - 0.01f, -0.49f, x + windowWidth + 0.01f, 0.26f, 0.8f, 0.5f, 0.2f);
             // Glass
-            drawRectangle(x, -0.48f, x + windowWidth, 0.25f, 0.6f, 0.75f, 0.9f);
+            drawRectangle(out, x, -0.48f, x + windowWidth, 0.25f, 0.6f, 0.75f, 0.9f);
         }
 
         // Right side windows (mirrored and centered within right side of building) with frames
         for (int i = 0; i < windowsPerSide; i++) {
             float x = rightStartX + i * (windowWidth + gap);
             // Window frame
-            drawRectangle(x - 0.01f, -0.49f, x + windowWidth + 0.01f, 0.26f, 0.8f, 0.5f, 0.2f);
+            drawRectangle(out, x - 0.01f, -0.49f, x + windowWidth + 0.01f, 0.26f, 0.8f, 0.5f, 0.2f);
             // Glass
-            drawRectangle(x, -0.48f, x + windowWidth, 0.25f, 0.6f, 0.75f, 0.9f);
-        }
-
-        // Flower boxes aligned with windows (same width as windows)
-        float boxHeight = 0.12f;
-        float boxY = -0.5f; // aligned with building base
-
-        // Left side flower boxes (aligned with left windows)
-        for (int i = 0; i < windowsPerSide; i++) {
-            float x = leftStartX + i * (windowWidth + gap);
-            drawFlowerBox(x, boxY, x + windowWidth, boxY, boxHeight);
-        }
-
-        // Right side flower boxes (aligned with right windows)
-        for (int i = 0; i < windowsPerSide; i++) {
-            float x = rightStartX + i * (windowWidth + gap);
-            drawFlowerBox(x, boxY, x + windowWidth, boxY, boxHeight);
+            drawRectangle(out, x, -0.48f, x + windowWidth, 0.25f, 0.6f, 0.75f, 0.9f);
         }
+    }
 
+    // Roof shape under the tiles
+    static void buildRoof(GeometryBuffer& out) {
         // ---- Roof triangle ----
         // Slightly darker gradient for better cohesion with eave shadow
-        glBegin(GL_TRIANGLES);
-        glColor3f(0.82f, 0.48f, 0.48f); // base left
-        glVertex2f(-1.3f, 0.3f);
-        glColor3f(0.82f, 0.48f, 0.48f); // base right
-        glVertex2f(1.3f, 0.3f);
-        glColor3f(0.90f, 0.62f, 0.62f); // towards the peak
-        glVertex2f(0.0f, 1.0f);
-        glEnd();
+        out.Begin(GL_TRIANGLES);
+        out.Color3f(0.82f, 0.48f, 0.48f); // base left
+        out.Vertex2f(-1.3f, 0.3f);
+        out.Color3f(0.82f, 0.48f, 0.48f); // base right
+        out.Vertex2f(1.3f, 0.3f);
+        out.Color3f(0.90f, 0.62f, 0.62f); // towards the peak
+        out.Vertex2f(0.0f, 1.0f);
+        out.End();
 
         // Eave cap along the bottom edge of the roof (slight overhang)
-        glBegin(GL_QUADS);
-        glColor3f(0.35f, 0.12f, 0.12f);
-        glVertex2f(-1.32f, 0.29f);
-        glVertex2f(1.32f, 0.29f);
-        glVertex2f(1.30f, 0.33f);
-        glVertex2f(-1.30f, 0.33f);
-        glEnd();
+        out.Begin(GL_QUADS);
+        out.Color3f(0.35f, 0.12f, 0.12f);
+        out.Vertex2f(-1.32f, 0.29f);
+        out.Vertex2f(1.32f, 0.29f);
+        out.Vertex2f(1.30f, 0.33f);
+        out.Vertex2f(-1.30f, 0.33f);
+        out.End();
 
         // Soft roof shadow on the building facade
-        glBegin(GL_QUADS);
-        glColor4f(0.0f, 0.0f, 0.0f, 0.20f);
-        glVertex2f(-1.2f, 0.30f);
-        glVertex2f(1.2f, 0.30f);
-        glVertex2f(1.2f, 0.24f);
-        glVertex2f(-1.2f, 0.24f);
-        glEnd();
-
-        // Roof tiling texture with overlapping dimension
-        glColor3f(0.6f, 0.25f, 0.25f); // tile definition lines
-        glLineWidth(1.0f);
-
-        // Smaller tile dimensions
-        float tileRowSpacing = 0.04f; // smaller rows
-        float roofBaseY = 0.3f;
-        float roofPeakY = 1.0f;
-        float roofHalfWidth = 1.3f;
-
-        // Draw overlapping tile effect with multiple passes
-        int row = 0;
-        for (float y = roofBaseY + tileRowSpacing; y < roofPeakY - 0.03f; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-            float widthAtY = roofHalfWidth * (1.0f - yProgress);
-
-            // Draw tile shadows first (overlapping effect - lighter)
-            glColor3f(0.65f, 0.35f, 0.35f); // lighter shadow
-            glBegin(GL_LINES);
-            glVertex2f(-widthAtY + 0.02f, y - 0.005f); // shadow line slightly below
-            glVertex2f(widthAtY - 0.02f, y - 0.005f);
-            glEnd();
-
-            // Draw main tile line (lighter)
-            glColor3f(0.75f, 0.45f, 0.45f);
-            glBegin(GL_LINES);
-            glVertex2f(-widthAtY + 0.02f, y);
-            glVertex2f(widthAtY - 0.02f, y);
-            glEnd();
-        }
-
-        // Vertical tile separators (smaller, staggered pattern)
-        float tileWidth = 0.08f; // smaller individual tiles
-        row = 0;
-        for (float y = roofBaseY + tileRowSpacing * 0.5f; y < roofPeakY - 0.08f; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-            float widthAtY = roofHalfWidth * (1.0f - yProgress);
-
-            // Stagger every other row for realistic overlap
-            float offset = (row % 2 == 0) ? 0.0f : tileWidth * 0.5f;
-
-            // Draw vertical separators with shadow effect
-            for (float x = -widthAtY + offset; x < widthAtY - 0.02f; x += tileWidth) {
-                if (x > -widthAtY + 0.02f && x < widthAtY - 0.02f) {
-                    // Shadow line (lighter)
-                    glColor3f(0.65f, 0.35f, 0.35f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x + 0.002f, y - tileRowSpacing * 0.3f); // offset shadow
-                    glVertex2f(x + 0.002f, y + tileRowSpacing * 0.3f);
-                    glEnd();
-
-                    // Main separator line (lighter)
-                    glColor3f(0.75f, 0.45f, 0.45f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x, y - tileRowSpacing * 0.3f);
-                    glVertex2f(x, y + tileRowSpacing * 0.3f);
-                    glEnd();
-                }
-            }
-        }
+        out.Begin(GL_QUADS);
+        out.Color4f(0.0f, 0.0f, 0.0f, 0.20f);
+        out.Vertex2f(-1.2f, 0.30f);
+        out.Vertex2f(1.2f, 0.30f);
+        out.Vertex2f(1.2f, 0.24f);
+        out.Vertex2f(-1.2f, 0.24f);
+        out.End();
+    }
 
+    // Ridge cap and extractor, drawn over the roof tiles
+    static void buildRidge(GeometryBuffer& out) {
         // Ridge cap with dimensional effect
-        glLineWidth(2.5f);
+        out.LineWidth(2.5f);
         // Ridge shadow
-        glColor3f(0.3f, 0.10f, 0.10f);
-        glBegin(GL_LINES);
-        glVertex2f(-0.07f, 0.955f);
-        glVertex2f(0.07f, 0.955f);
-        glEnd();
+        out.Color3f(0.3f, 0.10f, 0.10f);
+        out.Begin(GL_LINES);
+        out.Vertex2f(-0.07f, 0.955f);
+        out.Vertex2f(0.07f, 0.955f);
+        out.End();
 
         // Main ridge cap
-        glColor3f(0.4f, 0.15f, 0.15f);
-        glBegin(GL_LINES);
-        glVertex2f(-0.06f, 0.96f);
-        glVertex2f(0.06f, 0.96f);
-        glEnd();
-        glLineWidth(1.0f);
+        out.Color3f(0.4f, 0.15f, 0.15f);
+        out.Begin(GL_LINES);
+        out.Vertex2f(-0.06f, 0.96f);
+        out.Vertex2f(0.06f, 0.96f);
+        out.End();
+        out.LineWidth(1.0f);
 
         // ---- Extractor on the roof ----
         // Position it on the right slope of the roof, closer to the top
         float extractorX = 0.4f;
         float roofSlope = (1.0f - 0.3f) / (0.0f - 1.3f);
         float extractorY = roofSlope * (extractorX - 1.3f) + 0.3f;
-        drawExtractor(extractorX, extractorY, 0.08f, 0.12f, roofSlope);
+        drawExtractor(out, extractorX, extractorY, 0.08f, 0.12f, roofSlope);
+    }
+
+    // Side windows, four on each side of the door, with a flower box under each
+    struct WindowLayout {
+        float windowWidth, gap;
+        int windowsPerSide;
+        float leftStartX, rightStartX;
+        float boxHeight, boxY;
+    };
+
+    static WindowLayout windowLayout() {
+        float windowWidth = 0.20f; // thinner window panes
+        float gap = 0.02f;
 
-        glPopMatrix();
+        // Compute centered layout for side windows (within main building rectangle)
+        float buildingLeft = -1.2f;
+        float buildingRight = 1.2f;
+        float doorLeft = -0.25f; // expanded for spacing
+        float doorRight = 0.25f;  // expanded for spacing
+        float leftContainerStart = buildingLeft;
+        float leftContainerEnd = doorLeft;
+        float rightContainerStart = doorRight;
+        float rightContainerEnd = buildingRight;
+        float leftContainerWidth = leftContainerEnd - leftContainerStart;   // -0.18 - (-1.2) = 1.02
+        float rightContainerWidth = rightContainerEnd - rightContainerStart; // 1.2 - 0.18 = 1.02
+        int windowsPerSide = 4;
+        float totalWindowsWidth = windowsPerSide * windowWidth + (windowsPerSide - 1) * gap;
+        // Center windows properly with some spacing from walls
+        float wallSpacing = 0.05f; // smaller spacing for better alignment
+        float leftAvailableWidth = leftContainerWidth - (2 * wallSpacing);
+        float rightAvailableWidth = rightContainerWidth - (2 * wallSpacing);
+        float leftStartX = leftContainerStart + wallSpacing + (leftAvailableWidth - totalWindowsWidth) * 0.5f;
+        float rightStartX = rightContainerStart + wallSpacing + (rightAvailableWidth - totalWindowsWidth) * 0.5f;
+
+        float boxHeight = 0.12f;
+        float boxY = -0.5f; // aligned with building base
+
+        return { windowWidth, gap, windowsPerSide, leftStartX, rightStartX, boxHeight, boxY };
     }
+
+    GeometryBuffer facade;      // built by Prepare()
+    GeometryBuffer roof;
+    GeometryBuffer ridge;
+    RoofTiles roofTiles;
 };
 
 class LeftElevation {
 public:
-    void Draw() {
-        glPushMatrix();
+    // Tessellates the elevation on first use; CPU only, so it can run on a pool thread
+    void Prepare() {
+        if (!geometry.Empty())
+            return;
 
         float offsetX = -45.0f;
         float offsetY = 0.0f;
@@ -1412,28 +1464,38 @@ public:
         float scaleY = wallHeightGL / originalHeight;
         float scaleX = wallWidthGL / originalWidth;
 
-        drawWalls(scaleX, scaleY, offsetX, offsetY);
-        drawRoof(scaleX, scaleY, offsetX, offsetY);
-        drawDoor(scaleX, scaleY, offsetX, offsetY, wallWidthGL);
-        drawWindows(scaleX, scaleY, offsetX, offsetY, wallWidthGL);
-        drawGlassPanels(scaleX, scaleY, offsetX, offsetY, wallWidthGL);
+        // Drawn in model units, then placed on the sheet in one pass
+        drawWalls(geometry);
+        drawRoof(geometry);
+        drawDoor(geometry, wallWidthGL);
+        drawWindows(geometry, scaleX / scaleY, wallWidthGL);
+        drawGlassPanels(geometry, scaleX / scaleY, wallWidthGL);
+        geometry.Transform(Affine2D::Placement(scaleX, scaleY, offsetX, offsetY));
+    }
+
+    void Draw() {
+        Prepare();
 
-        glPopMatrix();
+        // The glass is translucent; the opaque parts (alpha 1) look the same blended
+        imEnable(GL_BLEND);
+        imBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        geometry.Draw();
+        imDisable(GL_BLEND);
     }
 
 private:
-    void drawWalls(float sx, float sy, float ox, float oy) {
-        glColor3f(0.78f, 0.72f, 0.65f);
-        glBegin(GL_POLYGON);
-        glVertex2f(-0.85f * sx + ox, -0.5f * sy + oy);
-        glVertex2f(0.85f * sx + ox, -0.5f * sy + oy);
-        glVertex2f(0.85f * sx + ox, 0.1f * sy + oy);
-        glVertex2f(-0.85f * sx + ox, 0.1f * sy + oy);
-        glEnd();
+    void drawWalls(GeometryBuffer& out) {
+        out.Color3f(0.78f, 0.72f, 0.65f);
+        out.Begin(GL_POLYGON);
+        out.Vertex2f(-0.85f, -0.5f);
+        out.Vertex2f(0.85f, -0.5f);
+        out.Vertex2f(0.85f, 0.1f);
+        out.Vertex2f(-0.85f, 0.1f);
+        out.End();
     }
 
-    void drawRoof(float sx, float sy, float ox, float oy) {
-        glColor3f(0.95f, 0.45f, 0.40f);
+    void drawRoof(GeometryBuffer& out) {
+        out.Color3f(0.95f, 0.45f, 0.40f);
 
         float roofOverhangGL = 0.19f; // scaled to 20 GL units wall
         float glToModelX = originalWidth / 20.0f;
@@ -1443,16 +1505,16 @@ private:
         float left = -0.85f - overhangModel;
         float right = 0.85f + overhangModel;
 
-        glBegin(GL_POLYGON);
-        glVertex2f(left * sx + ox, 0.1f * sy + oy);
-        glVertex2f(right * sx + ox, 0.1f * sy + oy);
-        glVertex2f(0.5f * sx + ox, 0.5f * sy + oy);
-        glVertex2f(-0.5f * sx + ox, 0.5f * sy + oy);
-        glEnd();
+        out.Begin(GL_POLYGON);
+        out.Vertex2f(left, 0.1f);
+        out.Vertex2f(right, 0.1f);
+        out.Vertex2f(0.5f, 0.5f);
+        out.Vertex2f(-0.5f, 0.5f);
+        out.End();
     }
 
-    void drawDoor(float sx, float sy, float ox, float oy, float wallWidthGL) {
-        glColor3f(0.75f, 0.45f, 0.25f);
+    void drawDoor(GeometryBuffer& out, float wallWidthGL) {
+        out.Color3f(0.75f, 0.45f, 0.25f);
 
         float leftWallModel = -0.85f;
         float glToModel = originalWidth / wallWidthGL;
@@ -1460,140 +1522,155 @@ private:
         float doorLeftModel = leftWallModel + 3.16f * glToModel;
         float doorRightModel = doorLeftModel + 1.0f * glToModel;
 
-        float doorBottom = -0.5f * sy + oy;
-        float doorTop = -0.1f * sy + oy;
+        float doorBottom = -0.5f;
+        float doorTop = -0.1f;
 
-        glBegin(GL_POLYGON);
-        glVertex2f(doorLeftModel * sx + ox, doorBottom);
-        glVertex2f(doorRightModel * sx + ox, doorBottom);
-        glVertex2f(doorRightModel * sx + ox, doorTop);
-        glVertex2f(doorLeftModel * sx + ox, doorTop);
-        glEnd();
+        out.Begin(GL_POLYGON);
+        out.Vertex2f(doorLeftModel, doorBottom);
+        out.Vertex2f(doorRightModel, doorBottom);
+        out.Vertex2f(doorRightModel, doorTop);
+        out.Vertex2f(doorLeftModel, doorTop);
+        out.End();
     }
 
-    void drawWindows(float sx, float sy, float ox, float oy, float wallWidthGL) {
+    // 'aspect' is the placement's x scale over its y scale; the frames are
+    // as thick vertically as horizontally once placed
+    void drawWindows(GeometryBuffer& out, float aspect, float wallWidthGL) {
         float glToModel = originalWidth / wallWidthGL;
 
         float winWidthModel = 0.9f * glToModel;
         float gapModel = 0.52f * glToModel;
 
-        float winHeight = 0.25f * sy;
-        float startX = -0.4f * sx;
-        float startY = -0.35f * sy;
-        float frameThick = 0.01f * sx;
+        float winHeight = 0.25f;
+        float startX = -0.4f;
+        float startY = -0.35f;
+        float frameX = 0.01f;
+        float frameY = 0.01f * aspect;
 
         for (int i = 0; i < 3; i++) {
-            float x = startX + i * ((winWidthModel + gapModel) * sx);
+            float x = startX + i * (winWidthModel + gapModel);
 
-            glColor3f(0.55f, 0.27f, 0.07f);
+            out.Color3f(0.55f, 0.27f, 0.07f);
             // left frame
-            glBegin(GL_POLYGON);
-            glVertex2f(x + ox, startY + oy);
-            glVertex2f(x + frameThick + ox, startY + oy);
-            glVertex2f(x + frameThick + ox, startY + winHeight + oy);
-            glVertex2f(x + ox, startY + winHeight + oy);
-            glEnd();
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(x, startY);
+            out.Vertex2f(x + frameX, startY);
+            out.Vertex2f(x + frameX, startY + winHeight);
+            out.Vertex2f(x, startY + winHeight);
+            out.End();
 
             // right frame
-            glBegin(GL_POLYGON);
-            glVertex2f(x + winWidthModel * sx - frameThick + ox, startY + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + winHeight + oy);
-            glVertex2f(x + winWidthModel * sx - frameThick + ox, startY + winHeight + oy);
-            glEnd();
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(x + winWidthModel - frameX, startY);
+            out.Vertex2f(x + winWidthModel, startY);
+            out.Vertex2f(x + winWidthModel, startY + winHeight);
+            out.Vertex2f(x + winWidthModel - frameX, startY + winHeight);
+            out.End();
 
             // top frame
-            glBegin(GL_POLYGON);
-            glVertex2f(x + ox, startY + winHeight - frameThick + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + winHeight - frameThick + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + winHeight + oy);
-            glVertex2f(x + ox, startY + winHeight + oy);
-            glEnd();
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(x, startY + winHeight - frameY);
+            out.Vertex2f(x + winWidthModel, startY + winHeight - frameY);
+            out.Vertex2f(x + winWidthModel, startY + winHeight);
+            out.Vertex2f(x, startY + winHeight);
+            out.End();
 
             // bottom frame
-            glBegin(GL_POLYGON);
-            glVertex2f(x + ox, startY + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + oy);
-            glVertex2f(x + winWidthModel * sx + ox, startY + frameThick + oy);
-            glVertex2f(x + ox, startY + frameThick + oy);
-            glEnd();
-
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glColor4f(1.0f, 1.0f, 1.0f, 0.9f);
-            glBegin(GL_POLYGON);
-            glVertex2f(x + frameThick + ox, startY + frameThick + oy);
-            glVertex2f(x + winWidthModel * sx - frameThick + ox, startY + frameThick + oy);
-            glVertex2f(x + winWidthModel * sx - frameThick + ox, startY + winHeight - frameThick + oy);
-            glVertex2f(x + frameThick + ox, startY + winHeight - frameThick + oy);
-            glEnd();
-            glDisable(GL_BLEND);
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(x, startY);
+            out.Vertex2f(x + winWidthModel, startY);
+            out.Vertex2f(x + winWidthModel, startY + frameY);
+            out.Vertex2f(x, startY + frameY);
+            out.End();
+
+            out.Color4f(1.0f, 1.0f, 1.0f, 0.9f);
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(x + frameX, startY + frameY);
+            out.Vertex2f(x + winWidthModel - frameX, startY + frameY);
+            out.Vertex2f(x + winWidthModel - frameX, startY + winHeight - frameY);
+            out.Vertex2f(x + frameX, startY + winHeight - frameY);
+            out.End();
         }
     }
 
-    void drawGlassPanels(float sx, float sy, float ox, float oy, float wallWidthGL) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    void drawGlassPanels(GeometryBuffer& out, float aspect, float wallWidthGL) {
 
         int numPanels = 8;
         float paneGLWidth = 1.185f;
         float gapGL = 0.1f;
         float glToModel = originalWidth / wallWidthGL;
 
-        float wallRight = 0.85f;
         float totalWidth = numPanels * paneGLWidth + (numPanels - 1) * gapGL;
         float startGLX = wallWidthGL - totalWidth;
         float startModelX = -0.85f + startGLX * glToModel;
         float paneModelWidth = paneGLWidth * glToModel;
         float gapModel = gapGL * glToModel;
 
-        float bottom = -0.45f * sy + oy;
-        float top = 0.1f * sy + oy;
-        float frameThickness = 0.01f * sx;
+        float sb = -0.45f;
+        float st = 0.1f;
+        float fx = 0.01f;
+        float fy = 0.01f * aspect;
 
         for (int i = 0; i < numPanels; i++) {
-            float x0 = startModelX + i * (paneModelWidth + gapModel);
-            float x1 = x0 + paneModelWidth;
-
-            float sx0 = x0 * sx + ox;
-            float sx1 = x1 * sx + ox;
-            float sb = bottom;
-            float st = top;
-            float sf = frameThickness;
-
-            glColor3f(0.55f, 0.27f, 0.07f);
-            glBegin(GL_POLYGON); glVertex2f(sx0, sb); glVertex2f(sx0 + sf, sb); glVertex2f(sx0 + sf, st); glVertex2f(sx0, st); glEnd();
-            glBegin(GL_POLYGON); glVertex2f(sx1 - sf, sb); glVertex2f(sx1, sb); glVertex2f(sx1, st); glVertex2f(sx1 - sf, st); glEnd();
-            glBegin(GL_POLYGON); glVertex2f(sx0, st - sf); glVertex2f(sx1, st - sf); glVertex2f(sx1, st); glVertex2f(sx0, st); glEnd();
-            glBegin(GL_POLYGON); glVertex2f(sx0, sb); glVertex2f(sx1, sb); glVertex2f(sx1, sb + sf); glVertex2f(sx0, sb + sf); glEnd();
-
-            glColor4f(0.6f, 0.75f, 0.9f, 0.6f);
-            glBegin(GL_POLYGON);
-            glVertex2f(sx0 + sf, sb + sf);
-            glVertex2f(sx1 - sf, sb + sf);
-            glVertex2f(sx1 - sf, st - sf);
-            glVertex2f(sx0 + sf, st - sf);
-            glEnd();
+            float sx0 = startModelX + i * (paneModelWidth + gapModel);
+            float sx1 = sx0 + paneModelWidth;
+
+            out.Color3f(0.55f, 0.27f, 0.07f);
+            out.Begin(GL_POLYGON); out.Vertex2f(sx0, sb); out.Vertex2f(sx0 + fx, sb); out.Vertex2f(sx0 + fx, st); out.Vertex2f(sx0, st); out.End();
+            out.Begin(GL_POLYGON); out.Vertex2f(sx1 - fx, sb); out.Vertex2f(sx1, sb); out.Vertex2f(sx1, st); out.Vertex2f(sx1 - fx, st); out.End();
+            out.Begin(GL_POLYGON); out.Vertex2f(sx0, st - fy); out.Vertex2f(sx1, st - fy); out.Vertex2f(sx1, st); out.Vertex2f(sx0, st); out.End();
+            out.Begin(GL_POLYGON); out.Vertex2f(sx0, sb); out.Vertex2f(sx1, sb); out.Vertex2f(sx1, sb + fy); out.Vertex2f(sx0, sb + fy); out.End();
+
+            out.Color4f(0.6f, 0.75f, 0.9f, 0.6f);
+            out.Begin(GL_POLYGON);
+            out.Vertex2f(sx0 + fx, sb + fy);
+            out.Vertex2f(sx1 - fx, sb + fy);
+            out.Vertex2f(sx1 - fx, st - fy);
+            out.Vertex2f(sx0 + fx, st - fy);
+            out.End();
         }
 
-        glDisable(GL_BLEND);
     }
 
     const float originalWidth = 1.7f;
+    GeometryBuffer geometry;    // built by Prepare()
 };
 
 
 class RightElevation {
 public:
+    // Tessellates the elevation and generates the roof tiles on first use;
+    // CPU only, so it can run on a pool thread
+    void Prepare() {
+        if (!body.Empty())
+            return;
+
+        build(body, details);
+        roofTiles.Prepare(sheetRoofTiling());
+    }
+
     void Draw() {
+        Prepare();
+
+        body.Draw();
+        roofTiles.Draw(sheetRoofTiling(), lodPixelsPerUnit());
+        details.Draw();
+
+        imLineWidth(1.0f);
+    }
+
+private:
+    // Walls and roof into 'body', drawn under the roof tiles; doors,
+    // windows, pipes, vents and outlines into 'details', drawn over them
+    static void build(GeometryBuffer& body, GeometryBuffer& details) {
         // Position the building relative to our drawing area
-        float offsetX = 35.0f;
-        float offsetY = 0.0f;
+        float offsetX = kOffsetX;
+        float offsetY = kOffsetY;
 
         // Main building dimensions
-        float width = 27.5f;    // overall width
-        float height = 7.0f;    // wall height
-        float roofH = 5.0f;     // roof height
+        float width = kWidth;   // overall width
+        float height = kHeight; // wall height
+        float roofH = kRoofH;   // roof height
 
         // Calculate the four corners of our building
         float leftX = offsetX - width / 2.0f;
@@ -1610,113 +1687,38 @@ public:
         const float ventR = 0.65f, ventG = 0.65f, ventB = 0.66f;  // metallic grey for vents
 
         // Draw the main wall rectangle
-        glColor3f(wallR, wallG, wallB);
-        glBegin(GL_QUADS);
-        glVertex2f(leftX, baseY);
-        glVertex2f(rightX, baseY);
-        glVertex2f(rightX, topY);
-        glVertex2f(leftX, topY);
-        glEnd();
+        body.Color3f(wallR, wallG, wallB);
+        body.Begin(GL_QUADS);
+        body.Vertex2f(leftX, baseY);
+        body.Vertex2f(rightX, baseY);
+        body.Vertex2f(rightX, topY);
+        body.Vertex2f(leftX, topY);
+        body.End();
 
         // Add a thin decorative trim under the eaves
         float trimH = 0.5f;
-        glColor3f(0.78f, 0.60f, 0.58f);  // subtle contrast color
-        glBegin(GL_QUADS);
-        glVertex2f(leftX, topY - trimH * 0.5f);
-        glVertex2f(rightX, topY - trimH * 0.5f);
-        glVertex2f(rightX, topY + trimH * 0.5f);
-        glVertex2f(leftX, topY + trimH * 0.5f);
-        glEnd();
+        body.Color3f(0.78f, 0.60f, 0.58f);  // subtle contrast color
+        body.Begin(GL_QUADS);
+        body.Vertex2f(leftX, topY - trimH * 0.5f);
+        body.Vertex2f(rightX, topY - trimH * 0.5f);
+        body.Vertex2f(rightX, topY + trimH * 0.5f);
+        body.Vertex2f(leftX, topY + trimH * 0.5f);
+        body.End();
 
         // Draw the main roof shape as a trapezoid
-        glColor3f(0.95f, 0.55f, 0.55f);  // roof color
+        body.Color3f(0.95f, 0.55f, 0.55f);  // roof color
         float ridgeHalf = width * 0.20f;  // flat section at roof peak
         float ridgeY = topY + roofH;      // height of roof ridge
 
-        glBegin(GL_QUADS);
-        glVertex2f(leftX - 0.3f, topY);        // bottom left eave
-        glVertex2f(leftX + ridgeHalf, ridgeY); // ridge start
-        glVertex2f(rightX - ridgeHalf, ridgeY); // ridge end
-        glVertex2f(rightX + 0.3f, topY);       // bottom right eave
-        glEnd();
-
-        // Add texture to make the roof look tiled
-        glColor3f(0.6f, 0.25f, 0.25f); // darker color for tile lines
-        glLineWidth(1.0f);
-
-        // Tile spacing and roof boundaries
-        float tileRowSpacing = 0.3f;
-        float roofBaseY = topY;
-        float roofPeakY = ridgeY;
-
-        // Roof edge coordinates
-        float leftEaveX = leftX - 0.3f;
-        float rightEaveX = rightX + 0.3f;
-        float leftRidgeX = leftX + ridgeHalf;
-        float rightRidgeX = rightX - ridgeHalf;
-
-        // Draw horizontal tile lines across the roof
-        int row = 0;
-        for (float y = roofBaseY + tileRowSpacing; y < roofPeakY; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-
-            // Calculate where this tile row sits on the sloping roof
-            float leftXAtY = leftEaveX + (leftRidgeX - leftEaveX) * yProgress;
-            float rightXAtY = rightEaveX + (rightRidgeX - rightEaveX) * yProgress;
-
-            // Shadow under each tile row
-            glColor3f(0.65f, 0.35f, 0.35f);
-            glBegin(GL_LINES);
-            glVertex2f(leftXAtY, y - 0.03f);
-            glVertex2f(rightXAtY, y - 0.03f);
-            glEnd();
-
-            // Main tile separation line
-            glColor3f(0.75f, 0.45f, 0.45f);
-            glBegin(GL_LINES);
-            glVertex2f(leftXAtY, y);
-            glVertex2f(rightXAtY, y);
-            glEnd();
-        }
-
-        // Add vertical separators between tiles with staggered pattern
-        float tileWidth = 0.35f;
-        row = 0;
-        for (float y = roofBaseY + tileRowSpacing * 0.5f; y < roofPeakY - 0.1f; y += tileRowSpacing, row++) {
-            float yProgress = (y - roofBaseY) / (roofPeakY - roofBaseY);
-
-            // Current roof width at this height
-            float leftXAtY = leftEaveX + (leftRidgeX - leftEaveX) * yProgress;
-            float rightXAtY = rightEaveX + (rightRidgeX - rightEaveX) * yProgress;
-            float widthAtY = rightXAtY - leftXAtY;
-
-            // Offset every other row for realistic brick pattern
-            float offset = (row % 2 == 0) ? 0.0f : tileWidth * 0.5f;
-
-            // Draw the vertical tile separators
-            for (float x = leftXAtY + offset; x < rightXAtY; x += tileWidth) {
-                if (x > leftXAtY && x < rightXAtY) {
-                    float separatorHeight = tileRowSpacing * 0.6f;
-
-                    // Shadow line
-                    glColor3f(0.65f, 0.35f, 0.35f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x + 0.015f, y - separatorHeight * 0.5f);
-                    glVertex2f(x + 0.015f, y + separatorHeight * 0.5f);
-                    glEnd();
-
-                    // Main separator
-                    glColor3f(0.75f, 0.45f, 0.45f);
-                    glBegin(GL_LINES);
-                    glVertex2f(x, y - separatorHeight * 0.5f);
-                    glVertex2f(x, y + separatorHeight * 0.5f);
-                    glEnd();
-                }
-            }
-        }
+        body.Begin(GL_QUADS);
+        body.Vertex2f(leftX - 0.3f, topY);        // bottom left eave
+        body.Vertex2f(leftX + ridgeHalf, ridgeY); // ridge start
+        body.Vertex2f(rightX - ridgeHalf, ridgeY); // ridge end
+        body.Vertex2f(rightX + 0.3f, topY);       // bottom right eave
+        body.End();
 
         // Draw two tall glass doors on the left side
-        glColor3f(glassR, glassG, glassB);
+        details.Color3f(glassR, glassG, glassB);
         float doorW = width * 0.095f / 2;     // door panel width
         float doorH = height * 0.88f;         // door height
         float doorBase = baseY;
@@ -1727,16 +1729,16 @@ public:
             float x1 = startX + i * doorW;
             float x2 = x1 + doorW;
 
-            glBegin(GL_QUADS);
-            glVertex2f(x1, doorBase);
-            glVertex2f(x2, doorBase);
-            glVertex2f(x2, doorBase + doorH);
-            glVertex2f(x1, doorBase + doorH);
-            glEnd();
+            details.Begin(GL_QUADS);
+            details.Vertex2f(x1, doorBase);
+            details.Vertex2f(x2, doorBase);
+            details.Vertex2f(x2, doorBase + doorH);
+            details.Vertex2f(x1, doorBase + doorH);
+            details.End();
         }
 
         // Add five small square windows above the doors
-        glColor3f(glassR, glassG, glassB);
+        details.Color3f(glassR, glassG, glassB);
         float winSize = height * 0.18f;      // window size
         float winGap = width * 0.017f;       // spacing between windows
         float winStart = startX + 2.0f * doorW + width * 0.04f; // position
@@ -1748,16 +1750,16 @@ public:
             float y1 = winY;
             float y2 = y1 + winSize;
 
-            glBegin(GL_QUADS);
-            glVertex2f(x1, y1);
-            glVertex2f(x2, y1);
-            glVertex2f(x2, y2);
-            glVertex2f(x1, y2);
-            glEnd();
+            details.Begin(GL_QUADS);
+            details.Vertex2f(x1, y1);
+            details.Vertex2f(x2, y1);
+            details.Vertex2f(x2, y2);
+            details.Vertex2f(x1, y2);
+            details.End();
         }
 
         // Draw the rainwater collection system
-        glColor3f(0.25f, 0.25f, 0.28f); // dark grey for pipes
+        details.Color3f(0.25f, 0.25f, 0.28f); // dark grey for pipes
 
         float pipeW = 0.35f;     // pipe width
         float pipeH = 6.0f;     // pipe height
@@ -1779,40 +1781,40 @@ public:
         float boxX2 = boxX1 + boxW;
 
         // Box fill
-        glColor3f(0.45f, 0.45f, 0.48f);
-        glBegin(GL_QUADS);
-        glVertex2f(boxX1, boxY1);
-        glVertex2f(boxX2, boxY1);
-        glVertex2f(boxX2, boxY2);
-        glVertex2f(boxX1, boxY2);
-        glEnd();
+        details.Color3f(0.45f, 0.45f, 0.48f);
+        details.Begin(GL_QUADS);
+        details.Vertex2f(boxX1, boxY1);
+        details.Vertex2f(boxX2, boxY1);
+        details.Vertex2f(boxX2, boxY2);
+        details.Vertex2f(boxX1, boxY2);
+        details.End();
 
         // Box outline
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(boxX1, boxY1);
-        glVertex2f(boxX2, boxY1);
-        glVertex2f(boxX2, boxY2);
-        glVertex2f(boxX1, boxY2);
-        glEnd();
+        details.Color3f(0.0f, 0.0f, 0.0f);
+        details.Begin(GL_LINE_LOOP);
+        details.Vertex2f(boxX1, boxY1);
+        details.Vertex2f(boxX2, boxY1);
+        details.Vertex2f(boxX2, boxY2);
+        details.Vertex2f(boxX1, boxY2);
+        details.End();
 
         // Draw the downpipe
-        glColor3f(0.6f, 0.6f, 0.65f);
-        glBegin(GL_QUADS);
-        glVertex2f(px, py1);
-        glVertex2f(px + pipeW, py1);
-        glVertex2f(px + pipeW, py2);
-        glVertex2f(px, py2);
-        glEnd();
+        details.Color3f(0.6f, 0.6f, 0.65f);
+        details.Begin(GL_QUADS);
+        details.Vertex2f(px, py1);
+        details.Vertex2f(px + pipeW, py1);
+        details.Vertex2f(px + pipeW, py2);
+        details.Vertex2f(px, py2);
+        details.End();
 
         // Pipe outline
-        glColor3f(0.0f, 0.0f, 0.0f);
-        glBegin(GL_LINE_LOOP);
-        glVertex2f(px, py1);
-        glVertex2f(px + pipeW, py1);
-        glVertex2f(px + pipeW, py2);
-        glVertex2f(px, py2);
-        glEnd();
+        details.Color3f(0.0f, 0.0f, 0.0f);
+        details.Begin(GL_LINE_LOOP);
+        details.Vertex2f(px, py1);
+        details.Vertex2f(px + pipeW, py1);
+        details.Vertex2f(px + pipeW, py2);
+        details.Vertex2f(px, py2);
+        details.End();
 
         // Add three extractor vents along the roof ridge
         float ventW = 0.55f;       // vent width
@@ -1828,73 +1830,74 @@ public:
             float baseY2 = baseY1 + ventH;
 
             // Vent body
-            glColor3f(0.6f, 0.6f, 0.65f);
-            glBegin(GL_QUADS);
-            glVertex2f(baseX1, baseY1);
-            glVertex2f(baseX2, baseY1);
-            glVertex2f(baseX2, baseY2);
-            glVertex2f(baseX1, baseY2);
-            glEnd();
+            details.Color3f(0.6f, 0.6f, 0.65f);
+            details.Begin(GL_QUADS);
+            details.Vertex2f(baseX1, baseY1);
+            details.Vertex2f(baseX2, baseY1);
+            details.Vertex2f(baseX2, baseY2);
+            details.Vertex2f(baseX1, baseY2);
+            details.End();
 
             // Vent cap with overhang
-            glColor3f(0.55f, 0.55f, 0.60f);
-            glBegin(GL_QUADS);
-            glVertex2f(baseX1 - capOverhang, baseY2);
-            glVertex2f(baseX2 + capOverhang, baseY2);
-            glVertex2f(baseX2 + capOverhang, baseY2 + 0.35f);
-            glVertex2f(baseX1 - capOverhang, baseY2 + 0.35f);
-            glEnd();
+            details.Color3f(0.55f, 0.55f, 0.60f);
+            details.Begin(GL_QUADS);
+            details.Vertex2f(baseX1 - capOverhang, baseY2);
+            details.Vertex2f(baseX2 + capOverhang, baseY2);
+            details.Vertex2f(baseX2 + capOverhang, baseY2 + 0.35f);
+            details.Vertex2f(baseX1 - capOverhang, baseY2 + 0.35f);
+            details.End();
 
             // Outline the vent and cap
-            glColor3f(0.0f, 0.0f, 0.0f);
-            glLineWidth(1.0f);
-            glBegin(GL_LINES);
+            details.Color3f(0.0f, 0.0f, 0.0f);
+            details.LineWidth(1.0f);
+            details.Begin(GL_LINES);
 
             // Vent body outline
-            glVertex2f(baseX1, baseY1); glVertex2f(baseX2, baseY1);
-            glVertex2f(baseX2, baseY1); glVertex2f(baseX2, baseY2);
-            glVertex2f(baseX2, baseY2); glVertex2f(baseX1, baseY2);
-            glVertex2f(baseX1, baseY2); glVertex2f(baseX1, baseY1);
+            details.Vertex2f(baseX1, baseY1); details.Vertex2f(baseX2, baseY1);
+            details.Vertex2f(baseX2, baseY1); details.Vertex2f(baseX2, baseY2);
+            details.Vertex2f(baseX2, baseY2); details.Vertex2f(baseX1, baseY2);
+            details.Vertex2f(baseX1, baseY2); details.Vertex2f(baseX1, baseY1);
 
             // Cap outline
-            glVertex2f(baseX1 - capOverhang, baseY2);          glVertex2f(baseX2 + capOverhang, baseY2);
-            glVertex2f(baseX2 + capOverhang, baseY2);          glVertex2f(baseX2 + capOverhang, baseY2 + 0.35f);
-            glVertex2f(baseX2 + capOverhang, baseY2 + 0.35f);  glVertex2f(baseX1 - capOverhang, baseY2 + 0.35f);
-            glVertex2f(baseX1 - capOverhang, baseY2 + 0.35f);  glVertex2f(baseX1 - capOverhang, baseY2);
-            glEnd();
+            details.Vertex2f(baseX1 - capOverhang, baseY2);          details.Vertex2f(baseX2 + capOverhang, baseY2);
+            details.Vertex2f(baseX2 + capOverhang, baseY2);          details.Vertex2f(baseX2 + capOverhang, baseY2 + 0.35f);
+            details.Vertex2f(baseX2 + capOverhang, baseY2 + 0.35f);  details.Vertex2f(baseX1 - capOverhang, baseY2 + 0.35f);
+            details.Vertex2f(baseX1 - capOverhang, baseY2 + 0.35f);  details.Vertex2f(baseX1 - capOverhang, baseY2);
+            details.End();
         }
 
         // Draw all the outline details
-        glColor3f(outlineR, outlineG, outlineB);
-        glLineWidth(1.0f);
-        glBegin(GL_LINES);
+        details.Color3f(outlineR, outlineG, outlineB);
+        details.LineWidth(1.0f);
+        details.Begin(GL_LINES);
 
         // Outline the two doors
         float x1 = startX;
         float x2 = x1 + doorW;
 
         // Left door outline
-        glVertex2f(x1, doorBase);
-        glVertex2f(x2, doorBase);
-        glVertex2f(x2, doorBase);
-        glVertex2f(x2, doorBase + doorH);
-        glVertex2f(x2, doorBase + doorH);
-        glVertex2f(x1, doorBase + doorH);
-        glVertex2f(x1, doorBase + doorH);
-        glVertex2f(x1, doorBase);
+        details.Vertex2f(x1, doorBase);
+        details.Vertex2f(x2, doorBase);
+        details.Vertex2f(x2, doorBase);
+        details.Vertex2f(x2, doorBase + doorH);
+        details.Vertex2f(x2, doorBase + doorH);
+        details.Vertex2f(x1, doorBase + doorH);
+        details.Vertex2f(x1, doorBase + doorH);
+        details.Vertex2f(x1, doorBase);
 
         // Right door outline
         x1 = startX + doorW;
         x2 = x1 + doorW;
 
-        glVertex2f(x1, doorBase);
-        glVertex2f(x2, doorBase);
-        glVertex2f(x2, doorBase);
-        glVertex2f(x2, doorBase + doorH);
-        glVertex2f(x2, doorBase + doorH);
-        glVertex2f(x1, doorBase + doorH);
-        glVertex2f(x1, doorBase + doorH);
-        glVertex2f(x1, doorBase);
+        details.Vertex2f(x1, doorBase);
+        details.Vertex2f(x2, doorBase);
+        details.Vertex2f(x2, doorBase);
+        details.Vertex2f(x2, doorBase + doorH);
+        details.Vertex2f(x2, doorBase + doorH);
+        details.Vertex2f(x1, doorBase + doorH);
+        details.Vertex2f(x1, doorBase + doorH);
+        details.Vertex2f(x1, doorBase);
+        details.End();
 
         // Add door handles
         float handleY1 = baseY + height * 0.45f;
@@ -1904,42 +1907,42 @@ public:
         float handleX1_right = startX + doorW + doorW * 0.2f;
         float handleX2_right = handleX1_right + 0.1f;
 
-        drawRectangle(handleX1_left, handleY1, handleX2_left, handleY2, 0.3f, 0.3f, 0.3f);
-        drawRectangle(handleX1_right, handleY1, handleX2_right, handleY2, 0.3f, 0.3f, 0.3f);
+        drawRectangle(details, handleX1_left, handleY1, handleX2_left, handleY2, 0.3f, 0.3f, 0.3f);
+        drawRectangle(details, handleX1_right, handleY1, handleX2_right, handleY2, 0.3f, 0.3f, 0.3f);
 
         // Left handle fill
-        glColor3f(0.3f, 0.3f, 0.3f);
-        glBegin(GL_QUADS);
-        glVertex2f(handleX1_left, handleY1);
-        glVertex2f(handleX2_left, handleY1);
-        glVertex2f(handleX2_left, handleY2);
-        glVertex2f(handleX1_left, handleY2);
-        glEnd();
+        details.Color3f(0.3f, 0.3f, 0.3f);
+        details.Begin(GL_QUADS);
+        details.Vertex2f(handleX1_left, handleY1);
+        details.Vertex2f(handleX2_left, handleY1);
+        details.Vertex2f(handleX2_left, handleY2);
+        details.Vertex2f(handleX1_left, handleY2);
+        details.End();
 
         // Switch to thinner lines for fine details
-        glLineWidth(0.25f);
-        glColor3f(outlineR, outlineG, outlineB);
-        glBegin(GL_LINES);
+        details.LineWidth(0.25f);
+        details.Color3f(outlineR, outlineG, outlineB);
+        details.Begin(GL_LINES);
 
         // Building foundation and walls
-        glVertex2f(leftX, baseY);
-        glVertex2f(rightX, baseY);
-        glVertex2f(rightX, baseY);
-        glVertex2f(rightX, topY);
-        glVertex2f(leftX, baseY);
-        glVertex2f(leftX, topY);
+        details.Vertex2f(leftX, baseY);
+        details.Vertex2f(rightX, baseY);
+        details.Vertex2f(rightX, baseY);
+        details.Vertex2f(rightX, topY);
+        details.Vertex2f(leftX, baseY);
+        details.Vertex2f(leftX, topY);
 
         // Roof edges
-        glVertex2f(leftX - 0.3f, topY);
-        glVertex2f(leftX + ridgeHalf, ridgeY);
-        glVertex2f(rightX + 0.3f, topY);
-        glVertex2f(rightX - ridgeHalf, ridgeY);
-        glVertex2f(leftX + ridgeHalf, ridgeY);
-        glVertex2f(rightX - ridgeHalf, ridgeY);
+        details.Vertex2f(leftX - 0.3f, topY);
+        details.Vertex2f(leftX + ridgeHalf, ridgeY);
+        details.Vertex2f(rightX + 0.3f, topY);
+        details.Vertex2f(rightX - ridgeHalf, ridgeY);
+        details.Vertex2f(leftX + ridgeHalf, ridgeY);
+        details.Vertex2f(rightX - ridgeHalf, ridgeY);
 
         // Eaves trim
-        glVertex2f(leftX - 0.3f, topY);
-        glVertex2f(rightX + 0.3f, topY);
+        details.Vertex2f(leftX - 0.3f, topY);
+        details.Vertex2f(rightX + 0.3f, topY);
 
         // Window frames and muntins (crossbars)
         for (int i = 0; i < 5; ++i) {
@@ -1949,39 +1952,163 @@ public:
             float y2 = y1 + winSize;
 
             // Window frame
-            glVertex2f(x1, y1);
-            glVertex2f(x2, y1);
-            glVertex2f(x2, y1);
-            glVertex2f(x2, y2);
-            glVertex2f(x2, y2);
-            glVertex2f(x1, y2);
-            glVertex2f(x1, y2);
-            glVertex2f(x1, y1);
+            details.Vertex2f(x1, y1);
+            details.Vertex2f(x2, y1);
+            details.Vertex2f(x2, y1);
+            details.Vertex2f(x2, y2);
+            details.Vertex2f(x2, y2);
+            details.Vertex2f(x1, y2);
+            details.Vertex2f(x1, y2);
+            details.Vertex2f(x1, y1);
 
 
             // Diagonal cross (X pattern)
-            glVertex2f(x1, y1);
-            glVertex2f(x2, y2);
-            glVertex2f(x2, y1);
-            glVertex2f(x1, y2);
+            details.Vertex2f(x1, y1);
+            details.Vertex2f(x2, y2);
+            details.Vertex2f(x2, y1);
+            details.Vertex2f(x1, y2);
 
             // Center V pattern
             float cx = (x1 + x2) * 0.5f;
-            glVertex2f(x1 + 0.12f, y2 - 0.12f);
-            glVertex2f(cx, y1 + 0.04f);
-            glVertex2f(x2 - 0.12f, y2 - 0.12f);
-            glVertex2f(cx, y1 + 0.04f);
+            details.Vertex2f(x1 + 0.12f, y2 - 0.12f);
+            details.Vertex2f(cx, y1 + 0.04f);
+            details.Vertex2f(x2 - 0.12f, y2 - 0.12f);
+            details.Vertex2f(cx, y1 + 0.04f);
         }
-        glEnd();
+        details.End();
 
-        glLineWidth(1.0f);
     }
+
+    static constexpr float kOffsetX = 35.0f;
+    static constexpr float kOffsetY = 0.0f;
+    static constexpr float kWidth = 27.5f;
+    static constexpr float kHeight = 7.0f;
+    static constexpr float kRoofH = 5.0f;
+
+    // Tiling of the roof trapezoid between the eaves at topY and the ridge
+    static RoofTiling roofTiling(float leftX, float rightX, float topY, float ridgeY, float ridgeHalf) {
+        return {
+            topY, ridgeY,
+            leftX - 0.3f, rightX + 0.3f,        // eaves
+            leftX + ridgeHalf, rightX - ridgeHalf, // ridge
+            0.3f, 0.35f,                        // course spacing, tile width
+            0.0f, 0.0f, 0.1f,                   // inset, course and separator stops
+            0.03f, 0.015f                       // shadow offsets
+        };
+    }
+
+    static RoofTiling sheetRoofTiling() {
+        float leftX = kOffsetX - kWidth / 2.0f;
+        float rightX = kOffsetX + kWidth / 2.0f;
+        float topY = kOffsetY + kHeight;
+        return roofTiling(leftX, rightX, topY, topY + kRoofH, kWidth * 0.20f);
+    }
+
+    GeometryBuffer body;        // built by Prepare()
+    GeometryBuffer details;
+    RoofTiles roofTiles;
+};
+
+
+// ------------------ Sheet ------------------
+
+static void printCleanupStats(const LineCleanupStats& cleanup) {
+    if (cleanup.segmentsIn == 0)
+        return;
+    std::printf("plan: %zu wall segments -> %zu (%zu zero-length, %zu hidden), "
+        "%lld vertices removed, %zu after welding\n",
+        cleanup.segmentsIn, cleanup.segmentsOut, cleanup.zeroLength, cleanup.hidden,
+        cleanup.VerticesRemoved(), cleanup.verticesOut);
+}
+
+// The floor plan's place on the sheet
+SheetView floorPlanView(FloorPlan& floor) {
+    return { "floor", 0.0f, 0.5f, 12.0f, [&floor] { floor.Draw(); }, [&floor](ThreadPool&) { floor.Prepare(); }, {} };
+}
+
+// A sheet of a batch: its own floor plan with the elevations every sheet shares
+class PlanSheet : public BatchSheet {
+public:
+    PlanSheet(const std::string& planPath, float wallWidth, const std::vector<SheetView>& elevations)
+        : floor(planPath, wallWidth) {
+        views.push_back(floorPlanView(floor));
+        views.insert(views.end(), elevations.begin(), elevations.end());
+    }
+
+    bool Prepare() override {
+        floor.Prepare();
+        return floor.Loaded();
+    }
+
+    const std::vector<SheetView>& Views() const override { return views; }
+
+private:
+    FloorPlan floor;
+    std::vector<SheetView> views;
 };
 
 
 // ------------------ MAIN ------------------
-int main(void)
+int main(int argc, char** argv)
 {
+    CommandLine options;
+    if (!parseCommandLine(argc, argv, options))
+        return -1;
+    cullingEnabled = options.culling;
+
+    if (options.mode == RunMode::CheckKernels)
+        return checkTransformKernel(options.checkTrials, options.checkSeed, stdout) ? 0 : -1;
+
+    // Create objects
+    FloorPlan floor(options.planPath, options.wallWidth);
+    FrontElevation front;
+    RearElevation rear;
+    LeftElevation left;
+    RightElevation right;
+
+    // Every drawing on the sheet with the camera that frames it
+    std::vector<SheetView> views = {
+        floorPlanView(floor),
+        { "front", 0.0f, -42.6f, 19.0f, [&] { front.Draw(); }, [&](ThreadPool& pool) { front.Prepare(pool); }, {} },
+        { "rear", 0.0f, 48.0f, 17.0f, [&] { rear.Draw(); }, [&](ThreadPool&) { rear.Prepare(); }, {} },
+        { "left", -45.0f, 0.0f, 13.0f, [&] { left.Draw(); }, [&](ThreadPool&) { left.Prepare(); }, {} },
+        { "right", 35.0f, 6.7f, 15.0f, [&] { right.Draw(); }, [&](ThreadPool&) { right.Prepare(); }, {} },
+    };
+
+    // Generate every view's geometry in parallel up front; the GL thread
+    // then only uploads and draws
+    ThreadPool pool(options.threads);
+
+    if (options.mode == RunMode::Batch) {
+        // The elevations are generated once and drawn on every sheet; each
+        // sheet brings its own floor plan
+        std::vector<SheetView> elevations(views.begin() + 1, views.end());
+        prepareSheetViews(elevations, pool);
+        for (SheetView& view : elevations)
+            view.prepare = nullptr;
+        return runBatch(options, [&elevations, &options](const std::string& planPath) {
+            return std::unique_ptr<BatchSheet>(new PlanSheet(planPath, options.wallWidth, elevations));
+        }, pool);
+    }
+
+    prepareSheetViews(views, pool);
+
+    // An image or timing of an empty plan is no use; the reason is already on stderr
+    bool offscreen = options.mode == RunMode::Headless || options.mode == RunMode::Benchmark;
+    if (offscreen && !floor.Loaded()) {
+        std::fprintf(stderr, "could not load %s\n", options.planPath.c_str());
+        return -1;
+    }
+
+    // The benchmark keeps stdout for its CSV, and batch sheets would each repeat it
+    if (options.mode != RunMode::Benchmark)
+        printCleanupStats(floor.CleanupStats());
+
+    if (options.mode == RunMode::Headless)
+        return runHeadless(options, views, pool);
+    if (options.mode == RunMode::Benchmark)
+        return runBenchmark(options, views, pool);
+
     GLFWwindow* window;
 
     if (!glfwInit())
@@ -1998,50 +2125,196 @@ int main(void)
 
     glfwMakeContextCurrent(window);
 
-    // Create objects
-    FloorPlan floor;
-    FrontElevation front;
-    RearElevation rear;
-    LeftElevation left;
-    RightElevation right;
+    // Per-view GL counters: F3 toggles the overlay, --stats-log records every frame
+    FrameStats frameStats;
+    FrameStatsLog statsLog;
+    if (!options.statsLogPath.empty() && !statsLog.Open(options.statsLogPath))
+    {
+        glfwTerminate();
+        return -1;
+    }
+    bool showOverlay = options.overlay;
+    bool overlayKeyDown = false;
+    long long frame = 0;
+
+    // Nothing on the sheet moves by itself, so the views are only redrawn when
+    // the camera or the window size changes. Any other repaint (an expose or an
+    // overlay toggle) puts the cached frame back, and while no control key is
+    // held the loop sleeps in glfwWaitEvents instead of spinning.
+    FrameCache frameCache;
+    bool refreshRequested = true;
+    glfwSetWindowUserPointer(window, &refreshRequested);
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) {
+        *(bool*)glfwGetWindowUserPointer(w) = true;
+    });
+
+    // With --tiles the frame is assembled from cached tiles; missing ones are
+    // rendered a few per frame and the loop keeps polling until they are done
+    TileCache tileCache((size_t)options.tileBudgetMB * 1024 * 1024);
+    const int tilesPerFrame = 4;
+    bool tilesPending = false;
+
+    // With --pipeline the views are culled and drawn on worker threads while
+    // this thread keeps sampling input; see FramePipeline
+    // Hovering a wall, door or fixture of the floor plan outlines it and
+    // names it in the bottom-left corner; a click keeps it selected (and
+    // prints it) until something else is clicked. The pick comes from the
+    // plan's spatial index, and a change of pick only repaints the cached
+    // frame with the highlight on top.
+    auto drawPickOverlay = [&floor](const PlanPick& pick, int width, int height) {
+        floor.DrawHighlight(pick);
+        char label[96];
+        floor.Describe(pick, label, sizeof(label));
+        drawOverlayLabel(label, width, height);
+    };
+    PlanPick selected, lastPick;
+    bool clickDown = false;
+
+    std::unique_ptr<FramePipeline> pipeline;
+    if (options.pipeline)
+        pipeline.reset(new FramePipeline(window, views, statsLog, drawPickOverlay));
+
+    bool rendered = false;
+    float lastZoom = 0.0f;
+    double lastScrollX = 0.0, lastScrollY = 0.0;
+    int lastWidth = 0, lastHeight = 0;
 
     while (!glfwWindowShouldClose(window))
     {
+        frameArena.Reset();
+
         // --- Controls ---
-        if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)  scrollX -= 0.1f;
-        if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) scrollX += 0.1f;
-        if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)    scrollY += 0.1f;
-        if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)  scrollY -= 0.1f;
+        bool moving = false;
+        if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)  { scrollX -= 0.1f; moving = true; }
+        if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) { scrollX += 0.1f; moving = true; }
+        if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)    { scrollY += 0.1f; moving = true; }
+        if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)  { scrollY -= 0.1f; moving = true; }
 
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) zoomLevel -= 0.1f;
-        if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS) zoomLevel += 0.1f;
+        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) { zoomLevel -= 0.1f; moving = true; }
+        if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS) { zoomLevel += 0.1f; moving = true; }
 
         if (zoomLevel < 5.0f) zoomLevel = 5.0f;
         if (zoomLevel > 200.0f) zoomLevel = 200.0f;
 
-        glClear(GL_COLOR_BUFFER_BIT);
+        bool overlayKey = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+        bool overlayToggled = overlayKey && !overlayKeyDown;
+        if (overlayToggled) showOverlay = !showOverlay;
+        overlayKeyDown = overlayKey;
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+
+        // --- Picking ---
+        double cursorX, cursorY;
+        int windowWidth, windowHeight;
+        glfwGetCursorPos(window, &cursorX, &cursorY);
+        glfwGetWindowSize(window, &windowWidth, &windowHeight);
+        WorldPoint cursor = cursorToWorld(cursorX, cursorY, windowWidth, windowHeight, zoomLevel, scrollX, scrollY);
+        PlanPick hovered = floor.Pick(cursor.x, cursor.y, pickRadius(kPickPixels, zoomLevel, windowWidth, windowHeight));
+
+        bool click = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+        if (click && !clickDown)
+        {
+            selected = hovered;
+            if (selected.kind != PickKind::None)
+            {
+                char label[96];
+                floor.Describe(selected, label, sizeof(label));
+                std::printf("picked: %s\n", label);
+            }
+        }
+        clickDown = click;
+
+        PlanPick pick = (hovered.kind != PickKind::None) ? hovered : selected;
+        bool pickChanged = pick != lastPick;
+        lastPick = pick;
+
+        bool sceneChanged = options.continuous || !rendered || tilesPending ||
+            zoomLevel != lastZoom || scrollX != lastScrollX || scrollY != lastScrollY ||
+            width != lastWidth || height != lastHeight;
+
+        if (pipeline && (sceneChanged || refreshRequested || overlayToggled || pickChanged))
+        {
+            FrameInput input = { zoomLevel, scrollX, scrollY, width, height, showOverlay, pick };
+            if (!rendered)
+                pipeline->Start(input);
+            else
+                pipeline->Submit(input);
+
+            rendered = true;
+            lastZoom = zoomLevel;
+            lastScrollX = scrollX;
+            lastScrollY = scrollY;
+            lastWidth = width;
+            lastHeight = height;
+            refreshRequested = false;
+        }
+        else if (sceneChanged || refreshRequested || overlayToggled || pickChanged)
+        {
+            if (sceneChanged || !frameCache.Valid(width, height))
+            {
+                frameStats.Clear();
+                if (options.tiles)
+                {
+                    renderStats.Reset();
+                    tilesPending = !tileCache.Draw(views, zoomLevel, scrollX, scrollY, width, height, tilesPerFrame);
+                    frameStats.Record("tiles", renderStats);
+                }
+                else
+                {
+                    glViewport(0, 0, width, height);
+                    glClear(GL_COLOR_BUFFER_BIT);
+
+                    // Projection update
+                    loadSheetCamera(zoomLevel, scrollX, scrollY);
+
+                    // --- Draw All ---
+                    for (const SheetView& view : views)
+                    {
+                        renderStats.Reset();
+                        drawSheetView(view);
+                        frameStats.Record(view.name, renderStats);
+                    }
+                }
+                statsLog.Write(frame++, frameStats);
+
+                if (!options.continuous)
+                    frameCache.Capture(width, height);
 
-        // Projection update
-        glMatrixMode(GL_PROJECTION);
-        glLoadIdentity();
-        glOrtho(-zoomLevel + scrollX, zoomLevel + scrollX,
-            -zoomLevel + scrollY, zoomLevel + scrollY,
-            -1, 1);
+                rendered = true;
+                lastZoom = zoomLevel;
+                lastScrollX = scrollX;
+                lastScrollY = scrollY;
+                lastWidth = width;
+                lastHeight = height;
+            }
+            else
+            {
+                frameCache.Present();
+            }
 
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
+            if (pick.kind != PickKind::None)
+                drawPickOverlay(pick, width, height);
+            if (showOverlay)
+                drawFrameStatsOverlay(frameStats, width, height);
+            glfwSwapBuffers(window);
+            refreshRequested = false;
+        }
 
-        // --- Draw All ---
-        floor.Draw();
-        front.Draw();
-        rear.Draw();
-        left.Draw();
-        right.Draw();
+        if (pipeline && (moving || options.continuous))
+            glfwWaitEventsTimeout(1.0 / 120.0); // sample held keys at a fixed rate; the stages keep up or skip
+        else if (moving || options.continuous || tilesPending)
+            glfwPollEvents();
+        else
+            glfwWaitEvents();
+    }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    if (pipeline)
+    {
+        pipeline->Stop();
+        pipeline->PrintLatency(stdout);
     }
 
     glfwTerminate();
     return 0;
-}
\ No newline at end of file
+}
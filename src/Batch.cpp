@@ -0,0 +1,287 @@
+#include "Batch.h"
+#include "Headless.h"
+#include "ImageWriter.h"
+#include "VectorExport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// ------------------ Batch list ------------------
+
+static bool parseNumber(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+bool loadBatchList(const std::string& path, std::vector<BatchJob>& jobs) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "batch: could not open %s\n", path.c_str());
+        return false;
+    }
+
+    bool ok = true;
+    char text[1024];
+    for (int number = 1; std::fgets(text, sizeof(text), file); ++number) {
+        if (char* comment = std::strchr(text, '#'))
+            *comment = '\0';
+
+        char plan[512], preset[3][64], extra[2];
+        int fields = std::sscanf(text, "%511s %63s %63s %63s %1s", plan, preset[0], preset[1], preset[2], extra);
+        if (fields <= 0)
+            continue;   // blank or comment
+
+        BatchJob job;
+        job.planPath = plan;
+        job.line = number;
+        double zoom;
+        if (fields == 2) {
+            job.view = preset[0];
+        }
+        else if (fields == 4 && parseNumber(preset[0], zoom) && parseNumber(preset[1], job.scrollX) &&
+            parseNumber(preset[2], job.scrollY) && zoom > 0.0) {
+            job.customCamera = true;
+            job.zoom = (float)zoom;
+        }
+        else if (fields != 1) {
+            std::fprintf(stderr, "batch: %s:%d: expected SCENE [VIEW | ZOOM X Y]\n", path.c_str(), number);
+            ok = false;
+            continue;
+        }
+        jobs.push_back(job);
+    }
+    std::fclose(file);
+    return ok;
+}
+
+// File name of a scene path without its directory and extension
+static std::string sceneName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos && dot > 0)
+        name.erase(dot);
+    return name;
+}
+
+// ------------------ Bounded queue ------------------
+
+// Put() blocks while 'capacity' items are waiting and Take() while none
+// are. After Close(), Take() still hands out what is left, then returns false.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    void Put(T item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this] { return items.size() < capacity; });
+            items.push_back(std::move(item));
+        }
+        notEmpty.notify_one();
+    }
+
+    bool Take(T& out) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+            if (items.empty())
+                return false;
+            out = std::move(items.front());
+            items.pop_front();
+        }
+        notFull.notify_one();
+        return true;
+    }
+
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notEmpty.notify_all();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable notFull, notEmpty;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+};
+
+// ------------------ Batch ------------------
+
+struct PreparedSheet {
+    size_t job = 0;
+    std::unique_ptr<BatchSheet> sheet;
+    bool loaded = false;
+};
+
+struct PendingImage {
+    std::string path;
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+int runBatch(const CommandLine& options, const BatchSheetFactory& makeSheet, ThreadPool& pool) {
+    std::vector<BatchJob> jobs;
+    if (!loadBatchList(options.batchPath, jobs))
+        return -1;
+    if (jobs.empty()) {
+        std::fprintf(stderr, "batch: %s lists no sheets\n", options.batchPath.c_str());
+        return -1;
+    }
+
+    // Where the sheets are drawn: the exporter for vector formats,
+    // otherwise the --backend target
+    std::unique_ptr<VectorExporter> exporter;
+    std::unique_ptr<FrameTarget> target;
+    if (options.vectorExport) {
+        exporter.reset(new VectorExporter(options.width, options.height));
+        setRenderBackend(exporter.get());
+    }
+    else {
+        target = createFrameTarget(options, pool);
+        if (!target)
+            return -1;
+    }
+
+    int queueDepth = options.batchQueue > 0 ? options.batchQueue : pool.ThreadCount() + 1;
+    int loaderCount = std::min(pool.ThreadCount(), (int)jobs.size());
+    int writerCount = options.vectorExport ? 0 : std::max(1, pool.ThreadCount() / 4);
+
+    BoundedQueue<PreparedSheet> prepared((size_t)queueDepth);
+    BoundedQueue<PendingImage> toWrite((size_t)writerCount + 1);
+    std::atomic<size_t> nextJob{ 0 };
+    std::atomic<int> activeLoaders{ loaderCount };
+    std::atomic<int> failures{ 0 };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < loaderCount; ++i) {
+        threads.emplace_back([&] {
+            for (;;) {
+                size_t index = nextJob++;
+                if (index >= jobs.size())
+                    break;
+                PreparedSheet sheet;
+                sheet.job = index;
+                sheet.sheet = makeSheet(jobs[index].planPath);
+                sheet.loaded = sheet.sheet->Prepare();
+                prepared.Put(std::move(sheet));
+            }
+            if (--activeLoaders == 0)
+                prepared.Close();
+        });
+    }
+    for (int i = 0; i < writerCount; ++i) {
+        threads.emplace_back([&] {
+            PendingImage image;
+            while (toWrite.Take(image)) {
+                if (!writeImage(image.path, options.format, image.width, image.height, image.pixels.data())) {
+                    std::fprintf(stderr, "batch: could not write %s\n", image.path.c_str());
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    // Draw on this thread as the sheets come in, in whatever order they finish loading
+    typedef std::chrono::steady_clock Clock;
+    double waitingForLoaders = 0.0, waitingForWriters = 0.0;
+    int sheets = 0, files = 0;
+    PreparedSheet sheet;
+    for (;;) {
+        Clock::time_point waitStart = Clock::now();
+        bool more = prepared.Take(sheet);
+        waitingForLoaders += std::chrono::duration<double>(Clock::now() - waitStart).count();
+        if (!more)
+            break;
+
+        const BatchJob& job = jobs[sheet.job];
+        if (!sheet.loaded) {
+            std::fprintf(stderr, "batch: line %d: could not load %s\n", job.line, job.planPath.c_str());
+            ++failures;
+            continue;
+        }
+
+        CommandLine jobOptions = options;
+        jobOptions.view = job.view;
+        jobOptions.customCamera = job.customCamera;
+        jobOptions.zoom = job.zoom;
+        jobOptions.scrollX = job.scrollX;
+        jobOptions.scrollY = job.scrollY;
+        std::vector<RenderJob> renders = selectRenderJobs(jobOptions, sheet.sheet->Views());
+        if (renders.empty()) {
+            std::fprintf(stderr, "batch: line %d: unknown view '%s'\n", job.line, job.view.c_str());
+            ++failures;
+            continue;
+        }
+
+        // The line number keeps sheets of one scene (or of same-named scenes in
+        // different directories) from overwriting each other
+        std::string name = sceneName(job.planPath) + "-" + std::to_string(job.line);
+        for (const RenderJob& render : renders) {
+            std::string path = options.outputDir + "/" + name + "-" + render.name + "." +
+                (options.vectorExport ? vectorExtension(options.vectorFormat) : imageExtension(options.format));
+            ++files;
+
+            if (exporter) {
+                if (!exportVectorFile(*exporter, render, options.vectorFormat, path))
+                    ++failures;
+                continue;
+            }
+
+            target->BeginFrame();
+            loadSheetCamera(render.zoom, render.scrollX, render.scrollY);
+            for (const SheetView* view : render.drawList)
+                drawSheetView(*view);
+
+            PendingImage image;
+            image.path = path;
+            image.width = target->Width();
+            image.height = target->Height();
+            target->ReadPixels(image.pixels);
+
+            waitStart = Clock::now();
+            toWrite.Put(std::move(image));
+            waitingForWriters += std::chrono::duration<double>(Clock::now() - waitStart).count();
+        }
+        ++sheets;
+
+        // The sheet's buffers may hold GL objects, so it goes on this thread
+        sheet.sheet.reset();
+    }
+
+    toWrite.Close();
+    for (std::thread& thread : threads)
+        thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (exporter)
+        setRenderBackend(nullptr);
+
+    auto share = [seconds](double part) { return seconds > 0.0 ? 100.0 * part / seconds : 0.0; };
+    std::printf("batch: %d sheet(s), %d file(s) at %dx%d in %.3f s: %.2f sheets/s\n",
+        sheets, files, options.width, options.height, seconds, seconds > 0.0 ? sheets / seconds : 0.0);
+    std::printf("batch: drawing %.0f%%, waiting for loaders %.0f%%, waiting for writers %.0f%% "
+        "(%d loaders, %d writers, queue %d)\n",
+        share(seconds - waitingForLoaders - waitingForWriters), share(waitingForLoaders), share(waitingForWriters),
+        loaderCount, writerCount, queueDepth);
+    if (failures > 0)
+        std::fprintf(stderr, "batch: %d failure(s)\n", (int)failures);
+    return failures > 0 ? -1 : 0;
+}
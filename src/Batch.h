@@ -0,0 +1,66 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CommandLine.h"
+#include "SheetView.h"
+#include "ThreadPool.h"
+
+// ------------------ Batch rendering ------------------
+// Renders the sheets of many store layouts in one run. A batch list names
+// one sheet per line: a floor plan scene and, optionally, a camera preset.
+//
+//   # scene                     preset
+//   layouts/store-0142.plan                     whole sheet (the default)
+//   layouts/store-0143.plan     floor           a --view name, "sheet" or "all"
+//   layouts/store-0144.plan     20 5.5 -3       zoom and scroll, whole sheet
+//
+// Blank lines and everything after '#' are ignored; paths cannot contain
+// spaces. Each image or drawing file is written to --out as
+// <scene name>-<list line>-<view>.<format>, e.g. store-0143-3-floor.png.
+//
+// The elevations are the same on every sheet, so they are generated once
+// and shared; only the floor plan is loaded per sheet. Loading (parsing,
+// indexing, stamping fixtures) is CPU-only and runs on loader threads, one
+// per pool thread, which fill a bounded queue of prepared sheets: once
+// --queue sheets are waiting, the loaders block until the drawing thread
+// takes one. The calling thread draws each sheet (with --backend cpu the
+// rasterizer spreads every frame over the pool) and hands the pixels to
+// writer threads that encode and write the images, again through a bounded
+// queue. Vector files are streamed out while drawing.
+
+// One line of a batch list
+struct BatchJob {
+    std::string planPath;
+    std::string view = "sheet";
+    bool customCamera = false;
+    float zoom = 0.0f;
+    double scrollX = 0.0, scrollY = 0.0;
+    int line = 0;
+};
+
+// Reads a batch list. Returns false (after printing why) when the file
+// cannot be read or a line is not understood.
+bool loadBatchList(const std::string& path, std::vector<BatchJob>& jobs);
+
+// The drawings of one sheet of a batch and whatever they draw from
+class BatchSheet {
+public:
+    virtual ~BatchSheet() {}
+
+    // Loads the sheet's floor plan and generates its geometry. CPU only;
+    // runs on a loader thread. Returns false if the scene could not be loaded.
+    virtual bool Prepare() = 0;
+
+    virtual const std::vector<SheetView>& Views() const = 0;
+};
+
+// Creates the sheet for a floor plan scene; called on the loader threads
+typedef std::function<std::unique_ptr<BatchSheet>(const std::string& planPath)> BatchSheetFactory;
+
+// Renders every sheet of --batch and prints the throughput. Returns the
+// process exit code.
+int runBatch(const CommandLine& options, const BatchSheetFactory& makeSheet, ThreadPool& pool);
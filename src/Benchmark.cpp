@@ -0,0 +1,168 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "FrameArena.h"
+#include "Headless.h"
+#include "ImmediateMode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+struct BenchmarkResult {
+    std::string view;
+    int iterations;
+    double meanMs, p50Ms, p99Ms, maxMs;
+    double finishMs;            // mean wait for the target to complete a frame
+    long long allocations;      // heap allocations over all timed frames
+    RenderStats stats;
+};
+
+// Nearest-rank percentile of an ascending sample list
+static double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = (size_t)(p * sorted.size() + 0.999999);
+    rank = std::min(std::max(rank, (size_t)1), sorted.size());
+    return sorted[rank - 1];
+}
+
+static BenchmarkResult measure(FrameTarget& target, const RenderJob& job, int warmup, int iterations) {
+    auto drawFrame = [&]() {
+        for (const SheetView* view : job.drawList)
+            drawSheetView(*view);
+    };
+
+    // Warm-up frames build the retained buffers and caches
+    for (int i = 0; i < warmup; ++i) {
+        frameArena.Reset();
+        target.BeginFrame();
+        loadSheetCamera(job.zoom, job.scrollX, job.scrollY);
+        drawFrame();
+        target.Finish();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    double finishTotal = 0.0;
+    long long allocations = 0;
+    for (int i = 0; i < iterations; ++i) {
+        // Allocations are counted over the whole frame, the target's
+        // finish (the CPU rasterizer's pool tasks) included
+        long long allocationsBefore = heapAllocations();
+        frameArena.Reset();
+        target.BeginFrame();
+        loadSheetCamera(job.zoom, job.scrollX, job.scrollY);
+        renderStats.Reset();
+
+        // CPU time spent in the views' Draw(); the target drains outside the
+        // sample so one frame's queued work does not land in the next frame's
+        // time. The drain (glFinish, or the CPU rasterizer's whole raster
+        // pass) is timed on its own.
+        auto start = std::chrono::steady_clock::now();
+        drawFrame();
+        auto end = std::chrono::steady_clock::now();
+        target.Finish();
+        auto finished = std::chrono::steady_clock::now();
+        allocations += heapAllocations() - allocationsBefore;
+
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        finishTotal += std::chrono::duration<double, std::milli>(finished - end).count();
+    }
+
+    BenchmarkResult result;
+    result.view = job.name;
+    result.iterations = iterations;
+    result.allocations = allocations;
+
+    double total = 0.0;
+    for (double ms : samples)
+        total += ms;
+    std::sort(samples.begin(), samples.end());
+    result.meanMs = total / samples.size();
+    result.p50Ms = percentile(samples, 0.50);
+    result.p99Ms = percentile(samples, 0.99);
+    result.maxMs = samples.back();
+    result.finishMs = finishTotal / iterations;
+
+    // Counters of the last timed frame; every frame submits the same work
+    result.stats = renderStats;
+    return result;
+}
+
+static void writeCsv(std::FILE* file, const std::vector<BenchmarkResult>& results) {
+    std::fprintf(file, "view,iterations,mean_ms,p50_ms,p99_ms,max_ms,finish_ms,vertices,draw_calls,state_changes,line_width_switches,allocations\n");
+    for (const BenchmarkResult& r : results) {
+        std::fprintf(file, "%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%lld,%lld,%lld,%lld,%lld\n",
+            r.view.c_str(), r.iterations, r.meanMs, r.p50Ms, r.p99Ms, r.maxMs, r.finishMs,
+            r.stats.vertices, r.stats.drawCalls, r.stats.stateChanges, r.stats.lineWidthSwitches,
+            r.allocations);
+    }
+}
+
+static void writeJson(std::FILE* file, const CommandLine& options, const std::vector<BenchmarkResult>& results) {
+    std::fprintf(file, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"backend\": \"%s\",\n  \"software\": %s,\n  \"views\": [\n",
+        options.width, options.height, options.backend == Backend::CPU ? "cpu" : "gl", options.software ? "true" : "false");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        std::fprintf(file,
+            "    { \"view\": \"%s\", \"iterations\": %d, \"mean_ms\": %.4f, \"p50_ms\": %.4f, "
+            "\"p99_ms\": %.4f, \"max_ms\": %.4f, \"finish_ms\": %.4f, \"vertices\": %lld, \"draw_calls\": %lld, "
+            "\"state_changes\": %lld, \"line_width_switches\": %lld, \"allocations\": %lld }%s\n",
+            r.view.c_str(), r.iterations, r.meanMs, r.p50Ms, r.p99Ms, r.maxMs, r.finishMs,
+            r.stats.vertices, r.stats.drawCalls, r.stats.stateChanges, r.stats.lineWidthSwitches,
+            r.allocations, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+}
+
+int runBenchmark(const CommandLine& options, const std::vector<SheetView>& views, ThreadPool& pool) {
+    std::vector<RenderJob> jobs = selectRenderJobs(options, views);
+    if (jobs.empty()) {
+        std::fprintf(stderr, "benchmark: unknown view '%s'\n", options.view.c_str());
+        printUsage();
+        return -1;
+    }
+
+    std::unique_ptr<FrameTarget> target = createFrameTarget(options, pool);
+    if (!target)
+        return -1;
+
+    std::vector<BenchmarkResult> results;
+    for (const RenderJob& job : jobs)
+        results.push_back(measure(*target, job, options.warmup, options.iterations));
+
+    int exitCode = 0;
+    if (options.csvPath.empty()) {
+        writeCsv(stdout, results);
+    }
+    else if (std::FILE* file = std::fopen(options.csvPath.c_str(), "w")) {
+        writeCsv(file, results);
+        std::fclose(file);
+    }
+    else {
+        std::fprintf(stderr, "benchmark: could not write %s\n", options.csvPath.c_str());
+        exitCode = -1;
+    }
+
+    if (!options.jsonPath.empty()) {
+        if (std::FILE* file = std::fopen(options.jsonPath.c_str(), "w")) {
+            writeJson(file, options, results);
+            std::fclose(file);
+        }
+        else {
+            std::fprintf(stderr, "benchmark: could not write %s\n", options.jsonPath.c_str());
+            exitCode = -1;
+        }
+    }
+
+    if (options.expectNoAllocations) {
+        for (const BenchmarkResult& r : results) {
+            if (r.allocations != 0) {
+                std::fprintf(stderr, "benchmark: %s made %lld heap allocations in %d timed frames\n",
+                    r.view.c_str(), r.allocations, r.iterations);
+                exitCode = -1;
+            }
+        }
+    }
+    return exitCode;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+
+#include "CommandLine.h"
+#include "SheetView.h"
+#include "ThreadPool.h"
+
+// ------------------ Benchmark ------------------
+// Renders every selected view offscreen for a fixed number of frames and
+// reports the CPU time spent in Draw() (mean, p50, p99, max), the mean time
+// the target then needs to finish the frame (glFinish, or the CPU
+// rasterizer's raster pass), the GL counters (renderStats) of one frame and
+// the heap allocations made over the whole frame. Results go out as CSV (on
+// stdout unless --csv is given) and optionally as JSON. With --expect-no-allocs any allocation in a timed
+// frame fails the run.
+
+// Returns the process exit code
+int runBenchmark(const CommandLine& options, const std::vector<SheetView>& views, ThreadPool& pool);
@@ -0,0 +1,182 @@
+#include "CommandLine.h"
+
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: TestingOpenGL [--plan FILE] [--wall-width W] [--no-cull] [--threads N] [--continuous] [--pipeline]\n"
+        "                     [--tiles] [--tile-budget MB] [--overlay] [--stats-log FILE]\n"
+        "       TestingOpenGL [--headless | --benchmark] [--backend gl|cpu] [--software] [--size WxH] [--view NAME]\n"
+        "                     [--zoom Z] [--scroll X Y] [--format png|ppm|svg|pdf|dxf] [--out DIR]\n"
+        "                     [--iterations N] [--warmup N] [--csv FILE] [--json FILE]\n"
+        "                     [--expect-no-allocs]\n"
+        "       TestingOpenGL --batch FILE [--queue N] [--threads N] [--backend gl|cpu] [--software] [--size WxH]\n"
+        "                     [--format png|ppm|svg|pdf|dxf] [--out DIR]\n"
+        "       TestingOpenGL --check-kernels [N [SEED]]\n"
+        "  NAME: floor, front, rear, left, right, sheet or all\n");
+}
+
+// Whole decimal integer; false for empty text, trailing characters or overflow
+static bool parseInteger(const char* text, int& value) {
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX)
+        return false;
+    value = (int)parsed;
+    return true;
+}
+
+bool parseCommandLine(int argc, char** argv, CommandLine& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            options.mode = RunMode::Headless;
+        }
+        else if (std::strcmp(arg, "--benchmark") == 0) {
+            options.mode = RunMode::Benchmark;
+        }
+        else if (std::strcmp(arg, "--batch") == 0 && hasValue) {
+            options.mode = RunMode::Batch;
+            options.batchPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--queue") == 0 && hasValue) {
+            options.batchQueue = std::atoi(argv[++i]);
+            if (options.batchQueue <= 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--check-kernels") == 0) {
+            // Optional trial count and seed
+            options.mode = RunMode::CheckKernels;
+            if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0]))
+                options.checkTrials = std::atoi(argv[++i]);
+            if (i + 1 < argc && std::isdigit((unsigned char)argv[i + 1][0]))
+                options.checkSeed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(arg, "--plan") == 0 && hasValue) {
+            options.planPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--wall-width") == 0 && hasValue) {
+            options.wallWidth = (float)std::atof(argv[++i]);
+            if (!(options.wallWidth >= 0.0f)) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--no-cull") == 0) {
+            options.culling = false;
+        }
+        else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+            if (options.threads < 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--continuous") == 0) {
+            options.continuous = true;
+        }
+        else if (std::strcmp(arg, "--pipeline") == 0) {
+            options.pipeline = true;
+        }
+        else if (std::strcmp(arg, "--tiles") == 0) {
+            options.tiles = true;
+        }
+        else if (std::strcmp(arg, "--tile-budget") == 0 && hasValue) {
+            options.tileBudgetMB = std::atoi(argv[++i]);
+            if (options.tileBudgetMB <= 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--overlay") == 0) {
+            options.overlay = true;
+        }
+        else if (std::strcmp(arg, "--stats-log") == 0 && hasValue) {
+            options.statsLogPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--backend") == 0 && hasValue) {
+            const char* backend = argv[++i];
+            if (std::strcmp(backend, "gl") == 0) options.backend = Backend::OpenGL;
+            else if (std::strcmp(backend, "cpu") == 0) options.backend = Backend::CPU;
+            else {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--software") == 0) {
+            options.software = true;
+        }
+        else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--view") == 0 && hasValue) {
+            options.view = argv[++i];
+        }
+        else if (std::strcmp(arg, "--zoom") == 0 && hasValue) {
+            options.zoom = (float)std::atof(argv[++i]);
+            options.customCamera = true;
+        }
+        else if (std::strcmp(arg, "--scroll") == 0 && i + 2 < argc) {
+            options.scrollX = std::atof(argv[++i]);
+            options.scrollY = std::atof(argv[++i]);
+            options.customCamera = true;
+        }
+        else if (std::strcmp(arg, "--format") == 0 && hasValue) {
+            const char* format = argv[++i];
+            options.vectorExport = std::strcmp(format, "svg") == 0 || std::strcmp(format, "pdf") == 0 ||
+                std::strcmp(format, "dxf") == 0;
+            if (std::strcmp(format, "png") == 0) options.format = ImageFormat::PNG;
+            else if (std::strcmp(format, "ppm") == 0) options.format = ImageFormat::PPM;
+            else if (std::strcmp(format, "svg") == 0) options.vectorFormat = VectorFormat::SVG;
+            else if (std::strcmp(format, "pdf") == 0) options.vectorFormat = VectorFormat::PDF;
+            else if (std::strcmp(format, "dxf") == 0) options.vectorFormat = VectorFormat::DXF;
+            else {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--out") == 0 && hasValue) {
+            options.outputDir = argv[++i];
+        }
+        else if (std::strcmp(arg, "--iterations") == 0 && hasValue) {
+            if (!parseInteger(argv[++i], options.iterations) || options.iterations <= 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--warmup") == 0 && hasValue) {
+            if (!parseInteger(argv[++i], options.warmup) || options.warmup < 0) {
+                printUsage();
+                return false;
+            }
+        }
+        else if (std::strcmp(arg, "--csv") == 0 && hasValue) {
+            options.csvPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        }
+        else if (std::strcmp(arg, "--expect-no-allocs") == 0) {
+            options.expectNoAllocations = true;
+        }
+        else {
+            printUsage();
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+
+#include "ImageWriter.h"
+#include "VectorWriter.h"
+
+// ------------------ Command line ------------------
+// Without arguments the app opens the interactive fullscreen window.
+//
+//   --plan FILE                floor plan scene to load (default scenes/floorplan.plan)
+//   --wall-width W             stroke width of the floor plan's walls in plan units
+//                              (default 0.05); 0 draws them as hairlines
+//   --no-cull                  draw everything, even outside the camera window
+//   --threads N                geometry generation threads (default: one per hardware thread)
+//   --continuous               redraw every view each frame, even when nothing changed
+//   --pipeline                 cull and draw on worker threads, pipelined with input;
+//                              prints per-stage latency on exit (ignores --tiles)
+//   --tiles                    assemble frames from a cached tile pyramid of the sheet
+//   --tile-budget MB           texture memory for cached tiles (default 64)
+//
+//   --headless                 render offscreen and write one image (or drawing file) per view
+//   --benchmark                time each view's Draw() offscreen
+//   --batch FILE               render the sheets listed in FILE (see Batch.h), images or
+//                              drawing files per --format, and report sheets per second
+//   --check-kernels [N [SEED]] compare the SIMD transform kernel with its scalar reference
+//                              on N random cases (default 1000, seed 1); no window
+//
+// Instrumentation (interactive):
+//   --overlay                  start with the per-view GL counter overlay shown (F3 toggles)
+//   --stats-log FILE           append each frame's per-view GL counters to FILE as CSV
+//
+// Offscreen options (headless and benchmark):
+//   --backend gl|cpu           draw through OpenGL (default) or the tile-binned CPU
+//                              rasterizer, which needs no GL context, window or driver
+//   --software                 no display/GPU: GLFW null platform + OSMesa context
+//   --size WxH                 framebuffer resolution (default 1024x1024)
+//   --view NAME                floor, front, rear, left, right, sheet or all (default)
+//   --zoom Z --scroll X Y      fixed camera instead of each view's own framing
+//
+// Headless export:
+//   --format png|ppm|svg|pdf|dxf
+//                              output format (default png); the vector formats are drawn
+//                              by the export backend and need no GL context
+//   --out DIR                  output directory (default .)
+//
+// Batch:
+//   --queue N                  sheets loaded ahead of the one being drawn (default: threads + 1)
+//
+// Benchmark:
+//   --iterations N             timed frames per view (default 200)
+//   --warmup N                 untimed frames per view first (default 1)
+//   --csv FILE                 write results as CSV (default: CSV on stdout)
+//   --json FILE                write results as JSON
+//   --expect-no-allocs         fail (exit code -1) if a timed frame allocates from the heap
+
+enum class RunMode {
+    Interactive,
+    Headless,
+    Benchmark,
+    Batch,
+    CheckKernels
+};
+
+// What headless and benchmark frames are drawn with
+enum class Backend {
+    OpenGL,
+    CPU
+};
+
+struct CommandLine {
+    RunMode mode = RunMode::Interactive;
+    std::string planPath = "scenes/floorplan.plan";
+    float wallWidth = 0.05f;
+    bool culling = true;
+    int threads = 0;
+    bool continuous = false;
+    bool pipeline = false;
+    bool tiles = false;
+    int tileBudgetMB = 64;
+
+    // Instrumentation
+    bool overlay = false;
+    std::string statsLogPath;
+
+    // Offscreen rendering
+    Backend backend = Backend::OpenGL;
+    bool software = false;
+    int width = 1024;
+    int height = 1024;
+    std::string view = "all";
+    bool customCamera = false;
+    float zoom = 50.0f;
+    double scrollX = 0.0;
+    double scrollY = 0.0;
+
+    // Headless export
+    ImageFormat format = ImageFormat::PNG;
+    bool vectorExport = false;      // --format svg, pdf or dxf
+    VectorFormat vectorFormat = VectorFormat::SVG;
+    std::string outputDir = ".";
+
+    // Batch
+    std::string batchPath;
+    int batchQueue = 0;             // 0: pool threads + 1
+
+    // Benchmark
+    int iterations = 200;
+    int warmup = 1;
+    std::string csvPath;
+    std::string jsonPath;
+    bool expectNoAllocations = false;
+
+    // Kernel check
+    int checkTrials = 1000;
+    unsigned checkSeed = 1;
+};
+
+// Reads the options from the command line.
+// Returns false (after printing the usage) when an argument is not understood.
+bool parseCommandLine(int argc, char** argv, CommandLine& options);
+
+void printUsage();
@@ -0,0 +1,46 @@
+#include "Culling.h"
+#include "RenderBackend.h"
+
+static Bounds currentCamera;
+
+bool cullingEnabled = true;
+BoundsCapture boundsCapture;
+
+const Bounds& cameraBounds() {
+    return currentCamera;
+}
+
+void setCameraBounds(const Bounds& bounds) {
+    currentCamera = bounds;
+}
+
+bool isVisible(const Bounds& bounds) {
+    if (boundsCapture.active)
+        return true; // measuring: everything must be submitted
+    if (!cullingEnabled || !bounds.Valid() || !currentCamera.Valid())
+        return true;
+    return bounds.Intersects(currentCamera);
+}
+
+void BoundsCapture::LoadModelview() {
+    renderBackend().GetModelview(modelview);
+}
+
+void BoundsCapture::AddLocal(const Bounds& local) {
+    if (!local.Valid())
+        return;
+    AddVertex(local.minX, local.minY);
+    AddVertex(local.maxX, local.minY);
+    AddVertex(local.maxX, local.maxY);
+    AddVertex(local.minX, local.maxY);
+}
+
+void beginBoundsCapture() {
+    boundsCapture.active = true;
+    boundsCapture.bounds = Bounds();
+}
+
+Bounds endBoundsCapture() {
+    boundsCapture.active = false;
+    return boundsCapture.bounds;
+}
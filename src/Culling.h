@@ -0,0 +1,71 @@
+#pragma once
+
+// ------------------ Culling ------------------
+// Everything on the sheet is drawn under one glOrtho camera, so visibility
+// is a plain rectangle test in world space. Views and retained buffers carry
+// an axis-aligned bounding box and are skipped before any vertex is
+// submitted when their box misses the camera window. The boxes are floats
+// even on site-sized plans: a few centimetres of slack does not matter for
+// culling.
+
+struct Bounds {
+    float minX = 1e30f, minY = 1e30f;
+    float maxX = -1e30f, maxY = -1e30f;
+
+    bool Valid() const { return minX <= maxX && minY <= maxY; }
+
+    void Add(float x, float y) {
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+
+    void Add(const Bounds& other) {
+        if (other.Valid()) {
+            Add(other.minX, other.minY);
+            Add(other.maxX, other.maxY);
+        }
+    }
+
+    bool Intersects(const Bounds& other) const {
+        return minX <= other.maxX && other.minX <= maxX &&
+            minY <= other.maxY && other.minY <= maxY;
+    }
+};
+
+// World-space window of the camera last loaded with loadSheetCamera
+const Bounds& cameraBounds();
+void setCameraBounds(const Bounds& bounds);
+
+// Culling can be switched off (--no-cull) to compare frame costs
+extern bool cullingEnabled;
+
+// True when something with world-space 'bounds' may be visible. Invalid
+// (not yet measured) bounds are always drawn.
+bool isVisible(const Bounds& bounds);
+
+// ---- Bounds capture ----
+// While a capture is active every vertex submitted through the im* wrappers,
+// GeometryBuffer::Draw and LineBatch::Draw is transformed by the current
+// modelview matrix and added to the captured box. This is how a view learns
+// its extent the first time it is drawn, without hand-written boxes.
+
+struct BoundsCapture {
+    bool active = false;
+    Bounds bounds;
+    float modelview[16];    // column-major, refreshed on every imBegin / Draw
+
+    void LoadModelview();
+    void AddVertex(float x, float y) {
+        bounds.Add(modelview[0] * x + modelview[4] * y + modelview[12],
+            modelview[1] * x + modelview[5] * y + modelview[13]);
+    }
+    // Adds a local-space box, transformed (conservatively) to world space
+    void AddLocal(const Bounds& local);
+};
+
+extern BoundsCapture boundsCapture;
+
+void beginBoundsCapture();
+Bounds endBoundsCapture();
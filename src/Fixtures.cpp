@@ -0,0 +1,190 @@
+#include "Fixtures.h"
+#include "UnitCircle.h"
+
+void Toilet::Draw(GeometryBuffer& out, float x, float y, float orientation) {
+    // orientation: 0 = tank on right, 1 = tank on left, 2 = tank on top, 3 = tank on bottom
+
+    out.Begin(GL_LINES);
+    out.Color3f(1.0f, 1.0f, 1.0f); // White
+
+    float bowlRadius = 0.2f;
+    float innerRadius = 0.12f;
+    float tankSize = 0.15f; // Square tank
+
+    if (orientation == 0) { // Tank on right (default)
+        // Outer circle (bowl)
+        DrawCircle(out, x, y, bowlRadius, bowlSegments);
+
+        // Inner circle
+        DrawCircle(out, x, y, innerRadius, innerSegments);
+
+        // Tank (square on right)
+        float tankX = x + bowlRadius + tankSize / 2;
+        out.Vertex2f(tankX - tankSize / 2, y - tankSize / 2); out.Vertex2f(tankX + tankSize / 2, y - tankSize / 2);
+        out.Vertex2f(tankX + tankSize / 2, y - tankSize / 2); out.Vertex2f(tankX + tankSize / 2, y + tankSize / 2);
+        out.Vertex2f(tankX + tankSize / 2, y + tankSize / 2); out.Vertex2f(tankX - tankSize / 2, y + tankSize / 2);
+        out.Vertex2f(tankX - tankSize / 2, y + tankSize / 2); out.Vertex2f(tankX - tankSize / 2, y - tankSize / 2);
+
+    }
+    else if (orientation == 1) { // Tank on left
+        // Outer circle (bowl)
+        DrawCircle(out, x, y, bowlRadius, bowlSegments);
+
+        // Inner circle
+        DrawCircle(out, x, y, innerRadius, innerSegments);
+
+        // Tank (square on left)
+        float tankX = x - bowlRadius - tankSize / 2;
+        out.Vertex2f(tankX - tankSize / 2, y - tankSize / 2); out.Vertex2f(tankX + tankSize / 2, y - tankSize / 2);
+        out.Vertex2f(tankX + tankSize / 2, y - tankSize / 2); out.Vertex2f(tankX + tankSize / 2, y + tankSize / 2);
+        out.Vertex2f(tankX + tankSize / 2, y + tankSize / 2); out.Vertex2f(tankX - tankSize / 2, y + tankSize / 2);
+        out.Vertex2f(tankX - tankSize / 2, y + tankSize / 2); out.Vertex2f(tankX - tankSize / 2, y - tankSize / 2);
+
+    }
+    else if (orientation == 2) { // Tank on top
+        // Outer circle (bowl)
+        DrawCircle(out, x, y, bowlRadius, bowlSegments);
+
+        // Inner circle
+        DrawCircle(out, x, y, innerRadius, innerSegments);
+
+        // Tank (square on top)
+        float tankY = y + bowlRadius + tankSize / 2;
+        out.Vertex2f(x - tankSize / 2, tankY - tankSize / 2); out.Vertex2f(x + tankSize / 2, tankY - tankSize / 2);
+        out.Vertex2f(x + tankSize / 2, tankY - tankSize / 2); out.Vertex2f(x + tankSize / 2, tankY + tankSize / 2);
+        out.Vertex2f(x + tankSize / 2, tankY + tankSize / 2); out.Vertex2f(x - tankSize / 2, tankY + tankSize / 2);
+        out.Vertex2f(x - tankSize / 2, tankY + tankSize / 2); out.Vertex2f(x - tankSize / 2, tankY - tankSize / 2);
+
+    }
+    else if (orientation == 3) { // Tank on bottom
+        // Outer circle (bowl)
+        DrawCircle(out, x, y, bowlRadius, bowlSegments);
+
+        // Inner circle
+        DrawCircle(out, x, y, innerRadius, innerSegments);
+
+        // Tank (square on bottom)
+        float tankY = y - bowlRadius - tankSize / 2;
+        out.Vertex2f(x - tankSize / 2, tankY - tankSize / 2); out.Vertex2f(x + tankSize / 2, tankY - tankSize / 2);
+        out.Vertex2f(x + tankSize / 2, tankY - tankSize / 2); out.Vertex2f(x + tankSize / 2, tankY + tankSize / 2);
+        out.Vertex2f(x + tankSize / 2, tankY + tankSize / 2); out.Vertex2f(x - tankSize / 2, tankY + tankSize / 2);
+        out.Vertex2f(x - tankSize / 2, tankY + tankSize / 2); out.Vertex2f(x - tankSize / 2, tankY - tankSize / 2);
+    }
+
+    out.End();
+}
+
+void Toilet::DrawCircle(GeometryBuffer& out, float cx, float cy, float radius, int segments) {
+    ArcTable circle = unitCircle(segments);
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(circle, cx, cy, radius, radius, xs, ys);
+    for (int i = 0; i < circle.segments; i++) {
+        out.Vertex2f(xs[i], ys[i]);
+        out.Vertex2f(xs[i + 1], ys[i + 1]);
+    }
+}
+
+void FireExtinguisher::Draw(GeometryBuffer& out, float x, float y) {
+    out.Begin(GL_LINES);
+    out.Color3f(1.0f, 0.0f, 0.0f); // Red color for fire safety
+
+    // Main body (circle from top-down view)
+    float radius = 0.15f;
+
+    // Draw circle for extinguisher body
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(unitCircle(segments), x, y, radius, radius, xs, ys);
+    for (int i = 0; i < segments; i++) {
+        out.Vertex2f(xs[i], ys[i]);
+        out.Vertex2f(xs[i + 1], ys[i + 1]);
+    }
+
+    // Add "FE" text indicator (using lines)
+    // F shape
+    out.Vertex2f(x - radius * 0.3f, y + radius * 0.5f); out.Vertex2f(x - radius * 0.3f, y - radius * 0.5f);
+    out.Vertex2f(x - radius * 0.3f, y + radius * 0.5f); out.Vertex2f(x - radius * 0.1f, y + radius * 0.5f);
+    out.Vertex2f(x - radius * 0.3f, y); out.Vertex2f(x - radius * 0.1f, y);
+
+    // E shape  
+    out.Vertex2f(x + radius * 0.1f, y + radius * 0.5f); out.Vertex2f(x + radius * 0.1f, y - radius * 0.5f);
+    out.Vertex2f(x + radius * 0.1f, y + radius * 0.5f); out.Vertex2f(x + radius * 0.3f, y + radius * 0.5f);
+    out.Vertex2f(x + radius * 0.1f, y); out.Vertex2f(x + radius * 0.3f, y);
+    out.Vertex2f(x + radius * 0.1f, y - radius * 0.5f); out.Vertex2f(x + radius * 0.3f, y - radius * 0.5f);
+
+    out.End();
+}
+
+void DrawDoorArc(GeometryBuffer& out, float cx, float cy, float radius, float startAngle, float endAngle, int segments) {
+    ArcTable arc = unitArc(segments, startAngle, endAngle);
+    float xs[kMaxArcSegments + 1], ys[kMaxArcSegments + 1];
+    arcPoints(arc, cx, cy, radius, radius, xs, ys);
+    for (int i = 0; i < arc.segments; i++) {
+        out.Vertex2f(xs[i], ys[i]);
+        out.Vertex2f(xs[i + 1], ys[i + 1]);
+    }
+}
+
+void Bin::Draw(GeometryBuffer& out, float x, float y, float size) {
+    out.Begin(GL_LINES);
+    out.Color3f(0.6f, 0.6f, 0.6f); // Gray color for bins
+
+    float outerSize = size;
+    float innerSize = size * 0.6f; // Smaller inner square
+
+    // Outer square
+    out.Vertex2f(x - outerSize / 2, y - outerSize / 2); out.Vertex2f(x + outerSize / 2, y - outerSize / 2);
+    out.Vertex2f(x + outerSize / 2, y - outerSize / 2); out.Vertex2f(x + outerSize / 2, y + outerSize / 2);
+    out.Vertex2f(x + outerSize / 2, y + outerSize / 2); out.Vertex2f(x - outerSize / 2, y + outerSize / 2);
+    out.Vertex2f(x - outerSize / 2, y + outerSize / 2); out.Vertex2f(x - outerSize / 2, y - outerSize / 2);
+
+    // Inner square
+    out.Vertex2f(x - innerSize / 2, y - innerSize / 2); out.Vertex2f(x + innerSize / 2, y - innerSize / 2);
+    out.Vertex2f(x + innerSize / 2, y - innerSize / 2); out.Vertex2f(x + innerSize / 2, y + innerSize / 2);
+    out.Vertex2f(x + innerSize / 2, y + innerSize / 2); out.Vertex2f(x - innerSize / 2, y + innerSize / 2);
+    out.Vertex2f(x - innerSize / 2, y + innerSize / 2); out.Vertex2f(x - innerSize / 2, y - innerSize / 2);
+
+    out.End();
+}
+
+void DiningTable::Draw(GeometryBuffer& out, float x, float y) {
+    out.Begin(GL_LINES);
+    out.Color3f(1.0f, 1.0f, 1.0f);
+
+    float half = 0.5f;          // table half-size
+    float chairHalf = 0.2f;     // chair half-width along the table edge
+    float chairDepth = 0.4f;    // how far the chair sticks out
+
+    // Outward normals of the bottom, top, left and right sides
+    static const float normals[4][2] = { { 0.0f, -1.0f }, { 0.0f, 1.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f } };
+
+    // Each side: the table edge plus a chair open towards the table
+    for (const auto& normal : normals) {
+        float nx = normal[0], ny = normal[1];
+        float ex = ny * ny, ey = nx * nx; // edge direction
+
+        float cx = x + nx * half, cy = y + ny * half;
+        out.Vertex2f(cx - ex * half, cy - ey * half); out.Vertex2f(cx + ex * half, cy + ey * half);
+
+        float ax = cx - ex * chairHalf, ay = cy - ey * chairHalf;
+        float bx = cx + ex * chairHalf, by = cy + ey * chairHalf;
+        float dx = nx * chairDepth, dy = ny * chairDepth;
+        out.Vertex2f(ax, ay); out.Vertex2f(ax + dx, ay + dy);
+        out.Vertex2f(ax + dx, ay + dy); out.Vertex2f(bx + dx, by + dy);
+        out.Vertex2f(bx + dx, by + dy); out.Vertex2f(bx, by);
+    }
+
+    out.End();
+}
+
+void Chair::Draw(GeometryBuffer& out, float x, float y) {
+    out.Begin(GL_LINES);
+    out.Color3f(1.0f, 1.0f, 1.0f);
+
+    float half = 0.2f;
+    out.Vertex2f(x - half, y + half); out.Vertex2f(x + half, y + half);
+    out.Vertex2f(x - half, y - half); out.Vertex2f(x + half, y - half);
+    out.Vertex2f(x - half, y + half); out.Vertex2f(x - half, y - half);
+    out.Vertex2f(x + half, y + half); out.Vertex2f(x + half, y - half);
+
+    out.End();
+}
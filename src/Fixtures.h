@@ -0,0 +1,54 @@
+#pragma once
+
+#include "GeometryBuffer.h"
+
+// ------------------ Plan fixtures ------------------
+// Top-down symbols placed on the floor plan. Each one records its outline
+// as GL_LINES into the given buffer with its own colour.
+
+// Circle segment counts can be lowered for symbols that are drawn small
+
+class Toilet {
+public:
+    explicit Toilet(int bowlSegments = 16, int innerSegments = 12)
+        : bowlSegments(bowlSegments), innerSegments(innerSegments) {}
+
+    // orientation: 0 = tank on right, 1 = tank on left, 2 = tank on top, 3 = tank on bottom
+    void Draw(GeometryBuffer& out, float x, float y, float orientation = 0.0f);
+
+private:
+    void DrawCircle(GeometryBuffer& out, float cx, float cy, float radius, int segments);
+
+    int bowlSegments;
+    int innerSegments;
+};
+
+class FireExtinguisher {
+public:
+    explicit FireExtinguisher(int segments = 12) : segments(segments) {}
+
+    void Draw(GeometryBuffer& out, float x, float y);
+
+private:
+    int segments;
+};
+
+class Bin {
+public:
+    void Draw(GeometryBuffer& out, float x, float y, float size = 0.25f);
+};
+
+// 1 x 1 table centred on (x, y) with a chair against each side
+class DiningTable {
+public:
+    void Draw(GeometryBuffer& out, float x, float y);
+};
+
+// 0.4 x 0.4 chair block centred on (x, y)
+class Chair {
+public:
+    void Draw(GeometryBuffer& out, float x, float y);
+};
+
+// Swing arc of a door leaf hinged at (cx, cy); a negative radius mirrors it
+void DrawDoorArc(GeometryBuffer& out, float cx, float cy, float radius, float startAngle, float endAngle, int segments = 20);
@@ -0,0 +1,61 @@
+#include "FrameArena.h"
+
+#include <cstdlib>
+#include <new>
+
+FrameArena frameArena;
+
+FrameArena::FrameArena(size_t blockBytes) : blockBytes(blockBytes) {}
+
+FrameArena::~FrameArena() {
+    for (const Block& block : blocks)
+        std::free(block.data);
+}
+
+void FrameArena::AddBlock(size_t minimumBytes) {
+    size_t size = minimumBytes > blockBytes ? minimumBytes : blockBytes;
+    char* data = static_cast<char*>(std::malloc(size));
+    if (!data)
+        throw std::bad_alloc();
+    blocks.push_back({ data, size });
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment) {
+    if (blocks.empty())
+        AddBlock(bytes + alignment);
+
+    for (;;) {
+        const Block& block = blocks[current];
+        size_t address = (size_t)(block.data + offset);
+        size_t padding = (alignment - address % alignment) % alignment;
+        if (offset + padding + bytes <= block.size) {
+            offset += padding + bytes;
+            used += padding + bytes;
+            return block.data + offset - bytes;
+        }
+
+        // Move on to the next block, adding one if this was the last
+        used += block.size - offset;
+        ++current;
+        offset = 0;
+        if (current == blocks.size())
+            AddBlock(bytes + alignment);
+    }
+}
+
+void FrameArena::Reset() {
+    if (current > 0) {
+        // Last frame spilled into more blocks: replace them with one that
+        // holds the whole frame
+        size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.size;
+            std::free(block.data);
+        }
+        blocks.clear();
+        AddBlock(total);
+    }
+    current = 0;
+    offset = 0;
+    used = 0;
+}
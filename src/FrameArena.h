@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// ------------------ Frame arena ------------------
+// Bump allocator for scratch data that only lives until the end of the
+// frame. Allocating is a pointer increment and nothing is freed one by one:
+// Reset() at the top of the frame loop releases everything at once. When a
+// frame overflows the first block, Reset() replaces the blocks with a single
+// one big enough for the whole frame, so steady-state frames make no heap
+// allocations at all.
+//
+// The arena is not thread-safe; frameArena belongs to the thread running
+// the frame loop.
+
+class FrameArena {
+public:
+    explicit FrameArena(size_t blockBytes = 256 * 1024);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Releases every allocation made since the last Reset()
+    void Reset();
+
+    size_t BytesUsed() const { return used; }
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    void AddBlock(size_t minimumBytes);
+
+    std::vector<Block> blocks;
+    size_t blockBytes;
+    size_t current = 0;     // block being filled
+    size_t offset = 0;      // first free byte in that block
+    size_t used = 0;        // bytes handed out since Reset(), padding included
+};
+
+extern FrameArena frameArena;
+
+// Standard allocator over a FrameArena, so std::vector and friends can keep
+// per-frame scratch in it. deallocate() is a no-op; memory comes back on Reset().
+template <typename T>
+struct ArenaAllocator {
+    typedef T value_type;
+
+    FrameArena* arena;
+
+    explicit ArenaAllocator(FrameArena& arena) : arena(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) {}
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
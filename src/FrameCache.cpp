@@ -0,0 +1,93 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "FrameCache.h"
+
+#include <cstdio>
+
+static int nextPowerOfTwo(int value) {
+    int size = 1;
+    while (size < value)
+        size *= 2;
+    return size;
+}
+
+FrameCache::~FrameCache() {
+    // The texture dies with the context, so only free it while one is current
+    if (texture != 0 && glfwGetCurrentContext() != nullptr)
+        glDeleteTextures(1, &texture);
+}
+
+bool FrameCache::Capture(int width, int height) {
+    valid = false;
+    if (width <= 0 || height <= 0)
+        return false;
+
+    int needWidth = nextPowerOfTwo(width);
+    int needHeight = nextPowerOfTwo(height);
+    if (texture == 0)
+        glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    if (needWidth != textureWidth || needHeight != textureHeight) {
+        GLint maxSize = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+        if (needWidth > maxSize || needHeight > maxSize) {
+            std::fprintf(stderr, "frame cache: %dx%d exceeds the %d pixel texture limit, redrawing instead\n",
+                width, height, (int)maxSize);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            textureWidth = textureHeight = 0;
+            return false;
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, needWidth, needHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        textureWidth = needWidth;
+        textureHeight = needHeight;
+    }
+
+    glReadBuffer(GL_BACK);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    frameWidth = width;
+    frameHeight = height;
+    valid = true;
+    return true;
+}
+
+void FrameCache::Present() const {
+    if (!valid)
+        return;
+
+    float u = (float)frameWidth / (float)textureWidth;
+    float v = (float)frameHeight / (float)textureHeight;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TEXTURE_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glDisable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glColor3f(1.0f, 1.0f, 1.0f);
+
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(u, 0.0f);    glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(u, v);       glVertex2f(1.0f, 1.0f);
+    glTexCoord2f(0.0f, v);    glVertex2f(-1.0f, 1.0f);
+    glEnd();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
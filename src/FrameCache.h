@@ -0,0 +1,38 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+
+// ------------------ Frame cache ------------------
+// Keeps a copy of the last fully rendered sheet in a texture so an unchanged
+// picture can be put back on screen (after a swap, an expose or an overlay
+// toggle) with one textured quad instead of redrawing every view. The copy
+// is taken from the back buffer with glCopyTexSubImage2D, which OpenGL 1.1
+// already has, into a power-of-two texture large enough for the window.
+
+class FrameCache {
+public:
+    FrameCache() = default;
+    ~FrameCache();
+
+    FrameCache(const FrameCache&) = delete;
+    FrameCache& operator=(const FrameCache&) = delete;
+
+    // Copies the current back buffer contents (width x height pixels).
+    // Returns false when the frame is too large to cache; Valid() is then false.
+    bool Capture(int width, int height);
+
+    // Draws the cached frame over the whole viewport
+    void Present() const;
+
+    // True when Present() would show a frame of exactly this size
+    bool Valid(int width, int height) const { return valid && width == frameWidth && height == frameHeight; }
+
+    void Invalidate() { valid = false; }
+
+private:
+    GLuint texture = 0;
+    int textureWidth = 0, textureHeight = 0;
+    int frameWidth = 0, frameHeight = 0;
+    bool valid = false;
+};
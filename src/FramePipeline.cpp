@@ -0,0 +1,165 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "FramePipeline.h"
+#include "ImmediateMode.h"
+
+#include <algorithm>
+#include <utility>
+
+// Latency samples reserved up front so recording them does not allocate:
+// about nine minutes at 60 Hz before the vector has to grow
+static const size_t kReservedFrames = 1 << 15;
+
+static FrameTime now() {
+    return std::chrono::steady_clock::now();
+}
+
+FramePipeline::FramePipeline(GLFWwindow* window, const std::vector<SheetView>& views, FrameStatsLog& statsLog,
+    PickOverlay pickOverlay)
+    : window(window), views(views), statsLog(statsLog), pickOverlay(std::move(pickOverlay)) {}
+
+FramePipeline::~FramePipeline() {
+    Stop();
+}
+
+void FramePipeline::Start(const FrameInput& first) {
+    // The build stage culls from the views' bounds, which are only measured
+    // by their first draw; measure them here so no worker ever writes them
+    glViewport(0, 0, first.width, first.height);
+    loadSheetCamera(first.zoom, first.scrollX, first.scrollY);
+    for (const SheetView& view : views)
+        drawSheetView(view);
+    glFinish();
+
+    viewBounds.clear();
+    for (const SheetView& view : views)
+        viewBounds.push_back(view.bounds);
+
+    presented.reserve(kReservedFrames);
+    glfwMakeContextCurrent(nullptr);
+    running = true;
+    buildThread = std::thread(&FramePipeline::BuildLoop, this);
+    submitThread = std::thread(&FramePipeline::SubmitLoop, this);
+    Submit(first);
+}
+
+void FramePipeline::Submit(const FrameInput& input) {
+    spare.id = nextId++;
+    spare.input = input;
+    spare.time.sampled = now();
+    toBuild.Put(spare);
+}
+
+void FramePipeline::Stop() {
+    if (!running)
+        return;
+    toBuild.Close();
+    buildThread.join();
+    submitThread.join();
+    glfwMakeContextCurrent(window);
+    running = false;
+}
+
+void FramePipeline::BuildLoop() {
+    FramePacket packet;
+    while (toBuild.Take(packet)) {
+        packet.time.buildStart = now();
+
+        const FrameInput& input = packet.input;
+        Bounds camera;
+        camera.minX = (float)(input.scrollX - input.zoom);
+        camera.maxX = (float)(input.scrollX + input.zoom);
+        camera.minY = (float)(input.scrollY - input.zoom);
+        camera.maxY = (float)(input.scrollY + input.zoom);
+
+        packet.visible.resize(views.size());
+        for (size_t i = 0; i < views.size(); ++i) {
+            const Bounds& bounds = viewBounds[i];
+            packet.visible[i] = !cullingEnabled || !bounds.Valid() || bounds.Intersects(camera);
+        }
+
+        packet.time.built = now();
+        toSubmit.Put(packet);
+    }
+    toSubmit.Close();
+}
+
+void FramePipeline::SubmitLoop() {
+    glfwMakeContextCurrent(window);
+
+    FrameStats frameStats;
+    FramePacket packet;
+    while (toSubmit.Take(packet)) {
+        packet.time.submitStart = now();
+
+        const FrameInput& input = packet.input;
+        glViewport(0, 0, input.width, input.height);
+        glClear(GL_COLOR_BUFFER_BIT);
+        loadSheetCamera(input.zoom, input.scrollX, input.scrollY);
+
+        frameStats.Clear();
+        for (size_t i = 0; i < views.size(); ++i) {
+            renderStats.Reset();
+            if (packet.visible[i])
+                drawSheetView(views[i]);
+            frameStats.Record(views[i].name, renderStats);
+        }
+        statsLog.Write(packet.id, frameStats);
+
+        if (input.pick.kind != PickKind::None && pickOverlay)
+            pickOverlay(input.pick, input.width, input.height);
+        if (input.overlay)
+            drawFrameStatsOverlay(frameStats, input.width, input.height);
+
+        packet.time.swapStart = now();
+        glfwSwapBuffers(window);
+        packet.time.presented = now();
+
+        presented.push_back(packet.time);
+    }
+
+    glfwMakeContextCurrent(nullptr);
+}
+
+void FramePipeline::PrintLatency(std::FILE* out) const {
+    struct Stage {
+        const char* name;
+        FrameTime FrameStamps::* from;
+        FrameTime FrameStamps::* to;
+    };
+    static const Stage stages[] = {
+        { "wait_build", &FrameStamps::sampled, &FrameStamps::buildStart },
+        { "build", &FrameStamps::buildStart, &FrameStamps::built },
+        { "wait_submit", &FrameStamps::built, &FrameStamps::submitStart },
+        { "submit", &FrameStamps::submitStart, &FrameStamps::swapStart },
+        { "swap", &FrameStamps::swapStart, &FrameStamps::presented },
+        { "input_to_present", &FrameStamps::sampled, &FrameStamps::presented },
+    };
+
+    std::fprintf(out, "frames %zu, skipped before build %lld, skipped before submit %lld\n",
+        presented.size(), toBuild.Dropped(), toSubmit.Dropped());
+    if (presented.empty())
+        return;
+
+    std::fprintf(out, "stage,mean_ms,p50_ms,p99_ms,max_ms\n");
+    std::vector<double> samples;
+    for (const Stage& stage : stages) {
+        samples.clear();
+        double sum = 0.0;
+        for (const FrameStamps& time : presented) {
+            double ms = std::chrono::duration<double, std::milli>(time.*stage.to - time.*stage.from).count();
+            samples.push_back(ms);
+            sum += ms;
+        }
+        std::sort(samples.begin(), samples.end());
+
+        // Nearest-rank percentiles
+        auto percentile = [&](double p) {
+            size_t rank = (size_t)(p * samples.size() + 0.999999);
+            rank = std::min(std::max(rank, (size_t)1), samples.size());
+            return samples[rank - 1];
+        };
+        std::fprintf(out, "%s,%.3f,%.3f,%.3f,%.3f\n", stage.name,
+            sum / samples.size(), percentile(0.50), percentile(0.99), samples.back());
+    }
+}
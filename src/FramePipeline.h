@@ -0,0 +1,156 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Culling.h"
+#include "FrameStats.h"
+#include "Picking.h"
+#include "SheetView.h"
+
+struct GLFWwindow;
+
+// ------------------ Pipelined frame loop ------------------
+// Splits a frame into three stages on three threads:
+//
+//   input   (main thread; GLFW events must be handled there)  camera, window size, overlay
+//   build   (worker)                                          per-view visibility and the draw list
+//   submit  (worker owning the GL context)                    GL calls and glfwSwapBuffers
+//
+// Stages hand frame packets over through mailboxes: a stage that falls
+// behind skips straight to the newest packet instead of queueing stale
+// ones, so with one packet being filled, one waiting and one being consumed
+// per hand-off this is triple buffering, and frame N + 1 is built while
+// frame N is drawn.
+//
+// Every packet is stamped as it passes each stage. The "present" stamp is
+// taken when glfwSwapBuffers returns, a lower bound on when the frame is
+// actually seen.
+
+typedef std::chrono::steady_clock::time_point FrameTime;
+
+// What the input stage decided for one frame
+struct FrameInput {
+    float zoom;
+    double scrollX, scrollY;
+    int width, height;
+    bool overlay;
+    PlanPick pick;      // hovered or selected primitive, highlighted over the views
+};
+
+struct FrameStamps {
+    FrameTime sampled, buildStart, built, submitStart, swapStart, presented;
+};
+
+struct FramePacket {
+    long long id = 0;
+    FrameInput input = {};
+    std::vector<char> visible;  // per view, filled by the build stage
+    FrameStamps time;
+};
+
+// Single-slot hand-off between two stages. Put() replaces a packet the
+// consumer has not taken yet (counted as dropped); Take() blocks until a
+// packet arrives or the mailbox is closed and empty.
+//
+// Both swap rather than move, so the caller gets back whatever was in the
+// slot before: packets and their buffers circulate between the stages and a
+// steady-state frame allocates nothing.
+template <typename T>
+class Mailbox {
+public:
+    void Put(T& value) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (full)
+                ++dropped;
+            std::swap(slot, value);
+            full = true;
+        }
+        ready.notify_one();
+    }
+
+    bool Take(T& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait(lock, [this] { return full || closed; });
+        if (!full)
+            return false;
+        std::swap(out, slot);
+        full = false;
+        return true;
+    }
+
+    void Close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_all();
+    }
+
+    long long Dropped() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dropped;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable ready;
+    T slot;
+    bool full = false;
+    bool closed = false;
+    long long dropped = 0;
+};
+
+// Draws a frame's pick highlight on the submit thread, under the sheet camera
+typedef std::function<void(const PlanPick& pick, int width, int height)> PickOverlay;
+
+class FramePipeline {
+public:
+    FramePipeline(GLFWwindow* window, const std::vector<SheetView>& views, FrameStatsLog& statsLog,
+        PickOverlay pickOverlay = PickOverlay());
+    ~FramePipeline();
+
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // Draws every view once on the calling thread to learn their bounds, then
+    // hands the GL context to the submit thread and starts both workers
+    void Start(const FrameInput& first);
+
+    // Queues a frame from the input stage
+    void Submit(const FrameInput& input);
+
+    // Drains the stages, joins the workers and makes the context current on
+    // the calling thread again
+    void Stop();
+
+    // Per-stage latency of every presented frame: mean, p50, p99 and max
+    void PrintLatency(std::FILE* out) const;
+
+private:
+    void BuildLoop();
+    void SubmitLoop();
+
+    GLFWwindow* window;
+    const std::vector<SheetView>& views;
+    FrameStatsLog& statsLog;
+    PickOverlay pickOverlay;
+
+    std::vector<Bounds> viewBounds;     // snapshot taken by Start()
+    Mailbox<FramePacket> toBuild;
+    Mailbox<FramePacket> toSubmit;
+    std::thread buildThread;
+    std::thread submitThread;
+    FramePacket spare;                  // recycled by Submit()
+    long long nextId = 0;
+    bool running = false;
+
+    std::vector<FrameStamps> presented; // written by the submit thread until Stop()
+};
@@ -0,0 +1,234 @@
+#include "FrameStats.h"
+
+#include <cctype>
+#include <cstring>
+
+void FrameStats::Clear() {
+    views.clear();
+    total.Reset();
+}
+
+void FrameStats::Record(const char* name, const RenderStats& stats) {
+    views.push_back({ name, stats });
+    total += stats;
+}
+
+// ------------------ Log file ------------------
+
+FrameStatsLog::~FrameStatsLog() {
+    if (file)
+        std::fclose(file);
+}
+
+bool FrameStatsLog::Open(const std::string& path) {
+    file = std::fopen(path.c_str(), "a");
+    if (!file) {
+        std::fprintf(stderr, "stats: could not write %s\n", path.c_str());
+        return false;
+    }
+    // Appending to an earlier run's log keeps its header
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0)
+        std::fprintf(file, "frame,view,draw_calls,vertices,state_changes,line_width_switches\n");
+    return true;
+}
+
+void FrameStatsLog::Write(long long frame, const FrameStats& stats) {
+    if (!file)
+        return;
+    auto row = [&](const char* name, const RenderStats& s) {
+        std::fprintf(file, "%lld,%s,%lld,%lld,%lld,%lld\n",
+            frame, name, s.drawCalls, s.vertices, s.stateChanges, s.lineWidthSwitches);
+    };
+    for (const ViewStats& view : stats.views)
+        row(view.name, view.stats);
+    row("total", stats.total);
+}
+
+// ------------------ Overlay ------------------
+
+// 3x5 pixel font, one string of five rows per glyph ('#' = lit)
+struct Glyph {
+    char c;
+    const char* rows;
+};
+
+static const Glyph kFont[] = {
+    { '0', "###" "#.#" "#.#" "#.#" "###" },
+    { '1', ".#." "##." ".#." ".#." "###" },
+    { '2', "###" "..#" "###" "#.." "###" },
+    { '3', "###" "..#" ".##" "..#" "###" },
+    { '4', "#.#" "#.#" "###" "..#" "..#" },
+    { '5', "###" "#.." "###" "..#" "###" },
+    { '6', "###" "#.." "###" "#.#" "###" },
+    { '7', "###" "..#" "..#" ".#." ".#." },
+    { '8', "###" "#.#" "###" "#.#" "###" },
+    { '9', "###" "#.#" "###" "..#" "###" },
+    { 'A', ".#." "#.#" "###" "#.#" "#.#" },
+    { 'B', "##." "#.#" "##." "#.#" "##." },
+    { 'C', ".##" "#.." "#.." "#.." ".##" },
+    { 'D', "##." "#.#" "#.#" "#.#" "##." },
+    { 'E', "###" "#.." "##." "#.." "###" },
+    { 'F', "###" "#.." "##." "#.." "#.." },
+    { 'G', ".##" "#.." "#.#" "#.#" ".##" },
+    { 'H', "#.#" "#.#" "###" "#.#" "#.#" },
+    { 'I', "###" ".#." ".#." ".#." "###" },
+    { 'J', "..#" "..#" "..#" "#.#" ".#." },
+    { 'K', "#.#" "#.#" "##." "#.#" "#.#" },
+    { 'L', "#.." "#.." "#.." "#.." "###" },
+    { 'M', "#.#" "###" "###" "#.#" "#.#" },
+    { 'N', "##." "#.#" "#.#" "#.#" "#.#" },
+    { 'O', ".#." "#.#" "#.#" "#.#" ".#." },
+    { 'P', "##." "#.#" "##." "#.." "#.." },
+    { 'Q', ".#." "#.#" "#.#" "##." ".##" },
+    { 'R', "##." "#.#" "##." "#.#" "#.#" },
+    { 'S', ".##" "#.." ".#." "..#" "##." },
+    { 'T', "###" ".#." ".#." ".#." ".#." },
+    { 'U', "#.#" "#.#" "#.#" "#.#" "###" },
+    { 'V', "#.#" "#.#" "#.#" "#.#" ".#." },
+    { 'W', "#.#" "#.#" "###" "###" "#.#" },
+    { 'X', "#.#" "#.#" ".#." "#.#" "#.#" },
+    { 'Y', "#.#" "#.#" ".#." ".#." ".#." },
+    { 'Z', "###" "..#" ".#." "#.." "###" },
+    { '-', "..." "..." "###" "..." "..." },
+    { '.', "..." "..." "..." "..." ".#." },
+    { ':', "..." ".#." "..." ".#." "..." },
+    { '/', "..#" "..#" ".#." "#.." "#.." },
+};
+
+static const int kPixel = 3;                    // screen pixels per font pixel
+static const int kAdvance = 4 * kPixel;         // glyph width plus one column of spacing
+static const int kLineHeight = 7 * kPixel;
+
+static const char* glyphRows(char c) {
+    c = (char)std::toupper((unsigned char)c);
+    for (const Glyph& glyph : kFont) {
+        if (glyph.c == c)
+            return glyph.rows;
+    }
+    return nullptr; // spaces and anything unknown are left blank
+}
+
+// Emits quads for 'text' with its top-left corner at (x, y), y growing downwards
+static void drawText(const char* text, int x, int y) {
+    for (; *text; ++text, x += kAdvance) {
+        const char* rows = glyphRows(*text);
+        if (!rows)
+            continue;
+        for (int row = 0; row < 5; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                if (rows[row * 3 + col] != '#')
+                    continue;
+                int px = x + col * kPixel;
+                int py = y + row * kPixel;
+                glVertex2i(px, py);
+                glVertex2i(px + kPixel, py);
+                glVertex2i(px + kPixel, py + kPixel);
+                glVertex2i(px, py + kPixel);
+            }
+        }
+    }
+}
+
+void drawFrameStatsOverlay(const FrameStats& stats, int width, int height) {
+    const int columns = 6;
+    const int columnChars[columns] = { 7, 8, 9, 8, 7, 0 };
+    const char* header[columns] = { "VIEW", "DRAWS", "VERTS", "STATE", "LINEW", nullptr };
+
+    const int margin = 2 * kPixel;
+
+    int tableChars = 0;
+    for (int chars : columnChars)
+        tableChars += chars;
+    int rows = (int)stats.views.size() + 2; // header, views, total
+    int panelWidth = tableChars * kAdvance + 2 * margin;
+    int panelHeight = rows * kLineHeight + 2 * margin;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, width, height, 0.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    glVertex2i(0, 0);
+    glVertex2i(panelWidth, 0);
+    glVertex2i(panelWidth, panelHeight);
+    glVertex2i(0, panelHeight);
+
+    int y = margin;
+    auto printRow = [&](const char* cells[columns]) {
+        int x = margin;
+        for (int i = 0; cells[i]; ++i) {
+            drawText(cells[i], x, y);
+            x += columnChars[i] * kAdvance;
+        }
+        y += kLineHeight;
+    };
+    auto printStats = [&](const char* name, const RenderStats& s) {
+        char draws[24], verts[24], state[24], widths[24];
+        std::snprintf(draws, sizeof(draws), "%lld", s.drawCalls);
+        std::snprintf(verts, sizeof(verts), "%lld", s.vertices);
+        std::snprintf(state, sizeof(state), "%lld", s.stateChanges);
+        std::snprintf(widths, sizeof(widths), "%lld", s.lineWidthSwitches);
+        const char* cells[columns] = { name, draws, verts, state, widths, nullptr };
+        printRow(cells);
+    };
+
+    glColor3f(1.0f, 0.85f, 0.3f);
+    printRow(header);
+    glColor3f(1.0f, 1.0f, 1.0f);
+    for (const ViewStats& view : stats.views)
+        printStats(view.name, view.stats);
+    glColor3f(0.6f, 1.0f, 0.6f);
+    printStats("total", stats.total);
+    glEnd();
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
+
+void drawOverlayLabel(const char* text, int width, int height) {
+    const int margin = 2 * kPixel;
+    int panelWidth = (int)std::strlen(text) * kAdvance + 2 * margin;
+    int panelHeight = kLineHeight + 2 * margin;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, width, height, 0.0, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBegin(GL_QUADS);
+    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    glVertex2i(0, height - panelHeight);
+    glVertex2i(panelWidth, height - panelHeight);
+    glVertex2i(panelWidth, height);
+    glVertex2i(0, height);
+
+    glColor3f(1.0f, 0.85f, 0.3f);
+    drawText(text, margin, height - panelHeight + margin);
+    glEnd();
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopAttrib();
+}
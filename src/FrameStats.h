@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ImmediateMode.h"
+
+// ------------------ Frame statistics ------------------
+// Per-view counters for one frame, collected by resetting renderStats before
+// each view draws and recording it afterwards.
+
+struct ViewStats {
+    const char* name;
+    RenderStats stats;
+};
+
+struct FrameStats {
+    std::vector<ViewStats> views;
+    RenderStats total;
+
+    void Clear();
+    void Record(const char* name, const RenderStats& stats);
+};
+
+// Appends one CSV row per view (plus a "total" row) for every frame written
+class FrameStatsLog {
+public:
+    FrameStatsLog() = default;
+    ~FrameStatsLog();
+
+    FrameStatsLog(const FrameStatsLog&) = delete;
+    FrameStatsLog& operator=(const FrameStatsLog&) = delete;
+
+    bool Open(const std::string& path);
+    bool IsOpen() const { return file != nullptr; }
+    void Write(long long frame, const FrameStats& stats);
+
+private:
+    std::FILE* file = nullptr;
+};
+
+// Draws the counters as a table in the top-left corner of a width x height
+// framebuffer. Uses raw GL so the overlay does not show up in its own numbers.
+void drawFrameStatsOverlay(const FrameStats& stats, int width, int height);
+
+// Draws one line of 'text' in the same font on a panel in the bottom-left
+// corner, e.g. what the cursor is over
+void drawOverlayLabel(const char* text, int width, int height);
@@ -0,0 +1,43 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "GLExtensions.h"
+
+template <typename T>
+static bool loadProc(T& fn, const char* name) {
+    fn = reinterpret_cast<T>(glfwGetProcAddress(name));
+    return fn != nullptr;
+}
+
+// Tries the core name first, then the EXT entry point with the same signature
+template <typename T>
+static bool loadProc(T& fn, const char* name, const char* extName) {
+    return loadProc(fn, name) || loadProc(fn, extName);
+}
+
+const GLExtensions& glExtensions() {
+    static GLExtensions ext;
+    if (ext.loaded)
+        return ext;
+    ext.loaded = true;
+
+    bool ok = true;
+    ok &= loadProc(ext.GenBuffers, "glGenBuffers");
+    ok &= loadProc(ext.DeleteBuffers, "glDeleteBuffers");
+    ok &= loadProc(ext.BindBuffer, "glBindBuffer");
+    ok &= loadProc(ext.BufferData, "glBufferData");
+    ext.hasBuffers = ok;
+
+    ok = true;
+    ok &= loadProc(ext.GenFramebuffers, "glGenFramebuffers", "glGenFramebuffersEXT");
+    ok &= loadProc(ext.DeleteFramebuffers, "glDeleteFramebuffers", "glDeleteFramebuffersEXT");
+    ok &= loadProc(ext.BindFramebuffer, "glBindFramebuffer", "glBindFramebufferEXT");
+    ok &= loadProc(ext.CheckFramebufferStatus, "glCheckFramebufferStatus", "glCheckFramebufferStatusEXT");
+    ok &= loadProc(ext.GenRenderbuffers, "glGenRenderbuffers", "glGenRenderbuffersEXT");
+    ok &= loadProc(ext.DeleteRenderbuffers, "glDeleteRenderbuffers", "glDeleteRenderbuffersEXT");
+    ok &= loadProc(ext.BindRenderbuffer, "glBindRenderbuffer", "glBindRenderbufferEXT");
+    ok &= loadProc(ext.RenderbufferStorage, "glRenderbufferStorage", "glRenderbufferStorageEXT");
+    ok &= loadProc(ext.FramebufferRenderbuffer, "glFramebufferRenderbuffer", "glFramebufferRenderbufferEXT");
+    ext.hasFramebuffers = ok;
+
+    return ext;
+}
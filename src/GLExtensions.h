@@ -0,0 +1,54 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <cstddef>
+
+// opengl32.lib only exports OpenGL 1.1, so anything newer is fetched at
+// runtime through glfwGetProcAddress once a context is current.
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+struct GLExtensions {
+    bool loaded = false;
+
+    // Vertex buffer objects (OpenGL 1.5)
+    bool hasBuffers = false;
+    void (APIENTRY* GenBuffers)(GLsizei n, GLuint* buffers) = nullptr;
+    void (APIENTRY* DeleteBuffers)(GLsizei n, const GLuint* buffers) = nullptr;
+    void (APIENTRY* BindBuffer)(GLenum target, GLuint buffer) = nullptr;
+    void (APIENTRY* BufferData)(GLenum target, std::ptrdiff_t size, const void* data, GLenum usage) = nullptr;
+
+    // Framebuffer objects (OpenGL 3.0 or GL_EXT_framebuffer_object)
+    bool hasFramebuffers = false;
+    void (APIENTRY* GenFramebuffers)(GLsizei n, GLuint* framebuffers) = nullptr;
+    void (APIENTRY* DeleteFramebuffers)(GLsizei n, const GLuint* framebuffers) = nullptr;
+    void (APIENTRY* BindFramebuffer)(GLenum target, GLuint framebuffer) = nullptr;
+    GLenum (APIENTRY* CheckFramebufferStatus)(GLenum target) = nullptr;
+    void (APIENTRY* GenRenderbuffers)(GLsizei n, GLuint* renderbuffers) = nullptr;
+    void (APIENTRY* DeleteRenderbuffers)(GLsizei n, const GLuint* renderbuffers) = nullptr;
+    void (APIENTRY* BindRenderbuffer)(GLenum target, GLuint renderbuffer) = nullptr;
+    void (APIENTRY* RenderbufferStorage)(GLenum target, GLenum format, GLsizei width, GLsizei height) = nullptr;
+    void (APIENTRY* FramebufferRenderbuffer)(GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer) = nullptr;
+};
+
+// Returns the extension entry points, loading them on first use.
+// Must be called with a current GL context.
+const GLExtensions& glExtensions();
@@ -0,0 +1,377 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "GeometryBuffer.h"
+#include "GLExtensions.h"
+#include "ImmediateMode.h"
+
+#include <cstddef>
+#include <utility>
+
+static GLubyte toByte(float c) {
+    if (c <= 0.0f) return 0;
+    if (c >= 1.0f) return 255;
+    return (GLubyte)(c * 255.0f + 0.5f);
+}
+
+GeometryBuffer::~GeometryBuffer() {
+    // The buffer object dies with the context, so only free it while one is current
+    if (vbo != 0 && glfwGetCurrentContext() != nullptr)
+        glExtensions().DeleteBuffers(1, &vbo);
+}
+
+GeometryBuffer::GeometryBuffer(GeometryBuffer&& other) noexcept
+    : vertices(std::move(other.vertices)),
+      batches(std::move(other.batches)),
+      bounds(other.bounds),
+      anchor(other.anchor),
+      packed(std::move(other.packed)),
+      packedOrigin(other.packedOrigin),
+      pending(std::move(other.pending)),
+      pendingMode(other.pendingMode),
+      recording(other.recording),
+      current(other.current),
+      lineWidth(other.lineWidth),
+      vbo(other.vbo),
+      uploaded(other.uploaded) {
+    other.vbo = 0;
+    other.uploaded = false;
+}
+
+GeometryBuffer& GeometryBuffer::operator=(GeometryBuffer&& other) noexcept {
+    if (this != &other) {
+        std::swap(vertices, other.vertices);
+        std::swap(batches, other.batches);
+        std::swap(bounds, other.bounds);
+        std::swap(anchor, other.anchor);
+        std::swap(packed, other.packed);
+        std::swap(packedOrigin, other.packedOrigin);
+        std::swap(pending, other.pending);
+        std::swap(pendingMode, other.pendingMode);
+        std::swap(recording, other.recording);
+        std::swap(current, other.current);
+        std::swap(lineWidth, other.lineWidth);
+        std::swap(vbo, other.vbo);
+        std::swap(uploaded, other.uploaded);
+    }
+    return *this;
+}
+
+void GeometryBuffer::Begin(GLenum mode) {
+    if (recording)
+        End(); // glBegin inside glBegin is an error in GL; close the open primitive instead
+    pendingMode = mode;
+    pending.clear();
+    recording = true;
+}
+
+void GeometryBuffer::End() {
+    if (!recording)
+        return;
+    recording = false;
+
+    switch (pendingMode) {
+    case GL_LINES:
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        AssembleLines();
+        break;
+    case GL_TRIANGLES:
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_QUADS:
+    case GL_QUAD_STRIP:
+    case GL_POLYGON:
+        AssembleTriangles();
+        break;
+    default:
+        break; // points are not used by the drawings
+    }
+    pending.clear();
+}
+
+void GeometryBuffer::Color3f(float r, float g, float b) {
+    Color4f(r, g, b, 1.0f);
+}
+
+void GeometryBuffer::Color4f(float r, float g, float b, float a) {
+    current.r = toByte(r);
+    current.g = toByte(g);
+    current.b = toByte(b);
+    current.a = toByte(a);
+}
+
+void GeometryBuffer::Vertex2f(float x, float y) {
+    if (!recording)
+        return; // same as GL: vertices outside Begin/End are ignored
+    PackedVertex v = current;
+    v.x = x;
+    v.y = y;
+    pending.push_back(v);
+}
+
+void GeometryBuffer::LineWidth(float width) {
+    lineWidth = width;
+}
+
+void GeometryBuffer::SetAnchor(double x, double y) {
+    anchor = { x, y };
+    uploaded = false;
+}
+
+Bounds GeometryBuffer::WorldBounds() const {
+    if (!bounds.Valid())
+        return bounds;
+    Bounds world;
+    world.Add((float)(bounds.minX + anchor.x), (float)(bounds.minY + anchor.y));
+    world.Add((float)(bounds.maxX + anchor.x), (float)(bounds.maxY + anchor.y));
+    return world;
+}
+
+void GeometryBuffer::Clear() {
+    vertices.Clear();
+    batches.clear();
+    bounds = Bounds();
+    anchor = { 0.0, 0.0 };
+    pending.clear();
+    recording = false;
+    uploaded = false;
+}
+
+void GeometryBuffer::AssembleLines() {
+    size_t n = pending.size();
+    if (pendingMode == GL_LINES) {
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            Append(GL_LINES, pending[i]);
+            Append(GL_LINES, pending[i + 1]);
+        }
+        return;
+    }
+
+    if (n < 2)
+        return;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        Append(GL_LINES, pending[i]);
+        Append(GL_LINES, pending[i + 1]);
+    }
+    if (pendingMode == GL_LINE_LOOP) {
+        Append(GL_LINES, pending[n - 1]);
+        Append(GL_LINES, pending[0]);
+    }
+}
+
+void GeometryBuffer::AssembleTriangles() {
+    size_t n = pending.size();
+    switch (pendingMode) {
+    case GL_TRIANGLES:
+        for (size_t i = 0; i + 2 < n; i += 3) {
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 1]);
+            Append(GL_TRIANGLES, pending[i + 2]);
+        }
+        break;
+    case GL_TRIANGLE_STRIP:
+        for (size_t i = 0; i + 2 < n; ++i) {
+            // Keep the winding consistent on odd triangles
+            bool odd = (i % 2) != 0;
+            Append(GL_TRIANGLES, pending[odd ? i + 1 : i]);
+            Append(GL_TRIANGLES, pending[odd ? i : i + 1]);
+            Append(GL_TRIANGLES, pending[i + 2]);
+        }
+        break;
+    case GL_QUADS:
+        for (size_t i = 0; i + 3 < n; i += 4) {
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 1]);
+            Append(GL_TRIANGLES, pending[i + 2]);
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 2]);
+            Append(GL_TRIANGLES, pending[i + 3]);
+        }
+        break;
+    case GL_QUAD_STRIP:
+        for (size_t i = 0; i + 3 < n; i += 2) {
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 1]);
+            Append(GL_TRIANGLES, pending[i + 3]);
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 3]);
+            Append(GL_TRIANGLES, pending[i + 2]);
+        }
+        break;
+    default: // GL_TRIANGLE_FAN, GL_POLYGON (all polygons in the drawings are convex)
+        for (size_t i = 1; i + 1 < n; ++i) {
+            Append(GL_TRIANGLES, pending[0]);
+            Append(GL_TRIANGLES, pending[i]);
+            Append(GL_TRIANGLES, pending[i + 1]);
+        }
+        break;
+    }
+}
+
+void GeometryBuffer::AppendTransformed(const GeometryBuffer& source, const Affine2D& m) {
+    if (recording)
+        End();
+    size_t first = vertices.Size();
+    for (const DrawBatch& batch : source.batches) {
+        BatchFor(batch.mode, batch.lineWidth).count += batch.count;
+        vertices.Append(source.vertices, (size_t)batch.first, (size_t)batch.count);
+    }
+    transformStream(m, vertices, first);
+    AddBounds(first);
+    uploaded = false;
+}
+
+void GeometryBuffer::Transform(const Affine2D& m) {
+    if (recording)
+        End();
+    transformStream(m, vertices);
+    bounds = Bounds();
+    AddBounds(0);
+    uploaded = false;
+}
+
+void GeometryBuffer::Append(GLenum mode, const PackedVertex& v) {
+    Append(mode, (mode == GL_LINES) ? lineWidth : 1.0f, v);
+}
+
+void GeometryBuffer::Append(GLenum mode, float width, const PackedVertex& v) {
+    BatchFor(mode, width).count++;
+    vertices.Push(v);
+    bounds.Add(v.x, v.y);
+    uploaded = false;
+}
+
+// Batch the next vertices go into: the last one if it matches, a new one otherwise
+DrawBatch& GeometryBuffer::BatchFor(GLenum mode, float width) {
+    if (batches.empty() || batches.back().mode != mode || batches.back().lineWidth != width) {
+        DrawBatch batch = { mode, width, (GLint)vertices.Size(), 0 };
+        batches.push_back(batch);
+    }
+    return batches.back();
+}
+
+void GeometryBuffer::AddBounds(size_t first) {
+    for (size_t i = first; i < vertices.Size(); ++i)
+        bounds.Add(vertices.x[i], vertices.y[i]);
+}
+
+void GeometryBuffer::Draw() {
+    if (!Bind())
+        return;
+
+    float currentWidth = -1.0f;
+    for (const DrawBatch& batch : batches) {
+        if (batch.mode == GL_LINES && batch.lineWidth != currentWidth) {
+            imLineWidth(batch.lineWidth);
+            currentWidth = batch.lineWidth;
+        }
+        Submit(batch.mode, (size_t)batch.first, (size_t)batch.count);
+    }
+    renderStats.drawCalls += (long long)batches.size();
+    renderStats.vertices += (long long)vertices.Size();
+
+    Unbind();
+}
+
+void GeometryBuffer::DrawRanges(const std::vector<IndexRange>& ranges) {
+    if (ranges.empty() || !Bind())
+        return;
+
+    // Both lists are sorted by first vertex, so one pass clips each range to each batch
+    float currentWidth = -1.0f;
+    size_t range = 0;
+    for (const DrawBatch& batch : batches) {
+        size_t batchFirst = (size_t)batch.first;
+        size_t batchLast = batchFirst + (size_t)batch.count;
+        while (range < ranges.size() && ranges[range].first + ranges[range].count <= batchFirst)
+            ++range;
+        for (size_t i = range; i < ranges.size() && ranges[i].first < batchLast; ++i) {
+            size_t first = ranges[i].first > batchFirst ? ranges[i].first : batchFirst;
+            size_t last = ranges[i].first + ranges[i].count;
+            if (last > batchLast)
+                last = batchLast;
+            if (first >= last)
+                continue;
+            if (batch.mode == GL_LINES && batch.lineWidth != currentWidth) {
+                imLineWidth(batch.lineWidth);
+                currentWidth = batch.lineWidth;
+            }
+            Submit(batch.mode, first, last - first);
+            renderStats.drawCalls++;
+            renderStats.vertices += (long long)(last - first);
+        }
+    }
+
+    Unbind();
+}
+
+// Makes the render-space copy current and, on the OpenGL backend, points
+// the client arrays at it. Returns false when there is nothing to draw.
+bool GeometryBuffer::Bind() {
+    if (vertices.Empty())
+        return false;
+
+    if (boundsCapture.active) {
+        boundsCapture.LoadModelview();
+        boundsCapture.AddLocal(WorldBounds());
+    }
+
+    // Interleave the stream for GL whenever it changed, moving it from the
+    // anchor to the render origin. The offset is taken in double precision;
+    // only its float result reaches the vertices.
+    if (packedOrigin.x != renderOrigin.x || packedOrigin.y != renderOrigin.y)
+        uploaded = false;
+
+    if (!renderBackend().UsesOpenGL()) {
+        // Other backends read the client-side copy, which is then kept
+        if (!uploaded || packed.size() != vertices.Size()) {
+            vertices.Pack(packed, (float)(anchor.x - renderOrigin.x), (float)(anchor.y - renderOrigin.y));
+            packedOrigin = renderOrigin;
+        }
+        uploaded = true;
+        return true;
+    }
+
+    const GLExtensions& ext = glExtensions();
+    if (!uploaded) {
+        vertices.Pack(packed, (float)(anchor.x - renderOrigin.x), (float)(anchor.y - renderOrigin.y));
+        packedOrigin = renderOrigin;
+    }
+    const char* base = reinterpret_cast<const char*>(packed.data());
+
+    if (ext.hasBuffers) {
+        if (vbo == 0)
+            ext.GenBuffers(1, &vbo);
+        ext.BindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (!uploaded) {
+            ext.BufferData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(packed.size() * sizeof(PackedVertex)),
+                packed.data(), GL_STATIC_DRAW);
+            std::vector<PackedVertex>().swap(packed); // the buffer object holds the copy now
+        }
+        base = nullptr; // offsets are now relative to the bound buffer
+    }
+    uploaded = true;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(PackedVertex), base + offsetof(PackedVertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PackedVertex), base + offsetof(PackedVertex, r));
+    return true;
+}
+
+void GeometryBuffer::Submit(GLenum mode, size_t first, size_t count) {
+    if (renderBackend().UsesOpenGL())
+        glDrawArrays(mode, (GLint)first, (GLsizei)count);
+    else
+        renderBackend().DrawArrays(mode, packed.data(), first, count);
+}
+
+void GeometryBuffer::Unbind() {
+    if (renderBackend().UsesOpenGL()) {
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        if (glExtensions().hasBuffers)
+            glExtensions().BindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    imLineWidth(1.0f);
+}
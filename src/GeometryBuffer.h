@@ -0,0 +1,119 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <vector>
+
+#include "Culling.h"
+#include "RenderOrigin.h"
+#include "SpatialIndex.h"
+#include "VertexStream.h"
+
+// A contiguous run of vertices submitted with a single glDrawArrays call
+struct DrawBatch {
+    GLenum mode;        // GL_LINES or GL_TRIANGLES
+    float lineWidth;    // only meaningful for GL_LINES
+    GLint first;
+    GLsizei count;
+};
+
+// Retained-mode geometry recorded through a glBegin/glEnd style interface.
+// Every primitive type used by the drawing helpers is assembled into plain
+// GL_LINES or GL_TRIANGLES on End(), and consecutive primitives sharing the
+// same mode and line width are merged into one batch, so a static drawing
+// collapses to a handful of draw calls. Vertices are kept as a VertexStream
+// so placement transforms run on the SIMD kernels; Draw() interleaves them
+// for GL once per change.
+class GeometryBuffer {
+public:
+    GeometryBuffer() = default;
+    ~GeometryBuffer();
+
+    GeometryBuffer(const GeometryBuffer&) = delete;
+    GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+    GeometryBuffer(GeometryBuffer&& other) noexcept;
+    GeometryBuffer& operator=(GeometryBuffer&& other) noexcept;
+
+    // ---- Recording (mirrors the immediate-mode calls) ----
+    void Begin(GLenum mode);
+    void End();
+    void Color3f(float r, float g, float b);
+    void Color4f(float r, float g, float b, float a);
+    void Vertex2f(float x, float y);
+    void LineWidth(float width);
+
+    // Appends the assembled geometry of 'source' with every position mapped
+    // through 'm'. Used to stamp template meshes (fixtures) into a larger buffer.
+    void AppendTransformed(const GeometryBuffer& source, const Affine2D& m);
+
+    // Maps every assembled position through 'm', e.g. to place a view drawn
+    // in its own units onto the sheet instead of pushing a GL matrix
+    void Transform(const Affine2D& m);
+
+    // World position of the recorded coordinates' (0, 0), kept in double
+    // precision so a building can sit anywhere on a large site while its
+    // vertices stay small floats. Defaults to the world origin.
+    void SetAnchor(double x, double y);
+    const WorldPoint& Anchor() const { return anchor; }
+
+    // Drops all recorded geometry and the anchor; the GPU copy is refreshed
+    // on the next Draw()
+    void Clear();
+
+    bool Empty() const { return vertices.Empty(); }
+
+    // Vertices recorded since Begin(), not yet assembled
+    size_t PendingVertices() const { return pending.size(); }
+    const VertexStream& Vertices() const { return vertices; }
+    const std::vector<DrawBatch>& Batches() const { return batches; }
+
+    // Box around every assembled vertex, in the coordinates they were recorded in
+    const Bounds& LocalBounds() const { return bounds; }
+
+    // The same box moved to the anchor, for culling
+    Bounds WorldBounds() const;
+
+    // Uploads the vertices in render space (VBO when available, client
+    // arrays otherwise) and issues one glDrawArrays per batch. The upload is
+    // redone only after the geometry changed or the render origin moved.
+    // Backends other than OpenGL are handed the client-side copy instead.
+    void Draw();
+
+    // Draws only the vertex runs in 'ranges' (sorted, non-overlapping),
+    // clipped to the batches they fall in. Used with a buffer laid out in
+    // spatial index order, so the visible part of a large plan is a few runs.
+    void DrawRanges(const std::vector<IndexRange>& ranges);
+
+private:
+    bool Bind();
+    void Submit(GLenum mode, size_t first, size_t count);
+    void Unbind();
+    void AssembleLines();
+    void AssembleTriangles();
+    void Append(GLenum mode, const PackedVertex& v);
+    void Append(GLenum mode, float width, const PackedVertex& v);
+    DrawBatch& BatchFor(GLenum mode, float width);
+    void AddBounds(size_t first);
+
+    VertexStream vertices;
+    std::vector<DrawBatch> batches;
+    Bounds bounds;
+
+    WorldPoint anchor = { 0.0, 0.0 };
+
+    // Interleaved render-space copy handed to GL, refreshed whenever the
+    // stream changed or the render origin moved ('packedOrigin')
+    std::vector<PackedVertex> packed;
+    WorldPoint packedOrigin = { 0.0, 0.0 };
+
+    // Vertices of the primitive currently between Begin() and End()
+    std::vector<PackedVertex> pending;
+    GLenum pendingMode = GL_LINES;
+    bool recording = false;
+
+    PackedVertex current = { 0.0f, 0.0f, 255, 255, 255, 255 };
+    float lineWidth = 1.0f;
+
+    GLuint vbo = 0;
+    bool uploaded = false;
+};
@@ -0,0 +1,193 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "Headless.h"
+#include "GLExtensions.h"
+#include "ImageWriter.h"
+#include "VectorExport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+OffscreenContext::~OffscreenContext() {
+    if (!window)
+        return;
+
+    const GLExtensions& ext = glExtensions();
+    if (framebuffer != 0) {
+        ext.BindFramebuffer(GL_FRAMEBUFFER, 0);
+        ext.DeleteFramebuffers(1, &framebuffer);
+    }
+    if (colorbuffer != 0)
+        ext.DeleteRenderbuffers(1, &colorbuffer);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+}
+
+bool OffscreenContext::Create(int w, int h, bool software) {
+    width = w;
+    height = h;
+
+    if (software)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (!glfwInit()) {
+        std::fprintf(stderr, "offscreen: could not initialise GLFW\n");
+        return false;
+    }
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (software)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+
+    window = glfwCreateWindow(width, height, "Architecture Views (offscreen)", NULL, NULL);
+    if (!window) {
+        std::fprintf(stderr, "offscreen: could not create a GL context%s\n",
+            software ? " (is the OSMesa library available?)" : "");
+        glfwTerminate();
+        return false;
+    }
+    glfwMakeContextCurrent(window);
+
+    const GLExtensions& ext = glExtensions();
+    if (ext.hasFramebuffers) {
+        ext.GenRenderbuffers(1, &colorbuffer);
+        ext.BindRenderbuffer(GL_RENDERBUFFER, colorbuffer);
+        ext.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+        ext.GenFramebuffers(1, &framebuffer);
+        ext.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        ext.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorbuffer);
+        if (ext.CheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            ext.BindFramebuffer(GL_FRAMEBUFFER, 0);
+            ext.DeleteFramebuffers(1, &framebuffer);
+            ext.DeleteRenderbuffers(1, &colorbuffer);
+            framebuffer = colorbuffer = 0;
+        }
+    }
+    if (framebuffer == 0) {
+        // The hidden window's back buffer is sized to the request
+        glReadBuffer(GL_BACK);
+    }
+
+    readback.resize((size_t)width * height * 3);
+    return true;
+}
+
+void OffscreenContext::BeginFrame() {
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void OffscreenContext::Finish() {
+    glFinish();
+}
+
+void OffscreenContext::ReadPixels(std::vector<unsigned char>& image) {
+    // GL reads bottom-up; flip while copying so the image is top-down
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, readback.data());
+
+    size_t rowBytes = (size_t)width * 3;
+    image.resize(readback.size());
+    for (int y = 0; y < height; ++y)
+        std::memcpy(&image[rowBytes * y], &readback[rowBytes * (height - 1 - y)], rowBytes);
+}
+
+RasterTarget::RasterTarget(ThreadPool& pool, int width, int height) : rasterizer(pool) {
+    rasterizer.Resize(width, height);
+    setRenderBackend(&rasterizer);
+}
+
+RasterTarget::~RasterTarget() {
+    setRenderBackend(nullptr);
+}
+
+void RasterTarget::BeginFrame() {
+    rasterizer.BeginFrame(0.0f, 0.0f, 0.0f);
+}
+
+void RasterTarget::Finish() {
+    rasterizer.Finish();
+}
+
+void RasterTarget::ReadPixels(std::vector<unsigned char>& image) {
+    rasterizer.ReadPixels(image);
+}
+
+std::unique_ptr<FrameTarget> createFrameTarget(const CommandLine& options, ThreadPool& pool) {
+    if (options.backend == Backend::CPU)
+        return std::unique_ptr<FrameTarget>(new RasterTarget(pool, options.width, options.height));
+
+    OffscreenContext* context = new OffscreenContext();
+    std::unique_ptr<FrameTarget> target(context);
+    if (!context->Create(options.width, options.height, options.software))
+        return nullptr;
+    return target;
+}
+
+std::vector<RenderJob> selectRenderJobs(const CommandLine& options, const std::vector<SheetView>& views) {
+    std::vector<RenderJob> jobs;
+
+    for (const SheetView& view : views) {
+        if (options.view == "all" || options.view == view.name)
+            jobs.push_back({ view.name, { &view }, view.zoom, view.centerX, view.centerY });
+    }
+    if (options.view == "sheet") {
+        // The whole sheet: floor plan with the four elevations around it
+        RenderJob sheet = { "sheet", {}, 58.0f, -3.0f, 1.0f };
+        for (const SheetView& view : views)
+            sheet.drawList.push_back(&view);
+        jobs.push_back(sheet);
+    }
+
+    if (options.customCamera) {
+        for (RenderJob& job : jobs) {
+            job.zoom = options.zoom;
+            job.scrollX = options.scrollX;
+            job.scrollY = options.scrollY;
+        }
+    }
+    return jobs;
+}
+
+int runHeadless(const CommandLine& options, const std::vector<SheetView>& views, ThreadPool& pool) {
+    if (options.vectorExport)
+        return runVectorExport(options, views);
+
+    std::vector<RenderJob> jobs = selectRenderJobs(options, views);
+    if (jobs.empty()) {
+        std::fprintf(stderr, "headless: unknown view '%s'\n", options.view.c_str());
+        printUsage();
+        return -1;
+    }
+
+    std::unique_ptr<FrameTarget> target = createFrameTarget(options, pool);
+    if (!target)
+        return -1;
+
+    int exitCode = 0;
+    std::vector<unsigned char> image;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const RenderJob& job : jobs) {
+        target->BeginFrame();
+        loadSheetCamera(job.zoom, job.scrollX, job.scrollY);
+        for (const SheetView* view : job.drawList)
+            drawSheetView(*view);
+        target->ReadPixels(image);
+
+        std::string path = options.outputDir + "/" + job.name + "." + imageExtension(options.format);
+        if (!writeImage(path, options.format, target->Width(), target->Height(), image.data())) {
+            std::fprintf(stderr, "headless: could not write %s\n", path.c_str());
+            exitCode = -1;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("headless: wrote %d image(s) at %dx%d in %.3f s (%.1f frames/s)\n",
+        (int)jobs.size(), target->Width(), target->Height(), seconds,
+        seconds > 0.0 ? jobs.size() / seconds : 0.0);
+    return exitCode;
+}
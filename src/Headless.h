@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CommandLine.h"
+#include "SheetView.h"
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+
+struct GLFWwindow;
+
+// ------------------ Headless rendering ------------------
+
+// Where headless and benchmark frames are drawn
+class FrameTarget {
+public:
+    virtual ~FrameTarget() {}
+
+    // Clears the target and sets the viewport for a new frame
+    virtual void BeginFrame() = 0;
+
+    // Returns once the frame's drawing has completed
+    virtual void Finish() = 0;
+
+    // Copies the frame into 'image' as top-down 8-bit RGB
+    virtual void ReadPixels(std::vector<unsigned char>& image) = 0;
+
+    virtual int Width() const = 0;
+    virtual int Height() const = 0;
+};
+
+// Hidden GLFW window with a colour framebuffer object bound as the render
+// target. When FBOs are not available the window's own back buffer is used.
+// With 'software' set, GLFW's null platform and an OSMesa context are used,
+// so neither a display nor a GPU is required.
+class OffscreenContext : public FrameTarget {
+public:
+    OffscreenContext() = default;
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    bool Create(int width, int height, bool software);
+
+    void BeginFrame() override;
+    void Finish() override;
+    void ReadPixels(std::vector<unsigned char>& image) override;
+
+    int Width() const override { return width; }
+    int Height() const override { return height; }
+
+private:
+    GLFWwindow* window = nullptr;
+    unsigned int framebuffer = 0;
+    unsigned int colorbuffer = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> readback;
+};
+
+// The CPU rasterizer as a target. It is the active render backend for as
+// long as it exists; no GL context is created.
+class RasterTarget : public FrameTarget {
+public:
+    RasterTarget(ThreadPool& pool, int width, int height);
+    ~RasterTarget();
+
+    RasterTarget(const RasterTarget&) = delete;
+    RasterTarget& operator=(const RasterTarget&) = delete;
+
+    void BeginFrame() override;
+    void Finish() override;
+    void ReadPixels(std::vector<unsigned char>& image) override;
+
+    int Width() const override { return rasterizer.Width(); }
+    int Height() const override { return rasterizer.Height(); }
+
+private:
+    SoftwareRasterizer rasterizer;
+};
+
+// Creates the target --backend asks for. Returns null (after printing why)
+// when it cannot be created.
+std::unique_ptr<FrameTarget> createFrameTarget(const CommandLine& options, ThreadPool& pool);
+
+// One image to render: the views to draw and the camera to draw them with
+struct RenderJob {
+    std::string name;
+    std::vector<const SheetView*> drawList;
+    float zoom;
+    double scrollX, scrollY;
+};
+
+// Expands --view (a view name, "all" or "sheet") and the camera options into jobs
+std::vector<RenderJob> selectRenderJobs(const CommandLine& options, const std::vector<SheetView>& views);
+
+// Renders the selected views offscreen and writes one image per view, or
+// with a vector --format one drawing file per view (see VectorExport.h).
+// Returns the process exit code.
+int runHeadless(const CommandLine& options, const std::vector<SheetView>& views, ThreadPool& pool);
@@ -0,0 +1,171 @@
+#include "ImageWriter.h"
+
+#include <cstdint>
+#include <cstdio>
+
+bool writePPM(const std::string& path, int width, int height, const unsigned char* rgb) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    size_t bytes = (size_t)width * height * 3;
+    bool ok = std::fwrite(rgb, 1, bytes, file) == bytes;
+    return std::fclose(file) == 0 && ok;
+}
+
+// ------------------ PNG ------------------
+
+struct CrcTable {
+    uint32_t entries[256];
+};
+
+// Built on first use; the static's initialisation is thread-safe, so
+// batch writers on several threads share it
+static const CrcTable& crcTable() {
+    static const CrcTable table = [] {
+        CrcTable t;
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+            t.entries[n] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+static uint32_t updateCrc(uint32_t crc, const unsigned char* data, size_t length) {
+    const uint32_t* table = crcTable().entries;
+    for (size_t i = 0; i < length; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+// Streams one PNG chunk while keeping its running CRC
+class PngChunkWriter {
+public:
+    PngChunkWriter(FILE* file, const char* type, uint32_t length) : file(file) {
+        unsigned char header[8] = {
+            (unsigned char)(length >> 24), (unsigned char)(length >> 16),
+            (unsigned char)(length >> 8), (unsigned char)length,
+            (unsigned char)type[0], (unsigned char)type[1], (unsigned char)type[2], (unsigned char)type[3]
+        };
+        ok = std::fwrite(header, 1, 8, file) == 8;
+        crc = updateCrc(0xFFFFFFFFu, header + 4, 4);
+    }
+
+    void Write(const unsigned char* data, size_t length) {
+        crc = updateCrc(crc, data, length);
+        ok &= std::fwrite(data, 1, length, file) == length;
+    }
+
+    bool Finish() {
+        uint32_t value = crc ^ 0xFFFFFFFFu;
+        unsigned char trailer[4] = {
+            (unsigned char)(value >> 24), (unsigned char)(value >> 16),
+            (unsigned char)(value >> 8), (unsigned char)value
+        };
+        ok &= std::fwrite(trailer, 1, 4, file) == 4;
+        return ok;
+    }
+
+private:
+    FILE* file;
+    uint32_t crc;
+    bool ok;
+};
+
+bool writePNG(const std::string& path, int width, int height, const unsigned char* rgb) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    static const unsigned char signature[8] = { 137, 'P', 'N', 'G', '\r', '\n', 26, '\n' };
+    bool ok = std::fwrite(signature, 1, 8, file) == 8;
+
+    // IHDR: 8-bit truecolour, no interlacing
+    unsigned char ihdr[13] = {
+        (unsigned char)(width >> 24), (unsigned char)(width >> 16), (unsigned char)(width >> 8), (unsigned char)width,
+        (unsigned char)(height >> 24), (unsigned char)(height >> 16), (unsigned char)(height >> 8), (unsigned char)height,
+        8, 2, 0, 0, 0
+    };
+    PngChunkWriter header(file, "IHDR", 13);
+    header.Write(ihdr, 13);
+    ok &= header.Finish();
+
+    // IDAT: zlib stream of stored deflate blocks, each row prefixed with filter type 0
+    const size_t rowBytes = (size_t)width * 3;
+    const size_t rawBytes = (rowBytes + 1) * height;
+    const size_t maxBlock = 65535;
+    const size_t blocks = rawBytes == 0 ? 1 : (rawBytes + maxBlock - 1) / maxBlock;
+    const uint32_t idatLength = (uint32_t)(2 + blocks * 5 + rawBytes + 4);
+
+    PngChunkWriter idat(file, "IDAT", idatLength);
+    const unsigned char zlibHeader[2] = { 0x78, 0x01 };
+    idat.Write(zlibHeader, 2);
+
+    uint32_t adlerA = 1, adlerB = 0;
+    size_t blockLeft = 0;
+    size_t written = 0;
+    auto writeRaw = [&](const unsigned char* data, size_t length) {
+        while (length > 0) {
+            if (blockLeft == 0) {
+                size_t size = rawBytes - written < maxBlock ? rawBytes - written : maxBlock;
+                bool last = written + size == rawBytes;
+                unsigned char blockHeader[5] = {
+                    (unsigned char)(last ? 1 : 0),
+                    (unsigned char)(size & 0xFF), (unsigned char)(size >> 8),
+                    (unsigned char)(~size & 0xFF), (unsigned char)((~size >> 8) & 0xFF)
+                };
+                idat.Write(blockHeader, 5);
+                blockLeft = size;
+            }
+            size_t chunk = length < blockLeft ? length : blockLeft;
+            idat.Write(data, chunk);
+            // Defer the modulo: 5552 bytes is the most that cannot overflow 32 bits
+            for (size_t i = 0; i < chunk; ) {
+                size_t run = chunk - i < 5552 ? chunk - i : 5552;
+                for (size_t end = i + run; i < end; ++i) {
+                    adlerA += data[i];
+                    adlerB += adlerA;
+                }
+                adlerA %= 65521u;
+                adlerB %= 65521u;
+            }
+            data += chunk;
+            length -= chunk;
+            blockLeft -= chunk;
+            written += chunk;
+        }
+    };
+
+    const unsigned char filterNone = 0;
+    for (int y = 0; y < height; ++y) {
+        writeRaw(&filterNone, 1);
+        writeRaw(rgb + rowBytes * y, rowBytes);
+    }
+
+    unsigned char adler[4] = {
+        (unsigned char)(adlerB >> 8), (unsigned char)adlerB,
+        (unsigned char)(adlerA >> 8), (unsigned char)adlerA
+    };
+    idat.Write(adler, 4);
+    ok &= idat.Finish();
+
+    PngChunkWriter end(file, "IEND", 0);
+    ok &= end.Finish();
+
+    return std::fclose(file) == 0 && ok;
+}
+
+bool writeImage(const std::string& path, ImageFormat format, int width, int height, const unsigned char* rgb) {
+    if (format == ImageFormat::PNG)
+        return writePNG(path, width, height, rgb);
+    return writePPM(path, width, height, rgb);
+}
+
+const char* imageExtension(ImageFormat format) {
+    return format == ImageFormat::PNG ? "png" : "ppm";
+}
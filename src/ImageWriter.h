@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+enum class ImageFormat {
+    PPM,
+    PNG
+};
+
+// Writes an 8-bit RGB image whose rows are stored top to bottom.
+// PNG output uses stored (uncompressed) deflate blocks: larger files, but
+// no compression cost when exporting many frames.
+bool writePPM(const std::string& path, int width, int height, const unsigned char* rgb);
+bool writePNG(const std::string& path, int width, int height, const unsigned char* rgb);
+bool writeImage(const std::string& path, ImageFormat format, int width, int height, const unsigned char* rgb);
+
+// File extension without the dot ("ppm" / "png")
+const char* imageExtension(ImageFormat format);
@@ -0,0 +1,4 @@
+#include "ImmediateMode.h"
+
+RenderStats renderStats;
+float trackedLineWidth = 1.0f;
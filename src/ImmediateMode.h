@@ -0,0 +1,98 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+
+#include "Culling.h"
+#include "RenderBackend.h"
+#include "RenderOrigin.h"
+
+// ------------------ Immediate-mode submission ------------------
+// The drawing helpers go through these thin wrappers instead of calling
+// glBegin/glVertex2f/... directly, so every draw call and vertex handed to
+// the driver is counted, whether it comes from immediate mode or from a
+// GeometryBuffer replay, together with the state changes around them. The
+// calls themselves go to the active render backend.
+
+struct RenderStats {
+    long long drawCalls = 0;            // glBegin blocks and glDrawArrays calls
+    long long vertices = 0;             // vertices submitted
+    long long stateChanges = 0;         // colour, line width, enable/disable and blend calls
+    long long lineWidthSwitches = 0;    // glLineWidth calls that change the width
+
+    void Reset() { *this = RenderStats(); }
+
+    RenderStats& operator+=(const RenderStats& other) {
+        drawCalls += other.drawCalls;
+        vertices += other.vertices;
+        stateChanges += other.stateChanges;
+        lineWidthSwitches += other.lineWidthSwitches;
+        return *this;
+    }
+};
+
+extern RenderStats renderStats;
+
+// Last width handed to glLineWidth; GL keeps it across frames, so it is not
+// part of the resettable counters
+extern float trackedLineWidth;
+
+inline void imBegin(GLenum mode) {
+    ++renderStats.drawCalls;
+    if (boundsCapture.active)
+        boundsCapture.LoadModelview(); // the matrix cannot change inside glBegin/glEnd
+    renderBackend().Begin(mode);
+}
+
+inline void imEnd() {
+    renderBackend().End();
+}
+
+// Takes world coordinates and submits them in render space. They are
+// doubles so a caller far from the world origin keeps its precision until
+// the render origin is subtracted; floats convert exactly.
+inline void imVertex2f(double x, double y) {
+    ++renderStats.vertices;
+    if (boundsCapture.active)
+        boundsCapture.AddVertex((float)x, (float)y);
+    renderBackend().Vertex2f(toRenderX(x), toRenderY(y));
+}
+
+inline void imColor3f(float r, float g, float b) {
+    ++renderStats.stateChanges;
+    renderBackend().Color4f(r, g, b, 1.0f);
+}
+
+inline void imColor4f(float r, float g, float b, float a) {
+    ++renderStats.stateChanges;
+    renderBackend().Color4f(r, g, b, a);
+}
+
+inline void imLineWidth(float width) {
+    ++renderStats.stateChanges;
+    if (width != trackedLineWidth) {
+        ++renderStats.lineWidthSwitches;
+        trackedLineWidth = width;
+    }
+    renderBackend().LineWidth(width);
+}
+
+inline void imEnable(GLenum cap) {
+    ++renderStats.stateChanges;
+    renderBackend().Enable(cap);
+}
+
+inline void imDisable(GLenum cap) {
+    ++renderStats.stateChanges;
+    renderBackend().Disable(cap);
+}
+
+inline void imBlendFunc(GLenum source, GLenum destination) {
+    ++renderStats.stateChanges;
+    renderBackend().BlendFunc(source, destination);
+}
+
+inline void imHint(GLenum target, GLenum mode) {
+    ++renderStats.stateChanges;
+    renderBackend().Hint(target, mode);
+}
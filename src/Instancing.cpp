@@ -0,0 +1,105 @@
+#include "Instancing.h"
+#include "Fixtures.h"
+#include "Lod.h"
+
+#include <cmath>
+
+const float kFixtureLevelPixels[kFixtureDetailLevels - 1] = { 8.0f, 30.0f };
+
+static void buildTemplate(FixtureType type, int level, GeometryBuffer& out) {
+    // Largest size the level is shown at; the full level keeps the drawing's own counts
+    float pixels = level < kFixtureDetailLevels - 1 ? kFixtureLevelPixels[level] : 1e6f;
+
+    switch (type) {
+    case FixtureType::Toilet:
+        Toilet(circleSegments(0.2f * pixels, 4, 16), circleSegments(0.12f * pixels, 4, 12)).Draw(out, 0.0f, 0.0f, 0.0f);
+        break;
+    case FixtureType::FireExtinguisher:
+        FireExtinguisher(circleSegments(0.15f * pixels, 4, 12)).Draw(out, 0.0f, 0.0f);
+        break;
+    case FixtureType::Bin:              Bin().Draw(out, 0.0f, 0.0f); break;
+    case FixtureType::DiningTable:      DiningTable().Draw(out, 0.0f, 0.0f); break;
+    case FixtureType::Chair:            Chair().Draw(out, 0.0f, 0.0f); break;
+    default: break;
+    }
+}
+
+// Every template, built together on first use (thread-safe static init).
+// They are never drawn directly, so they never own a GL buffer.
+struct FixtureTemplates {
+    GeometryBuffer meshes[kFixtureDetailLevels][(int)FixtureType::Count];
+
+    FixtureTemplates() {
+        for (int level = 0; level < kFixtureDetailLevels; ++level) {
+            for (int type = 0; type < (int)FixtureType::Count; ++type)
+                buildTemplate((FixtureType)type, level, meshes[level][type]);
+        }
+    }
+};
+
+const GeometryBuffer& fixtureTemplate(FixtureType type, int level) {
+    static const FixtureTemplates templates;
+    return templates.meshes[level][(int)type];
+}
+
+// Quarter turns come out exact so axis-aligned fixtures stay on the grid
+static void rotation(float degrees, float& c, float& s) {
+    float turns = degrees / 90.0f;
+    float quarter = std::floor(turns + 0.5f);
+    if (std::fabs(turns - quarter) < 1e-6f) {
+        static const float kCos[4] = { 1.0f, 0.0f, -1.0f, 0.0f };
+        static const float kSin[4] = { 0.0f, 1.0f, 0.0f, -1.0f };
+        int q = ((int)quarter % 4 + 4) % 4;
+        c = kCos[q];
+        s = kSin[q];
+        return;
+    }
+    float radians = degrees * (3.14159265358979323846f / 180.0f);
+    c = std::cos(radians);
+    s = std::sin(radians);
+}
+
+void FixtureInstances::Add(FixtureType type, const FixtureInstance& instance) {
+    instances[(int)type].push_back(instance);
+}
+
+void FixtureInstances::Clear() {
+    for (std::vector<FixtureInstance>& list : instances)
+        list.clear();
+}
+
+size_t FixtureInstances::Count() const {
+    size_t count = 0;
+    for (const std::vector<FixtureInstance>& list : instances)
+        count += list.size();
+    return count;
+}
+
+void FixtureInstances::Expand(GeometryBuffer& out) const {
+    for (int type = 0; type < (int)FixtureType::Count; ++type)
+        Expand((FixtureType)type, out);
+}
+
+void FixtureInstances::Expand(FixtureType type, GeometryBuffer& out, int level) const {
+    const std::vector<FixtureInstance>& list = instances[(int)type];
+    if (list.empty())
+        return;
+
+    const GeometryBuffer& mesh = fixtureTemplate(type, level);
+    for (const FixtureInstance& instance : list)
+        out.AppendTransformed(mesh, instancePlacement(instance));
+}
+
+Affine2D instancePlacement(const FixtureInstance& instance) {
+    float c, s;
+    rotation(instance.orientation, c, s);
+
+    Affine2D m;
+    m.a = c * instance.scale;
+    m.b = s * instance.scale;
+    m.c = -s * instance.scale;
+    m.d = c * instance.scale;
+    m.tx = instance.x;
+    m.ty = instance.y;
+    return m;
+}
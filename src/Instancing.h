@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "GeometryBuffer.h"
+
+// ------------------ Fixture instancing ------------------
+// Every fixture type is tessellated once, at the origin with its default
+// orientation and size, into a template mesh. A plan only stores where the
+// copies go; Expand() stamps the template at each placement with a plain
+// affine transform, so no circle or arc is ever recomputed per copy.
+//
+// The fixed-function pipeline has no per-instance attributes, so instances
+// are expanded into the caller's retained buffer rather than drawn with
+// glDrawArraysInstanced; the result is still one draw call per fixture
+// type (or for the whole plan), and it is only redone when the placements
+// or the detail level change.
+//
+// Templates come in kFixtureDetailLevels versions, coarsest first. Level i
+// is meant for plans shown at fewer than kFixtureLevelPixels[i] pixels per
+// unit, and its circles are tessellated for exactly that size; the last
+// level is the full drawing.
+
+enum class FixtureType {
+    Toilet,
+    FireExtinguisher,
+    Bin,
+    DiningTable,
+    Chair,
+    Count
+};
+
+constexpr int kFixtureDetailLevels = 3;
+extern const float kFixtureLevelPixels[kFixtureDetailLevels - 1];
+
+struct FixtureInstance {
+    float x, y;
+    float orientation;  // degrees, counter-clockwise
+    float scale;
+};
+
+class FixtureInstances {
+public:
+    void Add(FixtureType type, const FixtureInstance& instance);
+    void Clear();
+
+    size_t Count() const;
+    const std::vector<FixtureInstance>& Instances(FixtureType type) const { return instances[(int)type]; }
+
+    // Appends one transformed copy of the template per instance to 'out'
+    void Expand(GeometryBuffer& out) const;
+    void Expand(FixtureType type, GeometryBuffer& out, int level = kFixtureDetailLevels - 1) const;
+
+private:
+    std::vector<FixtureInstance> instances[(int)FixtureType::Count];
+};
+
+// Rotation, scale and position of one instance's copy of the template
+Affine2D instancePlacement(const FixtureInstance& instance);
+
+// Template mesh of a fixture type at a detail level, built on first use
+const GeometryBuffer& fixtureTemplate(FixtureType type, int level = kFixtureDetailLevels - 1);
@@ -0,0 +1,136 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "LineBatch.h"
+#include "VertexStream.h"
+#include "GLExtensions.h"
+#include "ImmediateMode.h"
+
+#include <cstddef>
+
+LineBatch::~LineBatch() {
+    // The buffer object dies with the context, so only free it while one is current
+    if (vbo != 0 && glfwGetCurrentContext() != nullptr)
+        glExtensions().DeleteBuffers(1, &vbo);
+}
+
+LineBatch::LineClass& LineBatch::ClassFor(const LineStyle& style) {
+    // A drawing only uses a handful of classes, so a linear search is enough
+    for (LineClass& lineClass : classes) {
+        if (lineClass.style == style)
+            return lineClass;
+    }
+    classes.push_back({ style, {}, 0 });
+    return classes.back();
+}
+
+void LineBatch::SetAnchor(double x, double y) {
+    anchor = { x, y };
+    uploaded = false;
+}
+
+void LineBatch::Add(const LineStyle& style, double x1, double y1, double x2, double y2) {
+    float ax = (float)(x1 - anchor.x), ay = (float)(y1 - anchor.y);
+    float bx = (float)(x2 - anchor.x), by = (float)(y2 - anchor.y);
+    std::vector<float>& positions = ClassFor(style).positions;
+    positions.push_back(ax);
+    positions.push_back(ay);
+    positions.push_back(bx);
+    positions.push_back(by);
+    ++lineCount;
+    bounds.Add(ax, ay);
+    bounds.Add(bx, by);
+    uploaded = false;
+}
+
+Bounds LineBatch::WorldBounds() const {
+    if (!bounds.Valid())
+        return bounds;
+    Bounds world;
+    world.Add((float)(bounds.minX + anchor.x), (float)(bounds.minY + anchor.y));
+    world.Add((float)(bounds.maxX + anchor.x), (float)(bounds.maxY + anchor.y));
+    return world;
+}
+
+void LineBatch::Clear() {
+    classes.clear();
+    packed.clear();
+    lineCount = 0;
+    bounds = Bounds();
+    anchor = { 0.0, 0.0 };
+    uploaded = false;
+}
+
+void LineBatch::Pack() {
+    packed.clear();
+    packed.reserve(lineCount * 4);
+    for (LineClass& lineClass : classes) {
+        lineClass.first = (GLint)(packed.size() / 2);
+        packed.insert(packed.end(), lineClass.positions.begin(), lineClass.positions.end());
+    }
+    // The anchor's offset from the render origin is taken in double precision
+    float dx = (float)(anchor.x - renderOrigin.x), dy = (float)(anchor.y - renderOrigin.y);
+    if (dx != 0.0f || dy != 0.0f)
+        translatePairs(packed.data(), packed.size() / 2, dx, dy);
+    packedOrigin = renderOrigin;
+}
+
+void LineBatch::Draw() {
+    if (lineCount == 0)
+        return;
+
+    if (boundsCapture.active) {
+        boundsCapture.LoadModelview();
+        boundsCapture.AddLocal(WorldBounds());
+    }
+
+    if (packedOrigin.x != renderOrigin.x || packedOrigin.y != renderOrigin.y)
+        uploaded = false;
+
+    if (!renderBackend().UsesOpenGL()) {
+        if (!uploaded) {
+            Pack();
+            uploaded = true;
+        }
+        for (const LineClass& lineClass : classes) {
+            const LineStyle& style = lineClass.style;
+            imColor3f(style.r, style.g, style.b);
+            imLineWidth(style.width);
+            renderBackend().DrawLines(packed.data(), (size_t)lineClass.first / 2, lineClass.positions.size() / 4);
+        }
+        renderStats.drawCalls += (long long)classes.size();
+        renderStats.vertices += (long long)lineCount * 2;
+        return;
+    }
+
+    const GLExtensions& ext = glExtensions();
+    if (!uploaded) {
+        Pack();
+        if (ext.hasBuffers) {
+            if (vbo == 0)
+                ext.GenBuffers(1, &vbo);
+            ext.BindBuffer(GL_ARRAY_BUFFER, vbo);
+            ext.BufferData(GL_ARRAY_BUFFER, (std::ptrdiff_t)(packed.size() * sizeof(float)),
+                packed.data(), GL_STATIC_DRAW);
+        }
+        uploaded = true;
+    }
+    else if (ext.hasBuffers) {
+        ext.BindBuffer(GL_ARRAY_BUFFER, vbo);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, ext.hasBuffers ? nullptr : packed.data());
+
+    for (const LineClass& lineClass : classes) {
+        const LineStyle& style = lineClass.style;
+        imColor3f(style.r, style.g, style.b);
+        imLineWidth(style.width);
+        glDrawArrays(GL_LINES, lineClass.first, (GLsizei)(lineClass.positions.size() / 2));
+    }
+    renderStats.drawCalls += (long long)classes.size();
+    renderStats.vertices += (long long)lineCount * 2;
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (ext.hasBuffers)
+        ext.BindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <vector>
+
+#include "Culling.h"
+#include "RenderOrigin.h"
+
+// Colour and width shared by every line of a class
+struct LineStyle {
+    float r, g, b;
+    float width;
+
+    bool operator==(const LineStyle& other) const {
+        return r == other.r && g == other.g && b == other.b && width == other.width;
+    }
+};
+
+// Collects many independent line segments and sorts them by style, so they
+// are drawn with one glDrawArrays(GL_LINES) per colour/width class instead
+// of one glBegin/glEnd pair per segment. Only positions are stored (8 bytes
+// per vertex); the colour is set once per class. Classes are drawn in the
+// order they were first used, so a shadow class added before its highlight
+// class stays underneath it.
+class LineBatch {
+public:
+    LineBatch() = default;
+    ~LineBatch();
+
+    LineBatch(const LineBatch&) = delete;
+    LineBatch& operator=(const LineBatch&) = delete;
+
+    // World position the lines are stored relative to, as in a
+    // GeometryBuffer: the positions stay small floats wherever the drawing
+    // sits. Set it before adding lines. Defaults to the world origin.
+    void SetAnchor(double x, double y);
+    const WorldPoint& Anchor() const { return anchor; }
+
+    // Takes world coordinates; they are kept relative to the anchor
+    void Add(const LineStyle& style, double x1, double y1, double x2, double y2);
+
+    // Drops all lines and the anchor; the GPU copy is refreshed on the next Draw()
+    void Clear();
+
+    bool Empty() const { return lineCount == 0; }
+    size_t LineCount() const { return lineCount; }
+
+    // Box around every line relative to the anchor, and the same box moved to it
+    const Bounds& LocalBounds() const { return bounds; }
+    Bounds WorldBounds() const;
+
+    // Uploads the lines in render space (VBO when available, client arrays
+    // otherwise) and issues one glDrawArrays per class. The upload is redone
+    // only after lines were added or the render origin moved.
+    void Draw();
+
+private:
+    struct LineClass {
+        LineStyle style;
+        std::vector<float> positions;   // x, y pairs; two vertices per line
+        GLint first;                    // offset in 'packed' after the last upload
+    };
+
+    LineClass& ClassFor(const LineStyle& style);
+    void Pack();
+
+    std::vector<LineClass> classes;
+    WorldPoint anchor = { 0.0, 0.0 };
+    std::vector<float> packed;          // every class back to back, in render space
+    WorldPoint packedOrigin = { 0.0, 0.0 };
+    size_t lineCount = 0;
+    Bounds bounds;
+
+    GLuint vbo = 0;
+    bool uploaded = false;
+};
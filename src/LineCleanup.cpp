@@ -0,0 +1,269 @@
+#include "LineCleanup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <utility>
+
+void IndexedLines::Clear() {
+    vertices.clear();
+    indices.clear();
+    sources.clear();
+}
+
+struct GridPoint {
+    long long x, y;
+
+    bool operator==(const GridPoint& other) const { return x == other.x && y == other.y; }
+};
+
+static std::uint32_t packedColor(const PackedVertex& v) {
+    return v.r | (std::uint32_t)v.g << 8 | (std::uint32_t)v.b << 16 | (std::uint32_t)v.a << 24;
+}
+
+static bool opaque(std::uint32_t color) {
+    return (color >> 24) == 0xff;
+}
+
+static long long greatestDivisor(long long a, long long b) {
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+    while (b != 0) {
+        long long r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// Snapped segment as it will be written out
+struct GridSegment {
+    GridPoint a, b;
+    std::uint32_t colorA, colorB;
+    unsigned source;
+};
+
+// Opaque flat segment taking part in the overlap pass. Its line is the
+// direction reduced by the gcd and turned to point right (or straight up),
+// and the cross product of that direction with any point of the line; t0 < t1
+// are its ends projected on the direction. All exact, so segments on one
+// line compare equal.
+struct LinePiece {
+    long long dx, dy, offset;
+    long long t0, t1;
+    GridPoint p0, p1;           // the ends at t0 and t1
+    std::uint32_t color;
+    unsigned source;
+};
+
+static bool sameLine(const LinePiece& a, const LinePiece& b) {
+    return a.dx == b.dx && a.dy == b.dy && a.offset == b.offset;
+}
+
+// End of a piece during the sweep along its line
+struct PieceEvent {
+    long long t;
+    GridPoint point;
+    size_t piece;
+    bool start;
+};
+
+// Cuts the pieces [first, last) of one line where they overlap and appends
+// the visible stretches, joined by colour, to 'out'. Returns how many pieces
+// have no visible stretch.
+static size_t resolveLine(const std::vector<LinePiece>& pieces, size_t first, size_t last,
+    std::vector<PieceEvent>& events, std::vector<GridSegment>& out) {
+    if (last - first == 1) {
+        const LinePiece& piece = pieces[first];
+        out.push_back({ piece.p0, piece.p1, piece.color, piece.color, piece.source });
+        return 0;
+    }
+
+    events.clear();
+    for (size_t i = first; i < last; ++i) {
+        events.push_back({ pieces[i].t0, pieces[i].p0, i, true });
+        events.push_back({ pieces[i].t1, pieces[i].p1, i, false });
+    }
+    std::sort(events.begin(), events.end(),
+        [](const PieceEvent& a, const PieceEvent& b) { return a.t < b.t; });
+
+    // Pieces covering the current stretch by source order; the last one
+    // drawn is on top
+    std::set<std::pair<unsigned, size_t>> covering;
+    std::vector<bool> seen(last - first, false);
+
+    bool open = false;
+    GridSegment run = {};
+    for (size_t e = 0; e < events.size();) {
+        long long t = events[e].t;
+        GridPoint point = events[e].point;
+        for (; e < events.size() && events[e].t == t; ++e) {
+            const LinePiece& piece = pieces[events[e].piece];
+            if (events[e].start)
+                covering.insert({ piece.source, events[e].piece });
+            else
+                covering.erase({ piece.source, events[e].piece });
+        }
+
+        // The stretch from here to the next event
+        if (covering.empty()) {
+            if (open) {
+                run.b = point;
+                out.push_back(run);
+                open = false;
+            }
+            continue;
+        }
+        size_t top = covering.rbegin()->second;
+        seen[top - first] = true;
+        const LinePiece& piece = pieces[top];
+        if (open && run.colorA == piece.color) {
+            run.source = std::min(run.source, piece.source);
+            continue;
+        }
+        if (open) {
+            run.b = point;
+            out.push_back(run);
+        }
+        run.a = point;
+        run.colorA = run.colorB = piece.color;
+        run.source = piece.source;
+        open = true;
+    }
+    return (size_t)std::count(seen.begin(), seen.end(), false);
+}
+
+// Segment end waiting to be welded: grid position, colour and its slot in
+// the index list
+struct WeldEnd {
+    long long x, y;
+    std::uint32_t color;
+    unsigned slot;
+};
+
+static bool weldOrder(const WeldEnd& a, const WeldEnd& b) {
+    if (a.x != b.x)
+        return a.x < b.x;
+    if (a.y != b.y)
+        return a.y < b.y;
+    if (a.color != b.color)
+        return a.color < b.color;
+    return a.slot < b.slot;
+}
+
+LineCleanupStats cleanupLines(const std::vector<LineSegment>& segments, float snap, IndexedLines& out) {
+    LineCleanupStats stats;
+    stats.segmentsIn = segments.size();
+    stats.verticesIn = segments.size() * 2;
+    out.Clear();
+
+    const double step = snap;
+    auto toGrid = [step](const PackedVertex& v) {
+        return GridPoint{ std::llround(v.x / step), std::llround(v.y / step) };
+    };
+
+    std::vector<GridSegment> kept;
+    std::vector<LinePiece> pieces;
+    kept.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        GridPoint a = toGrid(segments[i].a), b = toGrid(segments[i].b);
+        if (a == b) {
+            ++stats.zeroLength;
+            continue;
+        }
+        std::uint32_t colorA = packedColor(segments[i].a), colorB = packedColor(segments[i].b);
+        if (colorA != colorB || !opaque(colorA)) {
+            kept.push_back({ a, b, colorA, colorB, (unsigned)i });
+            continue;
+        }
+
+        LinePiece piece;
+        long long dx = b.x - a.x, dy = b.y - a.y;
+        long long divisor = greatestDivisor(dx, dy);
+        dx /= divisor;
+        dy /= divisor;
+        if (dx < 0 || (dx == 0 && dy < 0)) {
+            dx = -dx;
+            dy = -dy;
+        }
+        piece.dx = dx;
+        piece.dy = dy;
+        piece.offset = dx * a.y - dy * a.x;
+        piece.t0 = dx * a.x + dy * a.y;
+        piece.t1 = dx * b.x + dy * b.y;
+        piece.p0 = a;
+        piece.p1 = b;
+        if (piece.t1 < piece.t0) {
+            std::swap(piece.t0, piece.t1);
+            std::swap(piece.p0, piece.p1);
+        }
+        piece.color = colorA;
+        piece.source = (unsigned)i;
+        pieces.push_back(piece);
+    }
+
+    std::sort(pieces.begin(), pieces.end(), [](const LinePiece& a, const LinePiece& b) {
+        if (a.dx != b.dx)
+            return a.dx < b.dx;
+        if (a.dy != b.dy)
+            return a.dy < b.dy;
+        if (a.offset != b.offset)
+            return a.offset < b.offset;
+        return a.t0 < b.t0;
+    });
+    std::vector<PieceEvent> events;
+    for (size_t first = 0; first < pieces.size();) {
+        size_t last = first + 1;
+        while (last < pieces.size() && sameLine(pieces[first], pieces[last]))
+            ++last;
+        stats.hidden += resolveLine(pieces, first, last, events, kept);
+        first = last;
+    }
+
+    // Back to source order, so the output reads like the input
+    std::stable_sort(kept.begin(), kept.end(),
+        [](const GridSegment& a, const GridSegment& b) { return a.source < b.source; });
+
+    // Weld by sorting the ends: equal ends sit together, the first slot of
+    // each run stands for the run, and vertices are numbered in slot order
+    std::vector<WeldEnd> ends;
+    ends.reserve(kept.size() * 2);
+    for (const GridSegment& segment : kept) {
+        ends.push_back({ segment.a.x, segment.a.y, segment.colorA, (unsigned)ends.size() });
+        ends.push_back({ segment.b.x, segment.b.y, segment.colorB, (unsigned)ends.size() });
+        out.sources.push_back(segment.source);
+    }
+    std::sort(ends.begin(), ends.end(), weldOrder);
+
+    std::vector<unsigned> first(ends.size());
+    for (size_t i = 0; i < ends.size(); ++i) {
+        bool same = i > 0 && ends[i].x == ends[i - 1].x && ends[i].y == ends[i - 1].y &&
+            ends[i].color == ends[i - 1].color;
+        first[ends[i].slot] = same ? first[ends[i - 1].slot] : ends[i].slot;
+    }
+
+    out.indices.resize(first.size());
+    for (size_t slot = 0; slot < first.size(); ++slot) {
+        if (first[slot] != slot) {
+            out.indices[slot] = out.indices[first[slot]];
+            continue;
+        }
+        const GridSegment& segment = kept[slot / 2];
+        const GridPoint& p = (slot & 1) ? segment.b : segment.a;
+        std::uint32_t color = (slot & 1) ? segment.colorB : segment.colorA;
+        PackedVertex v;
+        v.x = (float)(p.x * step);
+        v.y = (float)(p.y * step);
+        v.r = (GLubyte)(color & 0xff);
+        v.g = (GLubyte)(color >> 8 & 0xff);
+        v.b = (GLubyte)(color >> 16 & 0xff);
+        v.a = (GLubyte)(color >> 24);
+        out.indices[slot] = (unsigned)out.vertices.size();
+        out.vertices.push_back(v);
+    }
+
+    stats.segmentsOut = out.SegmentCount();
+    stats.verticesOut = out.vertices.size();
+    return stats;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "VertexStream.h"
+
+// ------------------ Line cleanup ------------------
+// Normalises line geometry once, when a scene is loaded, so that every
+// visible stretch of line is stored and drawn once:
+//
+//  1. endpoints are snapped to a grid of 'snap' units, so ends that were
+//     meant to meet do meet;
+//  2. segments whose ends snap together are dropped;
+//  3. opaque single-colour segments on the same line are cut where they
+//     overlap. Each stretch keeps the colour it was drawn in last (the
+//     painter's order of the source), stretches of one colour that touch
+//     become one segment, and a segment covered completely by later ones
+//     disappears;
+//  4. the survivors' ends are welded into an indexed line list.
+//
+// Shaded or translucent segments show what lies under them, so they are
+// only snapped and welded, never cut or merged.
+
+struct LineSegment {
+    PackedVertex a, b;
+};
+
+// Two indices per segment into 'vertices'. sources[i] is the position in
+// the input of the earliest segment that segment i was built from.
+struct IndexedLines {
+    std::vector<PackedVertex> vertices;
+    std::vector<unsigned> indices;
+    std::vector<unsigned> sources;
+
+    size_t SegmentCount() const { return sources.size(); }
+    void Clear();
+};
+
+struct LineCleanupStats {
+    size_t segmentsIn = 0, segmentsOut = 0;
+    size_t zeroLength = 0;      // dropped: both ends on one grid point
+    size_t hidden = 0;          // dropped: covered by later segments
+    size_t verticesIn = 0;      // two per input segment
+    size_t verticesOut = 0;     // welded vertices in the indexed list
+
+    // Line vertices no longer drawn: those of the dropped and merged
+    // segments. Welding does not count, since the list is drawn expanded.
+    // Negative when cutting lines around others adds more than that saves.
+    long long VerticesRemoved() const { return (long long)verticesIn - 2 * (long long)segmentsOut; }
+};
+
+// Cleans 'segments' into 'out' (replacing its contents). 'snap' must be
+// positive; coordinates should stay within about 1e9 grid steps of zero.
+LineCleanupStats cleanupLines(const std::vector<LineSegment>& segments, float snap, IndexedLines& out);
@@ -0,0 +1,48 @@
+#include "Lod.h"
+
+#include <cmath>
+
+static float currentPixelsPerUnit = 1.0f;
+
+float lodPixelsPerUnit() {
+    return currentPixelsPerUnit;
+}
+
+void setLodPixelsPerUnit(float pixels) {
+    currentPixelsPerUnit = pixels;
+}
+
+int LodSelector::Select(float pixels, const float* thresholds, int count) {
+    if (level < 0) {
+        // First use: no history, take the level the size falls in
+        level = 0;
+        while (level < count && pixels >= thresholds[level])
+            ++level;
+        return level;
+    }
+
+    // Each step needs the size to clear the threshold by the hysteresis margin
+    while (level < count && pixels >= thresholds[level] * (1.0f + kLodHysteresis))
+        ++level;
+    while (level > 0 && pixels < thresholds[level - 1] * (1.0f - kLodHysteresis))
+        --level;
+    return level;
+}
+
+int circleSegments(float radiusPixels, int minSegments, int maxSegments) {
+    const float tolerance = 0.5f;
+    int segments = maxSegments;
+    if (radiusPixels <= tolerance) {
+        segments = minSegments;
+    }
+    else {
+        // Sagitta of a chord spanning angle a is r * (1 - cos(a / 2))
+        double halfAngle = std::acos(1.0 - tolerance / radiusPixels);
+        double needed = std::ceil(3.14159265358979323846 / halfAngle);
+        if (needed < maxSegments)
+            segments = (int)needed;
+    }
+    if (segments < minSegments)
+        segments = minSegments;
+    return segments;
+}
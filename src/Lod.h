@@ -0,0 +1,30 @@
+#pragma once
+
+// ------------------ Level of detail ------------------
+// Detail is chosen from how big something appears on screen, not from the
+// zoom value directly, so the same thresholds work for every view whatever
+// glScalef it draws under. loadSheetCamera records how many pixels one world
+// unit covers; a primitive multiplies that by its own size (and the scale of
+// the view it is drawn in) and asks a LodSelector for a level.
+
+// Pixels covered by one world unit under the current camera
+float lodPixelsPerUnit();
+void setLodPixelsPerUnit(float pixels);
+
+// Fraction a projected size has to move past a threshold before the level
+// changes, so zooming back and forth around a threshold does not pop
+constexpr float kLodHysteresis = 0.15f;
+
+// Remembers the level last picked for one primitive. 'thresholds' holds
+// count ascending screen sizes in pixels; level i is used between
+// thresholds[i - 1] and thresholds[i], so there are count + 1 levels and 0
+// is the coarsest.
+struct LodSelector {
+    int level = -1;     // nothing selected yet
+
+    int Select(float pixels, const float* thresholds, int count);
+};
+
+// Segment count that keeps a circle of 'radiusPixels' within half a pixel
+// of the true curve, clamped to [minSegments, maxSegments]
+int circleSegments(float radiusPixels, int minSegments, int maxSegments);
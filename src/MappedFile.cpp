@@ -0,0 +1,106 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path) {
+    Close();
+
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        std::fprintf(stderr, "mapped file: could not open %s\n", path);
+        return false;
+    }
+    file = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        std::fprintf(stderr, "mapped file: could not size %s\n", path);
+        Close();
+        return false;
+    }
+    size = (size_t)fileSize.QuadPart;
+    if (size == 0)
+        return true; // empty files cannot be mapped, but are valid
+
+    mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping)
+        data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        std::fprintf(stderr, "mapped file: could not map %s\n", path);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data)
+        UnmapViewOfFile(data);
+    if (mapping)
+        CloseHandle(mapping);
+    if (file)
+        CloseHandle(file);
+    data = nullptr;
+    mapping = nullptr;
+    file = nullptr;
+    size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const char* path) {
+    Close();
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        std::fprintf(stderr, "mapped file: could not open %s\n", path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        std::fprintf(stderr, "mapped file: could not size %s\n", path);
+        Close();
+        return false;
+    }
+    size = (size_t)info.st_size;
+    if (size == 0)
+        return true; // empty files cannot be mapped, but are valid
+
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        std::fprintf(stderr, "mapped file: could not map %s\n", path);
+        Close();
+        return false;
+    }
+    data = static_cast<const char*>(view);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data)
+        munmap(const_cast<char*>(data), size);
+    if (fd >= 0)
+        close(fd);
+    data = nullptr;
+    fd = -1;
+    size = 0;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+// ------------------ Memory-mapped file ------------------
+// Read-only view of a whole file. The bytes stay valid until the object is
+// destroyed and are not NUL-terminated.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps 'path'; reports the reason on stderr and returns false on failure
+    bool Open(const char* path);
+    void Close();
+
+    const char* Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;       // HANDLE
+    void* mapping = nullptr;    // HANDLE
+#else
+    int fd = -1;
+#endif
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Instancing.h"
+#include "RenderOrigin.h"
+
+// ------------------ Picking ------------------
+// Hover and click picking on the floor plan. Rather than redrawing the plan
+// in GL_SELECT mode, the cursor is mapped to world space and answered by
+// the plan's spatial index on the CPU in a microsecond or two. The result
+// is a small value that the frame loop compares from frame to frame; only
+// a change redraws, and then only the highlight over the cached frame.
+
+enum class PickKind {
+    None,
+    Wall,       // a line record of the scene
+    Door,       // a door record: leaf and swing arc
+    Fixture
+};
+
+struct PlanPick {
+    PickKind kind = PickKind::None;
+    FixtureType fixture = FixtureType::Count;   // fixtures only
+    unsigned index = 0;     // scene record (walls, doors) or instance of 'fixture'
+
+    bool operator==(const PlanPick& other) const {
+        return kind == other.kind && fixture == other.fixture && index == other.index;
+    }
+    bool operator!=(const PlanPick& other) const { return !(*this == other); }
+};
+
+// How close, in screen pixels, the cursor has to come to a primitive
+const float kPickPixels = 6.0f;
+
+// World position under window point (cursorX, cursorY) (GLFW cursor
+// coordinates, y down) for the camera loadSheetCamera(zoom, scrollX,
+// scrollY) loads into a windowWidth x windowHeight window
+inline WorldPoint cursorToWorld(double cursorX, double cursorY, int windowWidth, int windowHeight,
+    float zoom, double scrollX, double scrollY) {
+    WorldPoint p;
+    p.x = scrollX + (2.0 * cursorX / windowWidth - 1.0) * zoom;
+    p.y = scrollY + (1.0 - 2.0 * cursorY / windowHeight) * zoom;
+    return p;
+}
+
+// World distance covered by 'pixels' on the less magnified axis
+inline float pickRadius(float pixels, float zoom, int windowWidth, int windowHeight) {
+    int shorter = windowWidth < windowHeight ? windowWidth : windowHeight;
+    return pixels * 2.0f * zoom / (float)(shorter > 0 ? shorter : 1);
+}
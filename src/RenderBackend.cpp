@@ -0,0 +1,64 @@
+#include "RenderBackend.h"
+
+// Forwards every call to the GL context current on the calling thread
+class OpenGLBackend : public RenderBackend {
+public:
+    void LoadOrtho(float left, float right, float bottom, float top) override {
+        glMatrixMode(GL_PROJECTION);
+        glLoadIdentity();
+        glOrtho(left, right, bottom, top, -1, 1);
+
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+    }
+
+    void GetViewport(int& width, int& height) const override {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        width = viewport[2];
+        height = viewport[3];
+    }
+
+    void GetModelview(float matrix[16]) const override {
+        glGetFloatv(GL_MODELVIEW_MATRIX, matrix);
+    }
+
+    void Begin(GLenum mode) override { glBegin(mode); }
+    void End() override { glEnd(); }
+    void Vertex2f(float x, float y) override { glVertex2f(x, y); }
+    void Color4f(float r, float g, float b, float a) override { glColor4f(r, g, b, a); }
+    void LineWidth(float width) override { glLineWidth(width); }
+    void Enable(GLenum cap) override { glEnable(cap); }
+    void Disable(GLenum cap) override { glDisable(cap); }
+    void BlendFunc(GLenum source, GLenum destination) override { glBlendFunc(source, destination); }
+    void Hint(GLenum target, GLenum mode) override { glHint(target, mode); }
+
+    bool UsesOpenGL() const override { return true; }
+
+    void DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) override {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, sizeof(PackedVertex), &vertices->x);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PackedVertex), &vertices->r);
+        glDrawArrays(mode, (GLint)first, (GLsizei)count);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    void DrawLines(const float* positions, size_t first, size_t count) override {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, positions);
+        glDrawArrays(GL_LINES, (GLint)(first * 2), (GLsizei)(count * 2));
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+
+    void Finish() override { glFinish(); }
+};
+
+static OpenGLBackend openGLBackend;
+
+RenderBackend* activeRenderBackend = &openGLBackend;
+
+void setRenderBackend(RenderBackend* backend) {
+    activeRenderBackend = backend ? backend : &openGLBackend;
+}
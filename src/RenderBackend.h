@@ -0,0 +1,62 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <cstddef>
+
+#include "VertexStream.h"
+
+// ------------------ Render backends ------------------
+// Everything the drawings submit (the im* wrappers, GeometryBuffer and
+// LineBatch replays, and the sheet camera) goes to the active backend. The
+// default one forwards to the current OpenGL context; SoftwareRasterizer
+// draws the same calls into memory on the CPU, so headless export and the
+// benchmark need neither a display nor a GL driver.
+//
+// The interface mirrors the small part of OpenGL 1.1 the drawings use.
+// Positions are in render space (see RenderOrigin.h); the modelview matrix
+// is always the identity.
+
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    // Orthographic window in render space, mapped over the whole viewport
+    virtual void LoadOrtho(float left, float right, float bottom, float top) = 0;
+    virtual void GetViewport(int& width, int& height) const = 0;
+    virtual void GetModelview(float matrix[16]) const = 0;
+
+    // ---- Immediate mode ----
+    virtual void Begin(GLenum mode) = 0;
+    virtual void End() = 0;
+    virtual void Vertex2f(float x, float y) = 0;
+    virtual void Color4f(float r, float g, float b, float a) = 0;
+    virtual void LineWidth(float width) = 0;
+    virtual void Enable(GLenum cap) = 0;
+    virtual void Disable(GLenum cap) = 0;
+    virtual void BlendFunc(GLenum source, GLenum destination) = 0;
+    virtual void Hint(GLenum target, GLenum mode) = 0;
+
+    // ---- Vertex arrays ----
+    // True for the OpenGL backend: retained buffers then keep their vertices
+    // in buffer objects and draw with glDrawArrays themselves. Otherwise they
+    // keep a client-side copy and hand it to the calls below.
+    virtual bool UsesOpenGL() const = 0;
+
+    // Vertices [first, first + count) of an interleaved array, as GL_LINES
+    // or GL_TRIANGLES
+    virtual void DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) = 0;
+
+    // Lines [first, first + count) of x, y pairs (two per line) in the current colour
+    virtual void DrawLines(const float* positions, size_t first, size_t count) = 0;
+
+    // Returns once everything submitted has reached the target
+    virtual void Finish() = 0;
+};
+
+extern RenderBackend* activeRenderBackend;
+
+inline RenderBackend& renderBackend() { return *activeRenderBackend; }
+
+// Routes drawing to 'backend'; nullptr restores the OpenGL backend
+void setRenderBackend(RenderBackend* backend);
@@ -0,0 +1,13 @@
+#include "RenderOrigin.h"
+
+#include <cmath>
+
+WorldPoint renderOrigin = { 0.0, 0.0 };
+
+bool rebaseRenderOrigin(double cameraX, double cameraY) {
+    if (std::fabs(cameraX - renderOrigin.x) <= kRebaseCell && std::fabs(cameraY - renderOrigin.y) <= kRebaseCell)
+        return false;
+    renderOrigin.x = std::floor(cameraX / kRebaseCell + 0.5) * kRebaseCell;
+    renderOrigin.y = std::floor(cameraY / kRebaseCell + 0.5) * kRebaseCell;
+    return true;
+}
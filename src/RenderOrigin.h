@@ -0,0 +1,31 @@
+#pragma once
+
+// ------------------ Render origin ------------------
+// Whole site plans run to kilometres, where a float only resolves a few
+// centimetres. World positions that must stay exact (the camera, the
+// anchor of each retained buffer) are therefore doubles, and GL only ever
+// sees render space: world minus the render origin, a point near the camera.
+// Floats there keep sub-millimetre resolution wherever the camera is.
+//
+// The origin moves in whole kRebaseCell steps, and only once the camera is
+// more than a cell away from it. After a move, retained buffers re-derive
+// their render-space vertices once, through the SIMD transform kernel. On
+// every other frame the rebasing costs nothing.
+
+// Grid the origin snaps to, in world units
+const double kRebaseCell = 1024.0;
+
+struct WorldPoint {
+    double x, y;
+};
+
+// Current origin; (0, 0) until the camera first wanders off
+extern WorldPoint renderOrigin;
+
+// Moves the origin to the grid point nearest (cameraX, cameraY) if the
+// camera is more than a cell away from it. Returns true when it moved.
+bool rebaseRenderOrigin(double cameraX, double cameraY);
+
+// World to render space
+inline float toRenderX(double x) { return (float)(x - renderOrigin.x); }
+inline float toRenderY(double y) { return (float)(y - renderOrigin.y); }
@@ -0,0 +1,249 @@
+#include "Scene.h"
+#include "Fixtures.h"
+#include "Instancing.h"
+#include "MappedFile.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Read position inside the scene text
+struct SceneCursor {
+    const char* p;
+    const char* end;
+    int line;
+};
+
+static void skipBlanks(SceneCursor& c) {
+    while (c.p < c.end && (*c.p == ' ' || *c.p == '\t' || *c.p == '\r'))
+        ++c.p;
+}
+
+// True at the end of the record: end of line, end of file or a comment
+static bool atRecordEnd(SceneCursor& c) {
+    skipBlanks(c);
+    return c.p == c.end || *c.p == '\n' || *c.p == '#';
+}
+
+static void nextLine(SceneCursor& c) {
+    while (c.p < c.end && *c.p != '\n')
+        ++c.p;
+    if (c.p < c.end)
+        ++c.p;
+    ++c.line;
+}
+
+static bool isSeparator(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '#';
+}
+
+static bool readWord(SceneCursor& c, const char*& word, size_t& length) {
+    skipBlanks(c);
+    word = c.p;
+    while (c.p < c.end && !isSeparator(*c.p))
+        ++c.p;
+    length = (size_t)(c.p - word);
+    return length > 0;
+}
+
+static bool wordIs(const char* word, size_t length, const char* keyword) {
+    return std::strlen(keyword) == length && std::memcmp(word, keyword, length) == 0;
+}
+
+// Decimal number with optional sign, fraction and exponent. The text is not
+// NUL-terminated, so strtod cannot be used on the mapped bytes directly.
+static bool readDouble(SceneCursor& c, double& value) {
+    static const double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    skipBlanks(c);
+    const char* p = c.p;
+    bool negative = false;
+    if (p < c.end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    std::uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    for (; p < c.end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        if (mantissa < 100000000000000000ull) mantissa = mantissa * 10 + (std::uint64_t)(*p - '0');
+        else ++exponent; // beyond double precision anyway
+    }
+    if (p < c.end && *p == '.') {
+        for (++p; p < c.end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+            if (mantissa < 100000000000000000ull) {
+                mantissa = mantissa * 10 + (std::uint64_t)(*p - '0');
+                --exponent;
+            }
+        }
+    }
+    if (digits == 0)
+        return false;
+
+    if (p < c.end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < c.end && (*p == '-' || *p == '+'))
+            negativeExponent = (*p++ == '-');
+        int e = 0;
+        const char* start = p;
+        for (; p < c.end && *p >= '0' && *p <= '9'; ++p)
+            e = (e < 1000) ? e * 10 + (*p - '0') : e;
+        if (p == start)
+            return false;
+        exponent += negativeExponent ? -e : e;
+    }
+    if (p < c.end && !isSeparator(*p))
+        return false;
+
+    double result = (double)mantissa;
+    if (exponent < 0 && exponent >= -22) result /= kPow10[-exponent];
+    else if (exponent > 0 && exponent <= 22) result *= kPow10[exponent];
+    else if (exponent != 0) result *= std::pow(10.0, exponent);
+
+    value = negative ? -result : result;
+    c.p = p;
+    return true;
+}
+
+static bool readFloat(SceneCursor& c, float& value) {
+    double result;
+    if (!readDouble(c, result))
+        return false;
+    value = (float)result;
+    return true;
+}
+
+static bool readFloats(SceneCursor& c, float* values, int count) {
+    for (int i = 0; i < count; ++i) {
+        if (!readFloat(c, values[i]))
+            return false;
+    }
+    return true;
+}
+
+// Reads an optional trailing number; 'value' keeps its default when absent
+static bool readOptionalFloat(SceneCursor& c, float& value) {
+    return atRecordEnd(c) || readFloat(c, value);
+}
+
+bool parseScene(const char* text, size_t size, const char* name, GeometryBuffer& out, FixtureInstances& fixtures,
+    std::vector<SceneRecord>* records) {
+    const float degrees = 3.14159265358979323846f / 180.0f;
+
+    SceneCursor c = { text, text + size, 1 };
+    float color[3] = { 1.0f, 1.0f, 1.0f };
+    bool linesOpen = false;
+
+    // Walls and doors all go into one GL_LINES primitive
+    auto openLines = [&]() {
+        if (!linesOpen) {
+            out.Begin(GL_LINES);
+            out.Color3f(color[0], color[1], color[2]);
+            linesOpen = true;
+        }
+    };
+    // The primitive stays open, so the segments read so far are still pending
+    auto record = [&](SceneShape shape) {
+        if (records)
+            records->push_back({ shape, c.line, (unsigned)((out.Vertices().Size() + out.PendingVertices()) / 2) });
+    };
+    auto fail = [&](const char* message) {
+        std::fprintf(stderr, "scene: %s:%d: %s\n", name, c.line, message);
+        out.Clear();
+        fixtures.Clear();
+        if (records)
+            records->clear();
+        return false;
+    };
+
+    for (; c.p < c.end; nextLine(c)) {
+        if (atRecordEnd(c))
+            continue;
+
+        const char* word;
+        size_t length;
+        readWord(c, word, length);
+
+        float v[7];
+        if (wordIs(word, length, "line")) {
+            if (!readFloats(c, v, 4))
+                return fail("line needs X1 Y1 X2 Y2");
+            openLines();
+            record(SceneShape::Line);
+            out.Vertex2f(v[0], v[1]);
+            out.Vertex2f(v[2], v[3]);
+        }
+        else if (wordIs(word, length, "door")) {
+            if (!readFloats(c, v, 7))
+                return fail("door needs HX HY LX LY RADIUS START END");
+            openLines();
+            record(SceneShape::Door);
+            out.Vertex2f(v[0], v[1]);
+            out.Vertex2f(v[2], v[3]);
+            DrawDoorArc(out, v[0], v[1], v[4], v[5] * degrees, v[6] * degrees);
+        }
+        else if (wordIs(word, length, "origin")) {
+            double origin[2];
+            if (!readDouble(c, origin[0]) || !readDouble(c, origin[1]))
+                return fail("origin needs X Y");
+            out.SetAnchor(origin[0], origin[1]);
+        }
+        else if (wordIs(word, length, "color")) {
+            if (!readFloats(c, color, 3))
+                return fail("color needs R G B");
+            if (linesOpen)
+                out.Color3f(color[0], color[1], color[2]);
+        }
+        else if (wordIs(word, length, "toilet")) {
+            // Toilet::Draw orientation codes: tank right, left, top, bottom
+            static const float kTankAngle[4] = { 0.0f, 180.0f, 90.0f, 270.0f };
+            if (!readFloats(c, v, 3) || v[2] < 0.0f || v[2] > 3.0f || v[2] != (int)v[2])
+                return fail("toilet needs X Y ORIENTATION (0-3)");
+            fixtures.Add(FixtureType::Toilet, { v[0], v[1], kTankAngle[(int)v[2]], 1.0f });
+        }
+        else if (wordIs(word, length, "extinguisher")) {
+            if (!readFloats(c, v, 2))
+                return fail("extinguisher needs X Y");
+            fixtures.Add(FixtureType::FireExtinguisher, { v[0], v[1], 0.0f, 1.0f });
+        }
+        else if (wordIs(word, length, "bin")) {
+            v[2] = 0.25f; // Bin::Draw default size
+            if (!readFloats(c, v, 2) || !readOptionalFloat(c, v[2]))
+                return fail("bin needs X Y [SIZE]");
+            fixtures.Add(FixtureType::Bin, { v[0], v[1], 0.0f, v[2] / 0.25f });
+        }
+        else if (wordIs(word, length, "table") || wordIs(word, length, "chair")) {
+            v[2] = 0.0f;
+            if (!readFloats(c, v, 2) || !readOptionalFloat(c, v[2]))
+                return fail("table and chair need X Y [ANGLE]");
+            FixtureType type = (word[0] == 't') ? FixtureType::DiningTable : FixtureType::Chair;
+            fixtures.Add(type, { v[0], v[1], v[2], 1.0f });
+        }
+        else {
+            return fail("unknown record");
+        }
+
+        if (!atRecordEnd(c))
+            return fail("unexpected text after the record");
+    }
+
+    if (linesOpen)
+        out.End();
+    return true;
+}
+
+bool loadScene(const char* path, GeometryBuffer& out, FixtureInstances& fixtures, std::vector<SceneRecord>* records) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        out.Clear();
+        fixtures.Clear();
+        if (records)
+            records->clear();
+        return false;
+    }
+    return parseScene(file.Data(), file.Size(), path, out, fixtures, records);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "GeometryBuffer.h"
+#include "Instancing.h"
+
+// ------------------ Scene files ------------------
+// Plain-text plan description, one record per line, '#' starts a comment.
+// Coordinates are plan metres and angles are degrees.
+//
+//   origin X Y                          where the plan's (0, 0) sits on the site,
+//                                       read in double precision (default 0 0)
+//   color R G B                         colour of the following lines and doors
+//   line X1 Y1 X2 Y2                    wall, counter, window or furniture edge
+//   door HX HY LX LY RADIUS START END   leaf from the hinge (HX, HY) to (LX, LY)
+//                                       plus its swing arc around the hinge
+//   toilet X Y ORIENTATION              see Toilet::Draw
+//   extinguisher X Y
+//   bin X Y [SIZE]
+//   table X Y [ANGLE]                   dining table with four chairs
+//   chair X Y [ANGLE]
+//
+// The file is memory-mapped and parsed in place: lines and doors go straight
+// into the geometry buffer and fixtures become placements in the instance
+// arrays, without copying the text or building intermediate records.
+
+// Where a run of line segments came from, for picking: one entry per line
+// or door record, in file order. Segment i is vertices 2 i and 2 i + 1 of
+// the loaded buffer; a record's segments run up to the next record's first.
+enum class SceneShape {
+    Line,
+    Door    // leaf first, then the swing arc
+};
+
+struct SceneRecord {
+    SceneShape shape;
+    int line;               // line number in the scene file
+    unsigned firstSegment;
+};
+
+// Loads 'path' into 'out' and 'fixtures', and 'records' when given. On
+// failure the reason (with the line number for syntax errors) goes to
+// stderr and all three are left cleared.
+bool loadScene(const char* path, GeometryBuffer& out, FixtureInstances& fixtures,
+    std::vector<SceneRecord>* records = nullptr);
+
+// Parses scene text that is already in memory; 'name' is used in messages
+bool parseScene(const char* text, size_t size, const char* name, GeometryBuffer& out, FixtureInstances& fixtures,
+    std::vector<SceneRecord>* records = nullptr);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <functional>
+#include <vector>
+
+#include "Culling.h"
+#include "Lod.h"
+#include "RenderBackend.h"
+#include "RenderOrigin.h"
+#include "ThreadPool.h"
+
+// ------------------ Sheet views ------------------
+// One drawing on the sheet (the floor plan or an elevation) together with
+// the camera that frames it, so tools other than the interactive loop can
+// render it.
+struct SheetView {
+    const char* name;
+    float centerX, centerY;     // world-space centre of the drawing
+    float zoom;                 // glOrtho half-extent that fits the drawing
+    std::function<void()> draw;
+
+    // CPU-only geometry generation, run on the pool before the first draw.
+    // It may queue further tasks on the pool but must not call GL.
+    std::function<void(ThreadPool&)> prepare;
+
+    // World-space extent, measured the first time the view is drawn
+    mutable Bounds bounds;
+};
+
+// Loads the same projection the interactive loop uses: a glOrtho window of
+// half-size 'zoom' centred on (scrollX, scrollY). The window is set up in
+// render space, after moving the render origin near the camera if needed.
+// Also records the window for culling and its pixel scale for
+// level-of-detail selection.
+inline void loadSheetCamera(float zoom, double scrollX, double scrollY) {
+    rebaseRenderOrigin(scrollX, scrollY);
+    float centerX = toRenderX(scrollX);
+    float centerY = toRenderY(scrollY);
+
+    renderBackend().LoadOrtho(-zoom + centerX, zoom + centerX, -zoom + centerY, zoom + centerY);
+
+    Bounds window;
+    window.minX = (float)(scrollX - zoom);
+    window.maxX = (float)(scrollX + zoom);
+    window.minY = (float)(scrollY - zoom);
+    window.maxY = (float)(scrollY + zoom);
+    setCameraBounds(window);
+
+    // The square window is stretched over the viewport; detail follows the
+    // more magnified axis
+    int width, height;
+    renderBackend().GetViewport(width, height);
+    int pixels = width > height ? width : height;
+    setLodPixelsPerUnit((float)pixels / (2.0f * zoom));
+}
+
+// Draws 'view' unless it lies entirely outside the camera window. The first
+// call always draws, capturing the view's bounds on the way.
+inline void drawSheetView(const SheetView& view) {
+    if (!view.bounds.Valid()) {
+        beginBoundsCapture();
+        view.draw();
+        view.bounds = endBoundsCapture();
+    }
+    else if (isVisible(view.bounds)) {
+        view.draw();
+    }
+}
+
+// Runs every view's geometry generation on 'pool' and waits for it, so the
+// views' first Draw() only uploads and submits
+inline void prepareSheetViews(const std::vector<SheetView>& views, ThreadPool& pool) {
+    for (const SheetView& view : views) {
+        if (view.prepare)
+            pool.Submit([&view, &pool] { view.prepare(pool); });
+    }
+    pool.Wait();
+}
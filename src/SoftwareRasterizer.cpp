@@ -0,0 +1,420 @@
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+static std::uint32_t packColor(float r, float g, float b, float a) {
+    auto toByte = [](float c) -> std::uint32_t {
+        if (c <= 0.0f) return 0;
+        if (c >= 1.0f) return 255;
+        return (std::uint32_t)(c * 255.0f + 0.5f);
+    };
+    return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+}
+
+static std::uint32_t channel(std::uint32_t color, int shift) {
+    return (color >> shift) & 0xff;
+}
+
+// ------------------ Setup ------------------
+
+void SoftwareRasterizer::Resize(int w, int h) {
+    width = w;
+    height = h;
+    tilesX = (width + kRasterTile - 1) / kRasterTile;
+    tilesY = (height + kRasterTile - 1) / kRasterTile;
+    pixels.assign((size_t)width * height, clearColor);
+    bins.resize((size_t)tilesX * tilesY);
+}
+
+void SoftwareRasterizer::BeginFrame(float r, float g, float b) {
+    clearColor = packColor(r, g, b, 1.0f);
+    clearPending = true;
+    triangles.clear();
+    pending.clear();
+    recording = false;
+}
+
+void SoftwareRasterizer::LoadOrtho(float left, float right, float bottom, float top) {
+    scaleX = (float)width / (right - left);
+    offsetX = -left * scaleX;
+    scaleY = -(float)height / (top - bottom);
+    offsetY = -top * scaleY;
+}
+
+void SoftwareRasterizer::GetViewport(int& viewportWidth, int& viewportHeight) const {
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void SoftwareRasterizer::GetModelview(float matrix[16]) const {
+    for (int i = 0; i < 16; ++i)
+        matrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+}
+
+void SoftwareRasterizer::Color4f(float r, float g, float b, float a) {
+    color = packColor(r, g, b, a);
+}
+
+void SoftwareRasterizer::Enable(GLenum cap) {
+    if (cap == GL_BLEND)
+        blendEnabled = true;
+}
+
+void SoftwareRasterizer::Disable(GLenum cap) {
+    if (cap == GL_BLEND)
+        blendEnabled = false;
+}
+
+void SoftwareRasterizer::BlendFunc(GLenum source, GLenum destination) {
+    alphaBlendFunc = (source == GL_SRC_ALPHA && destination == GL_ONE_MINUS_SRC_ALPHA);
+}
+
+SoftwareRasterizer::Vertex SoftwareRasterizer::ToPixels(float x, float y, std::uint32_t rgba) const {
+    return { x * scaleX + offsetX, y * scaleY + offsetY, rgba };
+}
+
+// ------------------ Primitive assembly ------------------
+
+void SoftwareRasterizer::Begin(GLenum mode) {
+    if (recording)
+        End();
+    pendingMode = mode;
+    pending.clear();
+    recording = true;
+}
+
+void SoftwareRasterizer::Vertex2f(float x, float y) {
+    if (recording)
+        pending.push_back(ToPixels(x, y, color));
+}
+
+void SoftwareRasterizer::End() {
+    if (!recording)
+        return;
+    recording = false;
+    AssemblePending();
+    pending.clear();
+}
+
+// Breaks the primitive between Begin() and End() into lines or triangles,
+// the same way GeometryBuffer does
+void SoftwareRasterizer::AssemblePending() {
+    const std::vector<Vertex>& p = pending;
+    size_t n = p.size();
+    switch (pendingMode) {
+    case GL_LINES:
+        for (size_t i = 0; i + 1 < n; i += 2)
+            AddLine(p[i], p[i + 1]);
+        break;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        for (size_t i = 0; i + 1 < n; ++i)
+            AddLine(p[i], p[i + 1]);
+        if (pendingMode == GL_LINE_LOOP && n > 2)
+            AddLine(p[n - 1], p[0]);
+        break;
+    case GL_TRIANGLES:
+        for (size_t i = 0; i + 2 < n; i += 3)
+            AddTriangle(p[i], p[i + 1], p[i + 2]);
+        break;
+    case GL_TRIANGLE_STRIP:
+        for (size_t i = 0; i + 2 < n; ++i)
+            AddTriangle(p[i], p[i + 1], p[i + 2]);
+        break;
+    case GL_QUADS:
+        for (size_t i = 0; i + 3 < n; i += 4) {
+            AddTriangle(p[i], p[i + 1], p[i + 2]);
+            AddTriangle(p[i], p[i + 2], p[i + 3]);
+        }
+        break;
+    case GL_QUAD_STRIP:
+        for (size_t i = 0; i + 3 < n; i += 2) {
+            AddTriangle(p[i], p[i + 1], p[i + 3]);
+            AddTriangle(p[i], p[i + 3], p[i + 2]);
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON:
+        for (size_t i = 1; i + 1 < n; ++i)
+            AddTriangle(p[0], p[i], p[i + 1]);
+        break;
+    default:
+        break; // points are not used by the drawings
+    }
+}
+
+void SoftwareRasterizer::DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) {
+    const PackedVertex* v = vertices + first;
+    auto toVertex = [this](const PackedVertex& p) {
+        return ToPixels(p.x, p.y, p.r | ((std::uint32_t)p.g << 8) | ((std::uint32_t)p.b << 16) | ((std::uint32_t)p.a << 24));
+    };
+    if (mode == GL_LINES) {
+        for (size_t i = 0; i + 1 < count; i += 2)
+            AddLine(toVertex(v[i]), toVertex(v[i + 1]));
+    }
+    else if (mode == GL_TRIANGLES) {
+        for (size_t i = 0; i + 2 < count; i += 3)
+            AddTriangle(toVertex(v[i]), toVertex(v[i + 1]), toVertex(v[i + 2]));
+    }
+}
+
+void SoftwareRasterizer::DrawLines(const float* positions, size_t first, size_t count) {
+    const float* p = positions + first * 4;
+    for (size_t i = 0; i < count; ++i, p += 4)
+        AddLine(ToPixels(p[0], p[1], color), ToPixels(p[2], p[3], color));
+}
+
+// A line is the rectangle of the current width (at least a pixel) centred on it
+void SoftwareRasterizer::AddLine(const Vertex& a, const Vertex& b) {
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length == 0.0f)
+        return;
+    float half = std::max(lineWidth, 1.0f) * 0.5f / length;
+    float nx = -dy * half, ny = dx * half;
+
+    Vertex a0 = { a.x + nx, a.y + ny, a.color }, a1 = { a.x - nx, a.y - ny, a.color };
+    Vertex b0 = { b.x + nx, b.y + ny, b.color }, b1 = { b.x - nx, b.y - ny, b.color };
+    AddTriangle(a0, a1, b1);
+    AddTriangle(a0, b1, b0);
+}
+
+void SoftwareRasterizer::AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    bool blend = blendEnabled && alphaBlendFunc;
+    triangles.push_back({ { a, b, c }, blend });
+}
+
+// ------------------ Rasterization ------------------
+
+void SoftwareRasterizer::Finish() {
+    if (recording)
+        End();
+    if (width <= 0 || height <= 0)
+        return;
+
+    // Bin by the pixel box each triangle may cover
+    for (std::vector<std::uint32_t>& bin : bins)
+        bin.clear();
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const Vertex* v = triangles[i].v;
+        float minX = std::min(v[0].x, std::min(v[1].x, v[2].x));
+        float maxX = std::max(v[0].x, std::max(v[1].x, v[2].x));
+        float minY = std::min(v[0].y, std::min(v[1].y, v[2].y));
+        float maxY = std::max(v[0].y, std::max(v[1].y, v[2].y));
+        if (maxX < 0.0f || maxY < 0.0f || minX >= (float)width || minY >= (float)height)
+            continue;
+        // Clamped as floats first: geometry far off screen would overflow an int
+        int firstX = (int)std::max(minX, 0.0f) / kRasterTile;
+        int lastX = (int)std::min(maxX, (float)(width - 1)) / kRasterTile;
+        int firstY = (int)std::max(minY, 0.0f) / kRasterTile;
+        int lastY = (int)std::min(maxY, (float)(height - 1)) / kRasterTile;
+        for (int ty = firstY; ty <= lastY; ++ty) {
+            for (int tx = firstX; tx <= lastX; ++tx)
+                bins[(size_t)ty * tilesX + tx].push_back((std::uint32_t)i);
+        }
+    }
+
+    // One task per worker, each taking the next row of tiles until none
+    // are left. The pool's queues then never hold more than a task each.
+    nextTileRow = 0;
+    int tasks = std::min(pool.ThreadCount(), tilesY);
+    for (int i = 0; i < tasks; ++i) {
+        pool.Submit([this] {
+            for (int ty = nextTileRow++; ty < tilesY; ty = nextTileRow++) {
+                for (int tx = 0; tx < tilesX; ++tx)
+                    RasterizeTile(tx, ty);
+            }
+        });
+    }
+    pool.Wait();
+
+    triangles.clear();
+    clearPending = false;
+}
+
+// Vertex positions are snapped to 1/256 pixel and the edge functions
+// stepped in 64-bit integers, so coverage tests are exact. Positions this
+// far off screen (in pixels) would overflow them; such triangles are
+// rasterized in doubles instead.
+const int kSubpixelBits = 8;
+const float kMaxFixedPixels = (float)(1 << 21);
+
+// Each channel of 'source' times its alpha, rounded for blendOver()
+static void premultiply(std::uint32_t source, std::uint32_t (&tint)[4]) {
+    std::uint32_t alpha = channel(source, 24);
+    for (int k = 0; k < 4; ++k)
+        tint[k] = channel(source, 8 * k) * alpha + 127;
+}
+
+// GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA in 8 bits: 'keep' is 255 - source alpha
+static std::uint32_t blendOver(std::uint32_t destination, const std::uint32_t (&tint)[4], std::uint32_t keep) {
+    std::uint32_t blended = 0;
+    for (int k = 0; k < 4; ++k)
+        blended |= ((tint[k] + channel(destination, 8 * k) * keep) / 255) << (8 * k);
+    return blended;
+}
+
+// One side of a triangle, in the units its positions are in (T)
+template <typename T>
+struct RasterEdge {
+    T stepX, stepY, value;      // change per pixel right and down; value at the row start
+    bool owns;                  // whether pixel centres exactly on it are inside
+
+    // An edge exactly through a pixel centre owns it only on one side (the
+    // top-left rule), so a pixel on an edge shared by two triangles is drawn once
+    bool Inside(T w) const { return w > 0 || (w == 0 && owns); }
+};
+
+// Fills the pixels of a counter-clockwise (in pixel space, y down) triangle
+// whose centres lie inside it, within the box [minX, maxX] x [minY, maxY].
+// 'unit' is one pixel in the units of x and y.
+template <typename T>
+static void fillTriangle(const T (&x)[3], const T (&y)[3], const std::uint32_t (&colors)[3], bool blend,
+    T unit, int minX, int maxX, int minY, int maxY, std::uint32_t* pixels, int width) {
+    T centreX = (T)minX * unit + unit / 2, centreY = (T)minY * unit + unit / 2;
+    auto makeEdge = [&](int a, int b) {
+        RasterEdge<T> e;
+        T dx = x[b] - x[a], dy = y[b] - y[a];
+        e.stepX = -dy * unit;
+        e.stepY = dx * unit;
+        e.value = dx * (centreY - y[a]) - dy * (centreX - x[a]);
+        e.owns = dy > 0 || (dy == 0 && dx < 0);
+        return e;
+    };
+    RasterEdge<T> e0 = makeEdge(1, 2), e1 = makeEdge(2, 0), e2 = makeEdge(0, 1);
+    auto inside = [&](T w0, T w1, T w2) { return e0.Inside(w0) && e1.Inside(w1) && e2.Inside(w2); };
+
+    bool flat = colors[0] == colors[1] && colors[1] == colors[2];
+    // Opaque flat rows are filled outright: blending at alpha 255 replaces
+    bool solid = flat && (!blend || channel(colors[0], 24) == 255);
+    std::uint32_t tint[4];
+    premultiply(colors[0], tint);
+    std::uint32_t keep = 255 - channel(colors[0], 24);
+    float inverseArea = 1.0f / (float)((x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]));
+    float c0[4], c1[4], c2[4];
+    for (int k = 0; k < 4; ++k) {
+        c0[k] = (float)channel(colors[0], 8 * k);
+        c1[k] = (float)channel(colors[1], 8 * k);
+        c2[k] = (float)channel(colors[2], 8 * k);
+    }
+
+    for (int row = minY; row <= maxY; ++row, e0.value += e0.stepY, e1.value += e1.stepY, e2.value += e2.stepY) {
+        // Narrow the row to the span all three edges allow, so thin
+        // diagonal line quads do not walk their whole bounding box. The
+        // estimate is padded by a pixel, then trimmed with the exact tests;
+        // a triangle covers one run of each row.
+        double spanStart = 0.0, spanEnd = (double)(maxX - minX);
+        for (const RasterEdge<T>* e : { &e0, &e1, &e2 }) {
+            if (e->stepX > 0)
+                spanStart = std::max(spanStart, -(double)e->value / (double)e->stepX - 1.0);
+            else if (e->stepX < 0)
+                spanEnd = std::min(spanEnd, (double)e->value / -(double)e->stepX + 1.0);
+            else if (e->value < 0)
+                spanEnd = -1.0;
+        }
+        if (spanStart > spanEnd)
+            continue;
+        int start = (int)spanStart, end = (int)spanEnd;
+
+        T w0 = e0.value + (T)start * e0.stepX, w1 = e1.value + (T)start * e1.stepX, w2 = e2.value + (T)start * e2.stepX;
+        for (; start <= end && !inside(w0, w1, w2); ++start) {
+            w0 += e0.stepX;
+            w1 += e1.stepX;
+            w2 += e2.stepX;
+        }
+        if (start > end)
+            continue;
+        while (end > start && !inside(e0.value + (T)end * e0.stepX, e1.value + (T)end * e1.stepX,
+            e2.value + (T)end * e2.stepX))
+            --end;
+
+        std::uint32_t* out = pixels + (size_t)row * width + minX;
+        if (solid) {
+            std::fill(out + start, out + end + 1, colors[0]);
+            continue;
+        }
+        if (flat && blend) {
+            for (int i = start; i <= end; ++i)
+                out[i] = blendOver(out[i], tint, keep);
+            continue;
+        }
+        for (int i = start; i <= end; ++i, w0 += e0.stepX, w1 += e1.stepX, w2 += e2.stepX) {
+            std::uint32_t source = colors[0];
+            if (!flat) {
+                float b0 = (float)w0 * inverseArea, b1 = (float)w1 * inverseArea, b2 = (float)w2 * inverseArea;
+                source = 0;
+                for (int k = 0; k < 4; ++k) {
+                    float c = c0[k] * b0 + c1[k] * b1 + c2[k] * b2 + 0.5f;
+                    source |= (std::uint32_t)std::min(std::max(c, 0.0f), 255.0f) << (8 * k);
+                }
+            }
+
+            if (!blend) {
+                out[i] = source;
+                continue;
+            }
+            std::uint32_t sourceTint[4];
+            premultiply(source, sourceTint);
+            out[i] = blendOver(out[i], sourceTint, 255 - channel(source, 24));
+        }
+    }
+}
+
+void SoftwareRasterizer::RasterizeTile(int tileX, int tileY) {
+    int x0 = tileX * kRasterTile, y0 = tileY * kRasterTile;
+    int x1 = std::min(x0 + kRasterTile, width), y1 = std::min(y0 + kRasterTile, height);
+
+    if (clearPending) {
+        for (int y = y0; y < y1; ++y)
+            std::fill(&pixels[(size_t)y * width + x0], &pixels[(size_t)y * width + x1], clearColor);
+    }
+
+    for (std::uint32_t index : bins[(size_t)tileY * tilesX + tileX]) {
+        const Triangle& t = triangles[index];
+        Vertex v0 = t.v[0], v1 = t.v[1], v2 = t.v[2];
+        float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (area == 0.0f)
+            continue;
+        if (area < 0.0f)
+            std::swap(v1, v2);
+
+        int minX = (int)std::max((float)x0, std::floor(std::min(v0.x, std::min(v1.x, v2.x))));
+        int maxX = (int)std::min((float)(x1 - 1), std::ceil(std::max(v0.x, std::max(v1.x, v2.x))));
+        int minY = (int)std::max((float)y0, std::floor(std::min(v0.y, std::min(v1.y, v2.y))));
+        int maxY = (int)std::min((float)(y1 - 1), std::ceil(std::max(v0.y, std::max(v1.y, v2.y))));
+        if (minX > maxX || minY > maxY)
+            continue;
+
+        const std::uint32_t colors[3] = { v0.color, v1.color, v2.color };
+        bool nearby = true;
+        for (const Vertex* v : { &v0, &v1, &v2 })
+            nearby = nearby && std::fabs(v->x) < kMaxFixedPixels && std::fabs(v->y) < kMaxFixedPixels;
+        if (nearby) {
+            auto fixed = [](float c) { return std::llround(c * (float)(1 << kSubpixelBits)); };
+            const long long x[3] = { fixed(v0.x), fixed(v1.x), fixed(v2.x) };
+            const long long y[3] = { fixed(v0.y), fixed(v1.y), fixed(v2.y) };
+            // Snapping can flatten a sliver, or flip it
+            long long snappedArea = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+            if (snappedArea <= 0)
+                continue;
+            fillTriangle(x, y, colors, t.blend, 1LL << kSubpixelBits, minX, maxX, minY, maxY, pixels.data(), width);
+        } else {
+            const double x[3] = { v0.x, v1.x, v2.x };
+            const double y[3] = { v0.y, v1.y, v2.y };
+            fillTriangle(x, y, colors, t.blend, 1.0, minX, maxX, minY, maxY, pixels.data(), width);
+        }
+    }
+}
+
+void SoftwareRasterizer::ReadPixels(std::vector<unsigned char>& image) {
+    Finish();
+    image.resize((size_t)width * height * 3);
+    unsigned char* out = image.data();
+    for (std::uint32_t pixel : pixels) {
+        *out++ = (unsigned char)channel(pixel, 0);
+        *out++ = (unsigned char)channel(pixel, 8);
+        *out++ = (unsigned char)channel(pixel, 16);
+    }
+}
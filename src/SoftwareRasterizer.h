@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "RenderBackend.h"
+#include "ThreadPool.h"
+
+// ------------------ Software rasterizer ------------------
+// Render backend that draws into an RGBA8 framebuffer in memory, for machines
+// without a GPU or a GL driver. Everything submitted during a frame is
+// assembled into screen-space triangles (a line becomes a quad as wide as
+// its line width, at least one pixel) and queued. Finish() then bins the
+// triangles into kRasterTile x kRasterTile pixel tiles and rasterizes rows
+// of tiles in parallel on the thread pool. Each tile draws its triangles
+// in submission order, so overlapping drawings keep GL's painter's order,
+// and no two workers ever write the same pixel.
+//
+// Coverage follows GL's rules: pixel centres inside the triangle, with a
+// top-left rule on shared edges so adjacent triangles never draw a pixel
+// twice. Like GL, positions are snapped to a subpixel grid (1/256 pixel)
+// and the edge tests are exact integer arithmetic; rows of an opaque flat
+// triangle are filled without per-pixel tests. Colours are interpolated
+// across each triangle. With GL_BLEND
+// enabled and glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), the only
+// blend function the drawings use, colours are alpha blended; otherwise
+// they replace the framebuffer. GL_LINE_SMOOTH is ignored.
+
+const int kRasterTile = 64;
+
+class SoftwareRasterizer : public RenderBackend {
+public:
+    explicit SoftwareRasterizer(ThreadPool& pool) : pool(pool) {}
+
+    // Sets the framebuffer (and viewport) size
+    void Resize(int width, int height);
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    // Starts a frame: drops anything queued and clears to the opaque colour
+    // (r, g, b) when the frame is finished
+    void BeginFrame(float r, float g, float b);
+
+    // Copies the finished frame into 'image' as top-down 8-bit RGB
+    void ReadPixels(std::vector<unsigned char>& image);
+
+    // Triangles queued since the last Finish()
+    size_t QueuedTriangles() const { return triangles.size(); }
+
+    // ---- RenderBackend ----
+    void LoadOrtho(float left, float right, float bottom, float top) override;
+    void GetViewport(int& viewportWidth, int& viewportHeight) const override;
+    void GetModelview(float matrix[16]) const override;
+
+    void Begin(GLenum mode) override;
+    void End() override;
+    void Vertex2f(float x, float y) override;
+    void Color4f(float r, float g, float b, float a) override;
+    void LineWidth(float width) override { lineWidth = width; }
+    void Enable(GLenum cap) override;
+    void Disable(GLenum cap) override;
+    void BlendFunc(GLenum source, GLenum destination) override;
+    void Hint(GLenum, GLenum) override {}
+
+    bool UsesOpenGL() const override { return false; }
+    void DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) override;
+    void DrawLines(const float* positions, size_t first, size_t count) override;
+
+    // Rasterizes every queued triangle into the framebuffer
+    void Finish() override;
+
+private:
+    // Screen-space vertex: pixels from the top-left corner, RGBA8 colour
+    struct Vertex {
+        float x, y;
+        std::uint32_t color;
+    };
+
+    struct Triangle {
+        Vertex v[3];
+        bool blend;
+    };
+
+    Vertex ToPixels(float x, float y, std::uint32_t rgba) const;
+    void AddLine(const Vertex& a, const Vertex& b);
+    void AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+    void AssemblePending();
+    void RasterizeTile(int tileX, int tileY);
+
+    ThreadPool& pool;
+    int width = 0, height = 0;
+    int tilesX = 0, tilesY = 0;
+    std::vector<std::uint32_t> pixels;      // RGBA8, row 0 at the top
+    std::uint32_t clearColor = 0xff000000;
+    bool clearPending = false;
+
+    // Render space to pixels: px = x * scaleX + offsetX, likewise for y
+    float scaleX = 1.0f, offsetX = 0.0f;
+    float scaleY = -1.0f, offsetY = 0.0f;
+
+    std::uint32_t color = 0xffffffff;
+    float lineWidth = 1.0f;
+    bool blendEnabled = false;
+    bool alphaBlendFunc = false;
+
+    GLenum pendingMode = GL_LINES;
+    std::vector<Vertex> pending;            // between Begin() and End()
+    bool recording = false;
+
+    std::vector<Triangle> triangles;        // queued this frame, in submission order
+    std::vector<std::vector<std::uint32_t>> bins;  // per tile, indices into 'triangles'
+    std::atomic<int> nextTileRow{ 0 };      // next row of tiles to rasterize in Finish()
+};
@@ -0,0 +1,259 @@
+#include "SpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+// Items per leaf; small enough that a leaf test is a handful of compares
+static const unsigned kLeafSize = 8;
+
+// Deep enough for a 32-bit Morton split plus the median fallback on
+// identical codes
+static const int kMaxDepth = 96;
+
+static Bounds itemBounds(const SpatialItem& item) {
+    Bounds box;
+    box.Add(item.x1, item.y1);
+    box.Add(item.x2, item.y2);
+    return box;
+}
+
+static bool contains(const Bounds& outer, const Bounds& inner) {
+    return outer.minX <= inner.minX && inner.maxX <= outer.maxX &&
+        outer.minY <= inner.minY && inner.maxY <= outer.maxY;
+}
+
+// Squared distance from (x, y) to a box; 0 inside
+static float boxDistanceSquared(const Bounds& box, float x, float y) {
+    float dx = std::max(std::max(box.minX - x, x - box.maxX), 0.0f);
+    float dy = std::max(std::max(box.minY - y, y - box.maxY), 0.0f);
+    return dx * dx + dy * dy;
+}
+
+static float itemDistanceSquared(const SpatialItem& item, float x, float y) {
+    if (item.shape == SpatialShape::Box)
+        return boxDistanceSquared(itemBounds(item), x, y);
+
+    float dx = item.x2 - item.x1;
+    float dy = item.y2 - item.y1;
+    float lengthSquared = dx * dx + dy * dy;
+    float t = 0.0f;
+    if (lengthSquared > 0.0f)
+        t = std::min(std::max(((x - item.x1) * dx + (y - item.y1) * dy) / lengthSquared, 0.0f), 1.0f);
+    float ex = item.x1 + t * dx - x;
+    float ey = item.y1 + t * dy - y;
+    return ex * ex + ey * ey;
+}
+
+float spatialDistance(const SpatialItem& item, float x, float y) {
+    return std::sqrt(itemDistanceSquared(item, x, y));
+}
+
+// Spreads the low 16 bits of 'v' to the even bit positions
+static unsigned spreadBits(unsigned v) {
+    v &= 0xffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+// ------------------ Build ------------------
+
+void SpatialIndex::Clear() {
+    items.clear();
+    nodes.clear();
+}
+
+void SpatialIndex::Build(std::vector<SpatialItem> source) {
+    Clear();
+    if (source.empty())
+        return;
+
+    // Morton code of each item's centre on a 65536 x 65536 grid over the extent
+    Bounds extent;
+    for (const SpatialItem& item : source) {
+        extent.Add(item.x1, item.y1);
+        extent.Add(item.x2, item.y2);
+    }
+    float spanX = extent.maxX - extent.minX;
+    float spanY = extent.maxY - extent.minY;
+    float scaleX = spanX > 0.0f ? 65535.0f / spanX : 0.0f;
+    float scaleY = spanY > 0.0f ? 65535.0f / spanY : 0.0f;
+
+    std::vector<std::pair<unsigned, unsigned>> keyed(source.size()); // (code, item)
+    for (size_t i = 0; i < source.size(); ++i) {
+        const SpatialItem& item = source[i];
+        float cx = (item.x1 + item.x2) * 0.5f;
+        float cy = (item.y1 + item.y2) * 0.5f;
+        unsigned gx = (unsigned)((cx - extent.minX) * scaleX);
+        unsigned gy = (unsigned)((cy - extent.minY) * scaleY);
+        keyed[i] = std::make_pair(spreadBits(gx) | (spreadBits(gy) << 1), (unsigned)i);
+    }
+    std::sort(keyed.begin(), keyed.end());
+
+    std::vector<unsigned> codes(keyed.size());
+    items.resize(keyed.size());
+    for (size_t i = 0; i < keyed.size(); ++i) {
+        codes[i] = keyed[i].first;
+        items[i] = source[keyed[i].second];
+    }
+
+    // A binary tree over n items, leaves of up to kLeafSize, has fewer than
+    // 2 n / kLeafSize + 1 nodes when every split leaves both sides non-empty
+    nodes.reserve(2 * items.size() / kLeafSize + 2);
+    BuildNode(codes, 0, (unsigned)items.size());
+}
+
+// Emits the subtree over items [first, first + count) depth first and
+// returns its node index. Splits where the highest differing Morton bit
+// flips, i.e. along the cell boundary the curve crosses; runs of identical
+// codes are halved instead.
+unsigned SpatialIndex::BuildNode(const std::vector<unsigned>& codes, unsigned first, unsigned count) {
+    unsigned index = (unsigned)nodes.size();
+    nodes.push_back(Node());
+    Node node;
+    node.first = first;
+    node.count = count;
+    node.right = 0;
+
+    if (count <= kLeafSize) {
+        for (unsigned i = first; i < first + count; ++i)
+            node.box.Add(itemBounds(items[i]));
+        nodes[index] = node;
+        return index;
+    }
+
+    unsigned last = first + count - 1;
+    unsigned split = first + count / 2;
+    unsigned differing = codes[first] ^ codes[last];
+    if (differing != 0) {
+        unsigned bit = 1u << 31;
+        while ((differing & bit) == 0)
+            bit >>= 1;
+        // First code with the bit set; the codes are sorted, so it is a partition point
+        split = (unsigned)(std::partition_point(codes.begin() + first, codes.begin() + last + 1,
+            [bit](unsigned code) { return (code & bit) == 0; }) - codes.begin());
+    }
+
+    unsigned left = BuildNode(codes, first, split - first);
+    node.right = BuildNode(codes, split, first + count - split);
+    node.box = nodes[left].box;
+    node.box.Add(nodes[node.right].box);
+    nodes[index] = node;
+    return index;
+}
+
+// ------------------ Queries ------------------
+
+void SpatialIndex::QueryRect(const Bounds& rect, std::vector<unsigned>& out) const {
+    if (nodes.empty())
+        return;
+    unsigned stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (!node.box.Intersects(rect))
+            continue;
+        bool inside = contains(rect, node.box);
+        if (node.right == 0 || inside) {
+            for (unsigned i = node.first; i < node.first + node.count; ++i) {
+                if (inside || itemBounds(items[i]).Intersects(rect))
+                    out.push_back(items[i].id);
+            }
+            continue;
+        }
+        stack[top++] = node.right;
+        stack[top++] = index + 1;
+    }
+}
+
+void SpatialIndex::QueryRanges(const Bounds& rect, std::vector<IndexRange>& out) const {
+    if (nodes.empty())
+        return;
+    unsigned stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (!node.box.Intersects(rect))
+            continue;
+        if (node.right == 0 || contains(rect, node.box)) {
+            // Left children are popped first, so runs arrive in index order
+            if (!out.empty() && out.back().first + out.back().count == node.first)
+                out.back().count += node.count;
+            else
+                out.push_back({ node.first, node.count });
+            continue;
+        }
+        stack[top++] = node.right;
+        stack[top++] = index + 1;
+    }
+}
+
+void SpatialIndex::QueryPoint(float x, float y, float radius, std::vector<SpatialHit>& out) const {
+    if (nodes.empty())
+        return;
+    float radiusSquared = radius * radius;
+    unsigned stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (boxDistanceSquared(node.box, x, y) > radiusSquared)
+            continue;
+        if (node.right == 0) {
+            for (unsigned i = node.first; i < node.first + node.count; ++i) {
+                float distanceSquared = itemDistanceSquared(items[i], x, y);
+                if (distanceSquared <= radiusSquared)
+                    out.push_back({ items[i].id, i, std::sqrt(distanceSquared) });
+            }
+            continue;
+        }
+        stack[top++] = node.right;
+        stack[top++] = index + 1;
+    }
+}
+
+bool SpatialIndex::Nearest(float x, float y, float maxDistance, SpatialHit& hit) const {
+    if (nodes.empty())
+        return false;
+    float bestSquared = maxDistance * maxDistance;
+    bool found = false;
+
+    // Depth first, nearer child first, pruning every box farther than the best so far
+    unsigned stack[kMaxDepth];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (boxDistanceSquared(node.box, x, y) > bestSquared)
+            continue;
+        if (node.right == 0) {
+            for (unsigned i = node.first; i < node.first + node.count; ++i) {
+                float distanceSquared = itemDistanceSquared(items[i], x, y);
+                if (distanceSquared <= bestSquared) {
+                    bestSquared = distanceSquared;
+                    hit = { items[i].id, i, 0.0f };
+                    found = true;
+                }
+            }
+            continue;
+        }
+        unsigned closer = index + 1, farther = node.right;
+        if (boxDistanceSquared(nodes[farther].box, x, y) < boxDistanceSquared(nodes[closer].box, x, y))
+            std::swap(closer, farther);
+        stack[top++] = farther;
+        stack[top++] = closer;
+    }
+
+    if (found)
+        hit.distance = std::sqrt(bestSquared);
+    return found;
+}
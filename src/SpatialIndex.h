@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Culling.h"
+
+// ------------------ Spatial index ------------------
+// Packed bounding volume hierarchy over 2D primitives: line segments (walls,
+// door leaves, arc pieces) and boxes (fixtures). Build() sorts the items
+// along a Morton curve of their centres and splits the sorted run where the
+// curve's cells split, so every subtree owns a contiguous run of items and
+// neighbouring items are neighbours on the plan. Nodes are stored depth
+// first; a node's left child follows it directly.
+//
+// Queries walk the tree with a fixed stack and no allocation beyond the
+// caller's output vector, so they stay well under a millisecond on a
+// million segments:
+//
+//   QueryRect    items whose box meets a rectangle (culling, selection)
+//   QueryRanges  the same as runs of consecutive items, for drawing a
+//                geometry buffer kept in index order with few draw calls
+//   QueryPoint   items within a radius of a point (hit testing)
+//   Nearest      the closest item to a point (snapping)
+
+enum class SpatialShape : unsigned char {
+    Segment,    // (x1, y1) to (x2, y2)
+    Box         // min (x1, y1), max (x2, y2)
+};
+
+struct SpatialItem {
+    float x1, y1, x2, y2;
+    SpatialShape shape;
+    unsigned id;            // the caller's handle, returned by the queries
+};
+
+struct SpatialHit {
+    unsigned id;
+    size_t order;           // position in Items()
+    float distance;         // from the query point; 0 inside a box
+};
+
+// Run of consecutive items in index order
+struct IndexRange {
+    size_t first, count;
+};
+
+class SpatialIndex {
+public:
+    // Takes the items and reorders them along the Morton curve
+    void Build(std::vector<SpatialItem> items);
+    void Clear();
+
+    size_t Size() const { return items.size(); }
+    bool Empty() const { return items.empty(); }
+
+    // Items in index order
+    const std::vector<SpatialItem>& Items() const { return items; }
+
+    // Box around every item
+    Bounds Extent() const { return nodes.empty() ? Bounds() : nodes[0].box; }
+
+    // Appends the ids of the items whose box intersects 'rect'
+    void QueryRect(const Bounds& rect, std::vector<unsigned>& out) const;
+
+    // Appends runs of items that may intersect 'rect', in index order with
+    // adjacent runs merged. Leaves are reported whole, so a run can include
+    // a few items just outside.
+    void QueryRanges(const Bounds& rect, std::vector<IndexRange>& out) const;
+
+    // Appends every item within 'radius' of (x, y)
+    void QueryPoint(float x, float y, float radius, std::vector<SpatialHit>& out) const;
+
+    // Finds the item closest to (x, y), no farther than 'maxDistance'.
+    // Returns false when there is none.
+    bool Nearest(float x, float y, float maxDistance, SpatialHit& hit) const;
+
+private:
+    struct Node {
+        Bounds box;
+        unsigned first, count;  // items of the whole subtree
+        unsigned right;         // right child; 0 for a leaf
+    };
+
+    unsigned BuildNode(const std::vector<unsigned>& codes, unsigned first, unsigned count);
+
+    std::vector<SpatialItem> items;
+    std::vector<Node> nodes;
+};
+
+// Distance from (x, y) to an item; 0 inside a box
+float spatialDistance(const SpatialItem& item, float x, float y);
@@ -0,0 +1,180 @@
+#include "Stroke.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "UnitCircle.h"
+
+struct StrokeVector {
+    float x, y;
+};
+
+static StrokeVector operator+(StrokeVector a, StrokeVector b) { return { a.x + b.x, a.y + b.y }; }
+static StrokeVector operator-(StrokeVector a, StrokeVector b) { return { a.x - b.x, a.y - b.y }; }
+static StrokeVector operator*(StrokeVector a, float s) { return { a.x * s, a.y * s }; }
+
+static float dot(StrokeVector a, StrokeVector b) { return a.x * b.x + a.y * b.y; }
+static float cross(StrokeVector a, StrokeVector b) { return a.x * b.y - a.y * b.x; }
+
+// Quarter turn to the left
+static StrokeVector perpendicular(StrokeVector a) { return { -a.y, a.x }; }
+
+static const unsigned kNoSlot = ~0u;
+
+// Writes the stroke triangles with each vertex's colour taken from a line vertex
+class StrokeWriter {
+public:
+    StrokeWriter(GeometryBuffer& out, int roundSegments) : out(out), roundSegments(std::max(roundSegments, 3)) {}
+
+    void Triangle(const PackedVertex& color, StrokeVector a, StrokeVector b, StrokeVector c) {
+        SetColor(color);
+        out.Vertex2f(a.x, a.y);
+        out.Vertex2f(b.x, b.y);
+        out.Vertex2f(c.x, c.y);
+    }
+
+    // Quad of a segment body: a side at 'from', b side at 'to'
+    void Body(const PackedVertex& from, StrokeVector fromLeft, StrokeVector fromRight,
+        const PackedVertex& to, StrokeVector toLeft, StrokeVector toRight) {
+        SetColor(from);
+        out.Vertex2f(fromLeft.x, fromLeft.y);
+        SetColor(to);
+        out.Vertex2f(toLeft.x, toLeft.y);
+        out.Vertex2f(toRight.x, toRight.y);
+        SetColor(from);
+        out.Vertex2f(fromLeft.x, fromLeft.y);
+        SetColor(to);
+        out.Vertex2f(toRight.x, toRight.y);
+        SetColor(from);
+        out.Vertex2f(fromRight.x, fromRight.y);
+    }
+
+    // Fan around 'center' sweeping 'radius' (a vector from the centre) by
+    // 'angle' radians, counter-clockwise when positive
+    void Fan(const PackedVertex& color, StrokeVector center, StrokeVector radius, float angle) {
+        int steps = std::max(1, (int)std::ceil(std::fabs(angle) * roundSegments / (2.0 * kUnitCirclePi)));
+        float c = std::cos(angle / steps), s = std::sin(angle / steps);
+        SetColor(color);
+        StrokeVector previous = center + radius;
+        for (int i = 0; i < steps; ++i) {
+            radius = { radius.x * c - radius.y * s, radius.x * s + radius.y * c };
+            StrokeVector next = center + radius;
+            out.Vertex2f(center.x, center.y);
+            out.Vertex2f(previous.x, previous.y);
+            out.Vertex2f(next.x, next.y);
+            previous = next;
+        }
+    }
+
+private:
+    void SetColor(const PackedVertex& v) {
+        out.Color4f(v.r / 255.0f, v.g / 255.0f, v.b / 255.0f, v.a / 255.0f);
+    }
+
+    GeometryBuffer& out;
+    int roundSegments;
+};
+
+void strokeLines(const IndexedLines& lines, const StrokeStyle& style, const std::vector<unsigned>& order,
+    GeometryBuffer& out, std::vector<size_t>& runs) {
+    const std::vector<PackedVertex>& vertices = lines.vertices;
+    const std::vector<unsigned>& indices = lines.indices;
+    const float half = 0.5f * style.width;
+
+    // The first two segment ends (2 * segment + end) at each vertex, and how
+    // many there are
+    std::vector<unsigned> degree(vertices.size(), 0);
+    std::vector<unsigned> incident(vertices.size() * 2, kNoSlot);
+    for (unsigned slot = 0; slot < (unsigned)indices.size(); ++slot) {
+        unsigned v = indices[slot];
+        if (degree[v] < 2)
+            incident[2 * v + degree[v]] = slot;
+        ++degree[v];
+    }
+
+    auto position = [&](unsigned slot) {
+        const PackedVertex& v = vertices[indices[slot]];
+        return StrokeVector{ v.x, v.y };
+    };
+    // Unit direction of a segment from its first end to its second
+    auto direction = [&](unsigned segment) {
+        StrokeVector d = position(2 * segment + 1) - position(2 * segment);
+        float length = std::sqrt(dot(d, d));
+        return d * (1.0f / length);
+    };
+
+    StrokeWriter writer(out, style.roundSegments);
+    size_t base = out.Vertices().Size();
+    runs.clear();
+    runs.reserve(order.size() + 1);
+    out.Begin(GL_TRIANGLES);
+
+    for (unsigned segment : order) {
+        runs.push_back(base + out.PendingVertices());
+        if (indices[2 * segment] == indices[2 * segment + 1])
+            continue;
+
+        StrokeVector d = direction(segment);
+        StrokeVector normal = perpendicular(d);
+
+        // Left and right outline corners at each end
+        StrokeVector left[2], right[2];
+        for (unsigned end = 0; end < 2; ++end) {
+            unsigned slot = 2 * segment + end;
+            unsigned v = indices[slot];
+            const PackedVertex& color = vertices[v];
+            StrokeVector p = position(slot);
+            // Direction leaving the segment through this end
+            StrokeVector outward = end == 1 ? d : d * -1.0f;
+
+            if (degree[v] != 2) {
+                StrokeVector extend = style.cap == StrokeCap::Square ? outward * half : StrokeVector{ 0.0f, 0.0f };
+                left[end] = p + normal * half + extend;
+                right[end] = p - normal * half + extend;
+                if (style.cap == StrokeCap::Round)
+                    writer.Fan(color, p, normal * half, (float)(end == 1 ? -kUnitCirclePi : kUnitCirclePi));
+                continue;
+            }
+
+            unsigned other = incident[2 * v] == slot ? incident[2 * v + 1] : incident[2 * v];
+            unsigned otherSegment = other / 2;
+            // Walk the corner as a path: in along this segment, out along the other
+            StrokeVector in = outward;
+            StrokeVector onward = (other & 1) == 0 ? direction(otherSegment) : direction(otherSegment) * -1.0f;
+            StrokeVector inNormal = perpendicular(in), outNormal = perpendicular(onward);
+
+            StrokeVector miter = inNormal + outNormal;
+            float miterSquared = dot(miter, miter);
+            if (style.join == StrokeJoin::Miter && miterSquared * style.miterLimit * style.miterLimit >= 4.0f) {
+                // Corner on the bisector, 'half' away from both outlines
+                StrokeVector offset = miter * (2.0f * half / miterSquared);
+                StrokeVector pathLeft = p + offset, pathRight = p - offset;
+                left[end] = end == 1 ? pathLeft : pathRight;
+                right[end] = end == 1 ? pathRight : pathLeft;
+                continue;
+            }
+
+            left[end] = p + normal * half;
+            right[end] = p - normal * half;
+            if (segment > otherSegment || dot(inNormal, outNormal) > 0.9999f)
+                continue;   // the other segment writes the join, or it is straight
+
+            // Fill the outside of the turn: the right side on a left turn
+            float side = cross(in, onward) > 0.0f ? -1.0f : 1.0f;
+            StrokeVector from = inNormal * (side * half), to = outNormal * (side * half);
+            if (style.join == StrokeJoin::Round) {
+                // Turning back on itself counts as a right turn too
+                float angle = std::atan2(cross(from, to), dot(from, to));
+                writer.Fan(color, p, from, angle * side > 0.0f ? -angle : angle);
+            }
+            else
+                writer.Triangle(color, p, p + from, p + to);
+        }
+
+        writer.Body(vertices[indices[2 * segment]], left[0], right[0],
+            vertices[indices[2 * segment + 1]], left[1], right[1]);
+    }
+
+    runs.push_back(base + out.PendingVertices());
+    out.End();
+}
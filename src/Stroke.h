@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "GeometryBuffer.h"
+#include "LineCleanup.h"
+
+// ------------------ Stroking ------------------
+// Turns line segments into triangles at a thickness in world units, so a
+// wall is as thick on screen as it is on the plan at every zoom, and looks
+// the same through every backend: glLineWidth is capped and rounded
+// differently by each driver, and the CPU rasterizer and the vector export
+// only approximate it.
+//
+// The input is an indexed line list (see LineCleanup.h); its shared
+// vertices tell which segments meet.
+//  - Where exactly two segments meet they are joined. A miter join ends
+//    both outlines on the bisector, so they meet without overlapping. When
+//    the miter would reach further than miterLimit half widths from the
+//    corner (as in SVG), the join is bevelled instead. Bevel and round
+//    joins end both segments square and fill the outer wedge.
+//  - Free ends, and ends where three or more segments meet, get caps.
+//
+// Every segment's triangles, joins included, form one vertex run. A caller
+// that lists the segments in spatial index order can therefore draw any
+// index run as a vertex run.
+
+enum class StrokeJoin {
+    Miter,
+    Bevel,
+    Round
+};
+
+enum class StrokeCap {
+    Butt,
+    Square,     // extended by half the width
+    Round
+};
+
+struct StrokeStyle {
+    float width = 1.0f;             // world units
+    StrokeJoin join = StrokeJoin::Miter;
+    StrokeCap cap = StrokeCap::Butt;
+    float miterLimit = 4.0f;
+    int roundSegments = 16;         // per full turn, for round joins and caps
+};
+
+// Strokes the segments of 'lines' in the order 'order' lists them and
+// appends the triangles to 'out' as one GL_TRIANGLES primitive. 'runs'
+// receives order.size() + 1 vertex positions in 'out': where each
+// segment's triangles start, then where the last one ends. A join is
+// written with the earlier of its two segments in 'lines'.
+void strokeLines(const IndexedLines& lines, const StrokeStyle& style, const std::vector<unsigned>& order,
+    GeometryBuffer& out, std::vector<size_t>& runs);
@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+
+// Index of the pool worker running on this thread, -1 elsewhere
+static thread_local int workerIndex = -1;
+static thread_local const ThreadPool* workerPool = nullptr;
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0)
+        threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0)
+        threads = 1;
+
+    for (int i = 0; i < threads; ++i)
+        queues.emplace_back(new Queue());
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::Queue::PushBack(std::function<void()>&& task) {
+    if (count == ring.size()) {
+        // Unroll into a ring twice the size
+        std::vector<std::function<void()>> grown(ring.empty() ? 16 : 2 * ring.size());
+        for (size_t i = 0; i < count; ++i)
+            grown[i] = std::move(ring[(head + i) % ring.size()]);
+        ring.swap(grown);
+        head = 0;
+    }
+    ring[(head + count) % ring.size()] = std::move(task);
+    ++count;
+}
+
+void ThreadPool::Queue::PopBack(std::function<void()>& task) {
+    std::function<void()>& slot = ring[(head + count - 1) % ring.size()];
+    task = std::move(slot);
+    slot = nullptr;
+    --count;
+}
+
+void ThreadPool::Queue::PopFront(std::function<void()>& task) {
+    task = std::move(ring[head]);
+    ring[head] = nullptr;
+    head = (head + 1) % ring.size();
+    --count;
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    int target = workerPool == this ? workerIndex : (int)(nextQueue++ % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->PushBack(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        ++queued;
+        ++pending;
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pending == 0; });
+}
+
+bool ThreadPool::PopOrSteal(int self, std::function<void()>& task) {
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.count > 0) {
+            own.PopBack(task);
+            return true;
+        }
+    }
+
+    int count = (int)queues.size();
+    for (int offset = 1; offset < count; ++offset) {
+        Queue& victim = *queues[(self + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.count > 0) {
+            victim.PopFront(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::WorkerLoop(int self) {
+    workerIndex = self;
+    workerPool = this;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+            if (stopping && queued == 0)
+                return;
+            --queued; // claim one task; it is in some deque until popped
+        }
+
+        std::function<void()> task;
+        while (!PopOrSteal(self, task))
+            std::this_thread::yield(); // not reached: every claim matches a task pushed before it was counted
+
+        task();
+
+        bool finished;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            finished = --pending == 0;
+        }
+        if (finished)
+            allDone.notify_all();
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------ Thread pool ------------------
+// Work-stealing pool for CPU-only jobs such as tessellating the views'
+// retained geometry. Each worker owns a deque: it pushes and pops its own
+// tasks at the back (newest first, still warm in cache) and, when that runs
+// dry, steals the oldest task from the front of another worker's deque.
+// Tasks may submit more tasks; Wait() returns once all of them are done.
+// Nothing run on the pool may call GL. The deques are ring buffers that
+// only grow, so once a workload has run a frame, submitting it again (small
+// tasks whose std::function needs no heap copy) does not allocate.
+
+class ThreadPool {
+public:
+    // threads <= 0 uses one worker per hardware thread
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queues a task. From a worker it goes on that worker's own deque,
+    // otherwise the deques are filled round-robin.
+    void Submit(std::function<void()> task);
+
+    // Blocks until every submitted task, including ones they spawned, has run.
+    // Must not be called from a task.
+    void Wait();
+
+    int ThreadCount() const { return (int)workers.size(); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::vector<std::function<void()>> ring;
+        size_t head = 0;        // slot of the oldest task
+        size_t count = 0;
+
+        void PushBack(std::function<void()>&& task);
+        void PopBack(std::function<void()>& task);
+        void PopFront(std::function<void()>& task);
+    };
+
+    void WorkerLoop(int self);
+    bool PopOrSteal(int self, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<unsigned> nextQueue{ 0 };
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    int queued = 0;         // submitted but not yet taken by a worker
+    int pending = 0;        // submitted but not yet finished
+    bool stopping = false;
+};
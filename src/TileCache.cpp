@@ -0,0 +1,185 @@
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include "TileCache.h"
+#include "FrameArena.h"
+
+#include <cmath>
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+
+static const size_t kTileBytes = (size_t)kTilePixels * kTilePixels * 3;
+
+// World units covered by one tile side at 'level'
+static float tileSize(int level) {
+    return (float)(1 << level);
+}
+
+// Coarsest level whose tiles have at least the screen's resolution
+static int levelFor(float unitsPerPixel) {
+    int level = 0;
+    while (level + 1 < kTileLevels && tileSize(level + 1) / kTilePixels <= unitsPerPixel)
+        ++level;
+    return level;
+}
+
+static int floorDiv(int value, int divisor) {
+    return (int)std::floor((double)value / divisor);
+}
+
+TileCache::TileCache(size_t budgetBytes) : budgetBytes(budgetBytes) {}
+
+TileCache::~TileCache() {
+    // The textures die with the context, so only free them while one is current
+    if (glfwGetCurrentContext() != nullptr)
+        Clear();
+}
+
+void TileCache::Clear() {
+    for (const Tile& tile : lru)
+        glDeleteTextures(1, &tile.texture);
+    lru.clear();
+    index.clear();
+}
+
+const TileCache::Tile* TileCache::Find(const TileKey& key) {
+    auto it = index.find(key);
+    if (it == index.end())
+        return nullptr;
+    it->second->lastUsed = frame;
+    lru.splice(lru.begin(), lru, it->second);
+    return &lru.front();
+}
+
+GLuint TileCache::AllocateTexture() {
+    // Evict least recently used tiles, recycling the first texture freed.
+    // Tiles already used by this frame are kept even over budget.
+    GLuint texture = 0;
+    while (!lru.empty() && (lru.size() + 1) * kTileBytes > budgetBytes && lru.back().lastUsed != frame) {
+        if (texture == 0)
+            texture = lru.back().texture;
+        else
+            glDeleteTextures(1, &lru.back().texture);
+        index.erase(lru.back().key);
+        lru.pop_back();
+    }
+    if (texture != 0)
+        return texture;
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, kTilePixels, kTilePixels, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+void TileCache::Render(const std::vector<SheetView>& views, const TileKey& key) {
+    GLuint texture = AllocateTexture();
+
+    // Draw into the bottom-left corner of the back buffer; the frame is
+    // cleared and assembled over it afterwards
+    glViewport(0, 0, kTilePixels, kTilePixels);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, kTilePixels, kTilePixels);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    float size = tileSize(key.level);
+    loadSheetCamera(size * 0.5f, (key.x + 0.5) * size, (key.y + 0.5) * size);
+    for (const SheetView& view : views)
+        drawSheetView(view);
+    glDisable(GL_SCISSOR_TEST);
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glReadBuffer(GL_BACK);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, kTilePixels, kTilePixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    lru.push_front({ key, texture, frame });
+    index[key] = lru.begin();
+}
+
+bool TileCache::Draw(const std::vector<SheetView>& views, float zoom, double scrollX, double scrollY,
+    int width, int height, int renderBudget) {
+    ++frame;
+
+    // Square camera window stretched over the viewport: match the finer axis
+    int pixels = width > height ? width : height;
+    int level = levelFor(2.0f * zoom / (float)pixels);
+    float size = tileSize(level);
+
+    int firstX = (int)std::floor((scrollX - zoom) / size);
+    int lastX = (int)std::floor((scrollX + zoom) / size);
+    int firstY = (int)std::floor((scrollY - zoom) / size);
+    int lastY = (int)std::floor((scrollY + zoom) / size);
+
+    ArenaVector<TileKey> missing{ ArenaAllocator<TileKey>(frameArena) };
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            TileKey key = { level, x, y };
+            if (!Find(key))
+                missing.push_back(key);
+        }
+    }
+
+    int rendered = 0;
+    for (const TileKey& key : missing) {
+        if (rendered == renderBudget)
+            break;
+        Render(views, key);
+        ++rendered;
+    }
+
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT);
+    loadSheetCamera(zoom, scrollX, scrollY);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TEXTURE_BIT);
+    glDisable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glColor3f(1.0f, 1.0f, 1.0f);
+
+    auto drawQuad = [](GLuint texture, float x0, float y0, float x1, float y1,
+        float u0, float v0, float u1, float v1) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glBegin(GL_QUADS);
+        glTexCoord2f(u0, v0); glVertex2f(x0, y0);
+        glTexCoord2f(u1, v0); glVertex2f(x1, y0);
+        glTexCoord2f(u1, v1); glVertex2f(x1, y1);
+        glTexCoord2f(u0, v1); glVertex2f(x0, y1);
+        glEnd();
+    };
+
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int x = firstX; x <= lastX; ++x) {
+            float x0 = toRenderX((double)x * size), y0 = toRenderY((double)y * size);
+            if (const Tile* tile = Find({ level, x, y })) {
+                drawQuad(tile->texture, x0, y0, x0 + size, y0 + size, 0.0f, 0.0f, 1.0f, 1.0f);
+                continue;
+            }
+
+            // Not rendered yet: stretch the matching part of a coarser tile
+            for (int up = 1; level + up < kTileLevels; ++up) {
+                int scale = 1 << up;
+                int parentX = floorDiv(x, scale), parentY = floorDiv(y, scale);
+                if (const Tile* parent = Find({ level + up, parentX, parentY })) {
+                    float u0 = (float)(x - parentX * scale) / scale;
+                    float v0 = (float)(y - parentY * scale) / scale;
+                    drawQuad(parent->texture, x0, y0, x0 + size, y0 + size,
+                        u0, v0, u0 + 1.0f / scale, v0 + 1.0f / scale);
+                    break;
+                }
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopAttrib();
+
+    return rendered == (int)missing.size();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "SheetView.h"
+
+// ------------------ Tile pyramid ------------------
+// The sheet never changes while the app runs, so it can be rendered once
+// into square tiles, map style, and every later frame assembled from them.
+// Level L tiles are 2^L world units on a side and kTilePixels pixels wide;
+// a frame uses the coarsest level whose tiles are at least as sharp as the
+// screen, so a tile is never magnified and at most halved when shown.
+//
+// Tiles live in textures under an LRU memory budget. A tile missing from the
+// cache is drawn from an already cached coarser tile meanwhile, and a few
+// missing tiles are rendered per frame (GL contexts and the drawing code
+// are single-threaded, so "background" here means spread over frames on the
+// main thread rather than on a worker).
+
+constexpr int kTilePixels = 256;
+constexpr int kTileLevels = 7;      // 1 to 64 world units per tile
+
+class TileCache {
+public:
+    explicit TileCache(size_t budgetBytes);
+    ~TileCache();
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    // Assembles the frame for the camera from cached tiles, first rendering
+    // up to 'renderBudget' missing ones. Returns true when every visible tile
+    // was available at the frame's level, false when more frames are needed.
+    bool Draw(const std::vector<SheetView>& views, float zoom, double scrollX, double scrollY,
+        int width, int height, int renderBudget);
+
+    // Drops every tile, e.g. after the scene changed
+    void Clear();
+
+    size_t TileCount() const { return lru.size(); }
+
+private:
+    struct TileKey {
+        int level, x, y;
+
+        bool operator==(const TileKey& o) const { return level == o.level && x == o.x && y == o.y; }
+    };
+
+    struct TileKeyHash {
+        size_t operator()(const TileKey& key) const {
+            return ((size_t)key.level * 73856093u) ^ ((size_t)(unsigned)key.x * 19349663u) ^ ((size_t)(unsigned)key.y * 83492791u);
+        }
+    };
+
+    struct Tile {
+        TileKey key;
+        GLuint texture;
+        long long lastUsed;     // frame that last drew or rendered it
+    };
+
+    // Front is the most recently used tile
+    typedef std::list<Tile> TileList;
+
+    const Tile* Find(const TileKey& key);
+    void Render(const std::vector<SheetView>& views, const TileKey& key);
+    GLuint AllocateTexture();
+
+    size_t budgetBytes;
+    TileList lru;
+    std::unordered_map<TileKey, TileList::iterator, TileKeyHash> index;
+    long long frame = 0;
+};
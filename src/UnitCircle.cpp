@@ -0,0 +1,175 @@
+#include "UnitCircle.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UNIT_CIRCLE_SSE2 1
+#endif
+
+struct KnownArc {
+    int startQuarter;
+    int endQuarter;
+    ArcTable table;
+};
+
+// Every circle and arc the drawings use today
+static const KnownArc knownArcs[] = {
+    // Full circles: flowers (3, 4, 5, 6, 8), toilets and extinguishers (12, 16)
+    { 0, 4, quarterArcTable<3, 0, 4>() },
+    { 0, 4, quarterArcTable<4, 0, 4>() },
+    { 0, 4, quarterArcTable<5, 0, 4>() },
+    { 0, 4, quarterArcTable<6, 0, 4>() },
+    { 0, 4, quarterArcTable<8, 0, 4>() },
+    { 0, 4, quarterArcTable<12, 0, 4>() },
+    { 0, 4, quarterArcTable<16, 0, 4>() },
+    { 0, 4, quarterArcTable<24, 0, 4>() },
+    { 0, 4, quarterArcTable<32, 0, 4>() },
+    // Door swings
+    { 0, 1, quarterArcTable<20, 0, 1>() },
+    { 0, -1, quarterArcTable<20, 0, -1>() },
+    { 2, 3, quarterArcTable<20, 2, 3>() },
+    // U shapes
+    { 0, 2, quarterArcTable<20, 0, 2>() },
+};
+
+// Any other arc is built on first use and kept for the life of the
+// process. Built arcs are published into an open-addressed table that is
+// only ever added to, so lookups (the drawing hot path) read it without a
+// lock; only a miss takes the mutex to build and publish the arc.
+struct CachedArc {
+    int segments;
+    float startAngle, endAngle;
+    std::vector<float> cosv;
+    std::vector<float> sinv;
+};
+
+static const size_t kArcCacheSlots = 1024;     // power of two
+static std::atomic<const CachedArc*> arcCache[kArcCacheSlots];
+static std::mutex arcCacheMutex;
+
+static int clampSegments(int segments) {
+    if (segments < 1) return 1;
+    if (segments > kMaxArcSegments) return kMaxArcSegments;
+    return segments;
+}
+
+static const ArcTable* findKnownArc(int segments, int startQuarter, int endQuarter) {
+    for (const KnownArc& arc : knownArcs) {
+        if (arc.table.segments == segments && arc.startQuarter == startQuarter && arc.endQuarter == endQuarter)
+            return &arc.table;
+    }
+    return nullptr;
+}
+
+// Returns true and the whole number of quarter turns when 'angle' is one
+static bool asQuarterTurns(float angle, int& quarters) {
+    double q = angle / (0.5 * kUnitCirclePi);
+    double rounded = std::floor(q + 0.5);
+    if (std::fabs(q - rounded) > 1e-4)
+        return false;
+    quarters = (int)rounded;
+    return true;
+}
+
+static size_t arcSlot(int segments, float startAngle, float endAngle) {
+    std::uint32_t start, end;
+    std::memcpy(&start, &startAngle, sizeof(start));
+    std::memcpy(&end, &endAngle, sizeof(end));
+    std::uint64_t h = (std::uint64_t)segments * 0x9e3779b97f4a7c15ull;
+    h ^= (h >> 29) + start * 0xbf58476d1ce4e5b9ull;
+    h ^= (h >> 31) + end * 0x94d049bb133111ebull;
+    return (size_t)(h ^ (h >> 32)) & (kArcCacheSlots - 1);
+}
+
+static bool sameArc(const CachedArc* arc, int segments, float startAngle, float endAngle) {
+    return arc->segments == segments && arc->startAngle == startAngle && arc->endAngle == endAngle;
+}
+
+static ArcTable tableOf(const CachedArc* arc) {
+    return ArcTable{ arc->segments, arc->cosv.data(), arc->sinv.data() };
+}
+
+static ArcTable buildArc(int segments, float startAngle, float endAngle) {
+    size_t first = arcSlot(segments, startAngle, endAngle);
+    for (size_t i = 0; i < kArcCacheSlots; ++i) {
+        const CachedArc* arc = arcCache[(first + i) & (kArcCacheSlots - 1)].load(std::memory_order_acquire);
+        if (!arc)
+            break;
+        if (sameArc(arc, segments, startAngle, endAngle))
+            return tableOf(arc);
+    }
+
+    std::lock_guard<std::mutex> lock(arcCacheMutex);
+
+    // Another thread may have published it since the lookup above
+    size_t slot = first;
+    size_t probes = 0;
+    for (; probes < kArcCacheSlots; ++probes, slot = (slot + 1) & (kArcCacheSlots - 1)) {
+        const CachedArc* arc = arcCache[slot].load(std::memory_order_acquire);
+        if (!arc)
+            break;
+        if (sameArc(arc, segments, startAngle, endAngle))
+            return tableOf(arc);
+    }
+
+    CachedArc* arc = new CachedArc{ segments, startAngle, endAngle, {}, {} };
+    arc->cosv.resize(segments + 1);
+    arc->sinv.resize(segments + 1);
+    for (int i = 0; i <= segments; ++i) {
+        double theta = startAngle + (double)(endAngle - startAngle) * i / segments;
+        arc->cosv[i] = (float)std::cos(theta);
+        arc->sinv[i] = (float)std::sin(theta);
+    }
+    // A full table still hands out the arc, it just is not found again
+    if (probes < kArcCacheSlots)
+        arcCache[slot].store(arc, std::memory_order_release);
+    return tableOf(arc);
+}
+
+ArcTable unitCircle(int segments) {
+    segments = clampSegments(segments);
+    if (const ArcTable* known = findKnownArc(segments, 0, 4))
+        return *known;
+    return buildArc(segments, 0.0f, (float)(2.0 * kUnitCirclePi));
+}
+
+ArcTable unitArc(int segments, float startAngle, float endAngle) {
+    segments = clampSegments(segments);
+
+    int startQuarter = 0;
+    int endQuarter = 0;
+    if (asQuarterTurns(startAngle, startQuarter) && asQuarterTurns(endAngle, endQuarter)) {
+        if (const ArcTable* known = findKnownArc(segments, startQuarter, endQuarter))
+            return *known;
+    }
+    return buildArc(segments, startAngle, endAngle);
+}
+
+void arcPoints(const ArcTable& table, float cx, float cy, float rx, float ry, float* xs, float* ys) {
+    int count = table.segments + 1;
+    int i = 0;
+
+#ifdef UNIT_CIRCLE_SSE2
+    __m128 vcx = _mm_set1_ps(cx);
+    __m128 vcy = _mm_set1_ps(cy);
+    __m128 vrx = _mm_set1_ps(rx);
+    __m128 vry = _mm_set1_ps(ry);
+    for (; i + 4 <= count; i += 4) {
+        __m128 c = _mm_loadu_ps(table.cosv + i);
+        __m128 s = _mm_loadu_ps(table.sinv + i);
+        _mm_storeu_ps(xs + i, _mm_add_ps(vcx, _mm_mul_ps(vrx, c)));
+        _mm_storeu_ps(ys + i, _mm_add_ps(vcy, _mm_mul_ps(vry, s)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        xs[i] = cx + rx * table.cosv[i];
+        ys[i] = cy + ry * table.sinv[i];
+    }
+}
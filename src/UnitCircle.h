@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+// ------------------ Unit circle tables ------------------
+// Sin/cos tables shared by every circle and arc primitive. The tables for
+// the segment counts and quarter-turn arcs the drawings use are computed at
+// compile time; any other (segments, start, end) combination is built once
+// at runtime and cached. Tables are stored as separate cos[] and sin[]
+// arrays so a whole fan can be scaled in one vectorised pass (arcPoints).
+
+constexpr double kUnitCirclePi = 3.14159265358979323846;
+
+// Largest segment count the primitives tessellate; higher counts are clamped
+constexpr int kMaxArcSegments = 256;
+
+// Reduces an angle to [-pi, pi] so the series below stays accurate
+constexpr double constexprReduceAngle(double a) {
+    double turns = a / (2.0 * kUnitCirclePi);
+    long long k = (long long)(turns + (turns >= 0.0 ? 0.5 : -0.5));
+    return a - (double)k * 2.0 * kUnitCirclePi;
+}
+
+constexpr double constexprSin(double a) {
+    double x = constexprReduceAngle(a);
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / (double)((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double constexprCos(double a) {
+    double x = constexprReduceAngle(a);
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x * x / (double)((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// Segments + 1 samples so closed fans and loops can read the wrap-around
+// point without a modulo
+template <int Segments>
+struct ArcSamples {
+    alignas(16) float cosv[Segments + 1];
+    alignas(16) float sinv[Segments + 1];
+};
+
+// Angle of sample i on an arc running from StartQuarter to EndQuarter quarter turns
+template <int Segments, int StartQuarter, int EndQuarter>
+constexpr double quarterArcAngle(std::size_t i) {
+    return 0.5 * kUnitCirclePi * (StartQuarter + (EndQuarter - StartQuarter) * (double)i / Segments);
+}
+
+template <int Segments, int StartQuarter, int EndQuarter, std::size_t... I>
+constexpr ArcSamples<Segments> makeQuarterArc(std::index_sequence<I...>) {
+    return ArcSamples<Segments>{
+        { (float)constexprCos(quarterArcAngle<Segments, StartQuarter, EndQuarter>(I))... },
+        { (float)constexprSin(quarterArcAngle<Segments, StartQuarter, EndQuarter>(I))... }
+    };
+}
+
+// Compile-time table for an arc whose ends are whole quarter turns
+// (a full circle is <Segments, 0, 4>)
+template <int Segments, int StartQuarter, int EndQuarter>
+struct QuarterArc {
+    static_assert(Segments > 0 && Segments <= kMaxArcSegments, "unsupported segment count");
+    static constexpr ArcSamples<Segments> samples =
+        makeQuarterArc<Segments, StartQuarter, EndQuarter>(std::make_index_sequence<Segments + 1>());
+};
+
+template <int Segments, int StartQuarter, int EndQuarter>
+constexpr ArcSamples<Segments> QuarterArc<Segments, StartQuarter, EndQuarter>::samples;
+
+// Runtime view of a table: segments + 1 entries in each array
+struct ArcTable {
+    int segments;
+    const float* cosv;
+    const float* sinv;
+};
+
+template <int Segments, int StartQuarter, int EndQuarter>
+constexpr ArcTable quarterArcTable() {
+    return ArcTable{ Segments,
+        QuarterArc<Segments, StartQuarter, EndQuarter>::samples.cosv,
+        QuarterArc<Segments, StartQuarter, EndQuarter>::samples.sinv };
+}
+
+// Full turn starting at angle 0
+ArcTable unitCircle(int segments);
+
+// Arc from startAngle to endAngle (radians, either direction)
+ArcTable unitArc(int segments, float startAngle, float endAngle);
+
+// Writes the segments + 1 points (cx + rx * cos, cy + ry * sin) of 'table'
+// into xs/ys in one SIMD pass
+void arcPoints(const ArcTable& table, float cx, float cy, float rx, float ry, float* xs, float* ys);
@@ -0,0 +1,450 @@
+#include "VectorExport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+static std::uint32_t packColor(float r, float g, float b, float a) {
+    auto toByte = [](float c) -> std::uint32_t {
+        if (c <= 0.0f) return 0;
+        if (c >= 1.0f) return 255;
+        return (std::uint32_t)(c * 255.0f + 0.5f);
+    };
+    return toByte(r) | toByte(g) << 8 | toByte(b) << 16 | toByte(a) << 24;
+}
+
+static std::uint32_t packedColor(const PackedVertex& v) {
+    return v.r | (std::uint32_t)v.g << 8 | (std::uint32_t)v.b << 16 | (std::uint32_t)v.a << 24;
+}
+
+// Per-channel mean of 'count' colours
+static std::uint32_t meanColor(const std::uint32_t* colors, size_t count) {
+    std::uint32_t mean = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::uint32_t sum = 0;
+        for (size_t i = 0; i < count; ++i)
+            sum += (colors[i] >> shift) & 0xff;
+        mean |= (std::uint32_t)((sum + count / 2) / count) << shift;
+    }
+    return mean;
+}
+
+static std::uint64_t hashMix(std::uint64_t hash, std::uint64_t value) {
+    // FNV-1a over the value's bytes
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (8 * i)) & 0xff;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+VectorPage VectorExporter::Page(std::uint32_t background) const {
+    VectorPage page;
+    page.minX = left + renderOrigin.x;
+    page.maxX = right + renderOrigin.x;
+    page.minY = bottom + renderOrigin.y;
+    page.maxY = top + renderOrigin.y;
+    page.width = width;
+    page.height = height;
+    page.background = background;
+    return page;
+}
+
+void VectorExporter::SetWriter(VectorWriter* target) {
+    writer = target;
+    stats.Reset();
+    lastWasFill = false;
+}
+
+void VectorExporter::LoadOrtho(float l, float r, float b, float t) {
+    left = l;
+    right = r;
+    bottom = b;
+    top = t;
+}
+
+void VectorExporter::GetViewport(int& viewportWidth, int& viewportHeight) const {
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void VectorExporter::GetModelview(float matrix[16]) const {
+    for (int i = 0; i < 16; ++i)
+        matrix[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+}
+
+void VectorExporter::Begin(GLenum mode) {
+    pendingMode = mode;
+    pending.clear();
+    recording = true;
+}
+
+void VectorExporter::Vertex2f(float x, float y) {
+    if (recording)
+        pending.push_back({ x, y, color });
+}
+
+void VectorExporter::Color4f(float r, float g, float b, float a) {
+    color = packColor(r, g, b, a);
+}
+
+void VectorExporter::Enable(GLenum cap) {
+    if (cap == GL_BLEND)
+        blendEnabled = true;
+}
+
+void VectorExporter::Disable(GLenum cap) {
+    if (cap == GL_BLEND)
+        blendEnabled = false;
+}
+
+void VectorExporter::BlendFunc(GLenum source, GLenum destination) {
+    alphaBlendFunc = source == GL_SRC_ALPHA && destination == GL_ONE_MINUS_SRC_ALPHA;
+}
+
+void VectorExporter::End() {
+    if (!recording)
+        return;
+    recording = false;
+
+    const std::vector<Vertex>& p = pending;
+    size_t n = p.size();
+    switch (pendingMode) {
+    case GL_LINES:
+        for (size_t i = 0; i + 1 < n; i += 2)
+            AddSegment(p[i], p[i + 1]);
+        break;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        for (size_t i = 0; i + 1 < n; ++i)
+            AddSegment(p[i], p[i + 1]);
+        if (pendingMode == GL_LINE_LOOP && n > 2)
+            AddSegment(p[n - 1], p[0]);
+        break;
+    case GL_TRIANGLES:
+        for (size_t i = 0; i + 2 < n; i += 3)
+            AddTriangle(p[i], p[i + 1], p[i + 2]);
+        break;
+    case GL_TRIANGLE_STRIP:
+        for (size_t i = 0; i + 2 < n; ++i)
+            AddTriangle(p[i], p[i + 1], p[i + 2]);
+        break;
+    case GL_QUADS:
+        for (size_t i = 0; i + 3 < n; i += 4)
+            AddPolygon(&p[i], 4);
+        break;
+    case GL_QUAD_STRIP:
+        for (size_t i = 0; i + 3 < n; i += 2) {
+            Vertex quad[4] = { p[i], p[i + 1], p[i + 3], p[i + 2] };
+            AddPolygon(quad, 4);
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON:
+        if (n >= 3)
+            AddPolygon(p.data(), n);
+        break;
+    default:
+        break; // points are not used by the drawings
+    }
+    FlushPolygon();
+    FlushSegments();
+}
+
+void VectorExporter::DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) {
+    const PackedVertex* v = vertices + first;
+    auto toVertex = [](const PackedVertex& p) {
+        Vertex vertex = { p.x, p.y, packedColor(p) };
+        return vertex;
+    };
+    if (mode == GL_LINES) {
+        for (size_t i = 0; i + 1 < count; i += 2)
+            AddSegment(toVertex(v[i]), toVertex(v[i + 1]));
+    }
+    else if (mode == GL_TRIANGLES) {
+        for (size_t i = 0; i + 2 < count; i += 3)
+            AddTriangle(toVertex(v[i]), toVertex(v[i + 1]), toVertex(v[i + 2]));
+    }
+    FlushPolygon();
+    FlushSegments();
+}
+
+void VectorExporter::DrawLines(const float* positions, size_t first, size_t count) {
+    const float* p = positions + first * 4;
+    for (size_t i = 0; i < count; ++i, p += 4) {
+        Vertex a = { p[0], p[1], color }, b = { p[2], p[3], color };
+        AddSegment(a, b);
+    }
+    FlushSegments();
+}
+
+WorldPoint VectorExporter::ToWorld(float x, float y) const {
+    WorldPoint p = { x + renderOrigin.x, y + renderOrigin.y };
+    return p;
+}
+
+std::uint32_t VectorExporter::Effective(std::uint32_t rgba) const {
+    // Alpha only shows when blending is on
+    if (blendEnabled && alphaBlendFunc)
+        return rgba;
+    return rgba | 0xff000000;
+}
+
+double VectorExporter::Tolerance() const {
+    double perPixel = std::min((right - left) / (double)width, (top - bottom) / (double)height);
+    return 0.01 * perPixel;
+}
+
+// ------------------ Lines ------------------
+
+void VectorExporter::AddSegment(const Vertex& a, const Vertex& b) {
+    std::uint32_t colors[2] = { a.color, b.color };
+    Segment s = { ToWorld(a.x, a.y), ToWorld(b.x, b.y), Effective(meanColor(colors, 2)) };
+    segments.push_back(s);
+}
+
+void VectorExporter::FlushSegments() {
+    if (segments.empty())
+        return;
+    stats.segmentsIn += (long long)segments.size();
+    if (!writer) {
+        segments.clear();
+        return;
+    }
+
+    double tolerance = Tolerance();
+    keys.clear();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        Segment& s = segments[i];
+        double dx = s.b.x - s.a.x, dy = s.b.y - s.a.y;
+        if (dx < 0.0 || (dx == 0.0 && dy < 0.0)) {
+            std::swap(s.a, s.b);
+            dx = -dx;
+            dy = -dy;
+        }
+        double length = std::sqrt(dx * dx + dy * dy);
+        if (length < tolerance)
+            continue;   // GL draws nothing for a zero-length line
+        double ux = dx / length, uy = dy / length;
+
+        SegmentKey key;
+        key.color = s.color;
+        key.angle = std::llround(std::atan2(uy, ux) * 1e6);
+        key.offset = std::llround((s.a.x * uy - s.a.y * ux) / tolerance);
+        key.t0 = s.a.x * ux + s.a.y * uy;
+        key.t1 = key.t0 + length;
+        key.index = i;
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end(), [](const SegmentKey& p, const SegmentKey& q) {
+        if (p.color != q.color) return p.color < q.color;
+        if (p.angle != q.angle) return p.angle < q.angle;
+        if (p.offset != q.offset) return p.offset < q.offset;
+        return p.t0 < q.t0;
+    });
+
+    // Sweep each line's segments, joining those that touch or overlap. The
+    // merged segments are then written in the order their first piece was
+    // submitted, which keeps strips chained and the painter's order intact.
+    runs.clear();
+    for (size_t i = 0; i < keys.size();) {
+        const SegmentKey& first = keys[i];
+        Segment run = segments[first.index];
+        size_t order = first.index;
+        double end = first.t1;
+        size_t j = i + 1;
+        for (; j < keys.size(); ++j) {
+            const SegmentKey& next = keys[j];
+            if (next.color != first.color || next.angle != first.angle || next.offset != first.offset ||
+                next.t0 > end + tolerance)
+                break;
+            if (next.t1 > end) {
+                end = next.t1;
+                run.b = segments[next.index].b;
+            }
+            order = std::min(order, next.index);
+        }
+        runs.push_back({ order, run });
+        i = j;
+    }
+    std::sort(runs.begin(), runs.end(), [](const Run& p, const Run& q) { return p.order < q.order; });
+
+    if (!runs.empty())
+        lastWasFill = false;
+    for (const Run& r : runs)
+        writer->Line(r.segment.a.x, r.segment.a.y, r.segment.b.x, r.segment.b.y, r.segment.color, lineWidth);
+    stats.segmentsOut += (long long)runs.size();
+    segments.clear();
+}
+
+// ------------------ Fills ------------------
+
+// Twice the signed area of (a, b, c); positive when counter-clockwise
+static float orientation(float ax, float ay, float bx, float by, float cx, float cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+void VectorExporter::AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    ++stats.trianglesIn;
+    float area = orientation(a.x, a.y, b.x, b.y, c.x, c.y);
+    bool flat = a.color == b.color && b.color == c.color;
+
+    // Continues the fan (p0, .., b) when it shares p0 and the last edge and
+    // turns the same way
+    if (flat && !polygon.empty() && a.color == polygonColor &&
+        a.x == polygon[0].x && a.y == polygon[0].y &&
+        b.x == polygon.back().x && b.y == polygon.back().y &&
+        (area == 0.0f || (area < 0.0f) == polygonClockwise)) {
+        polygon.push_back(c);
+        return;
+    }
+
+    FlushPolygon();
+    if (area == 0.0f)
+        return;
+    if (!flat) {
+        // Shaded: written on its own in its mean colour
+        Vertex triangle[3] = { a, b, c };
+        EmitFill(triangle, 3, nullptr);
+        return;
+    }
+    polygon.push_back(a);
+    polygon.push_back(b);
+    polygon.push_back(c);
+    polygonColor = a.color;
+    polygonClockwise = area < 0.0f;
+}
+
+void VectorExporter::AddPolygon(const Vertex* vertices, size_t count) {
+    FlushPolygon();
+    stats.trianglesIn += (long long)(count - 2);
+
+    bool flat = true;
+    for (size_t i = 1; i < count && flat; ++i)
+        flat = vertices[i].color == vertices[0].color;
+    if (flat) {
+        EmitFill(vertices, count, nullptr);
+        return;
+    }
+
+    // A shaded fan is written triangle by triangle, each in its own mean colour
+    for (size_t i = 1; i + 1 < count; ++i) {
+        Vertex triangle[3] = { vertices[0], vertices[i], vertices[i + 1] };
+        EmitFill(triangle, 3, nullptr);
+    }
+}
+
+void VectorExporter::FlushPolygon() {
+    if (polygon.empty())
+        return;
+    EmitFill(polygon.data(), polygon.size(), &polygonColor);
+    polygon.clear();
+}
+
+void VectorExporter::EmitFill(const Vertex* vertices, size_t count, const std::uint32_t* flatColor) {
+    if (!writer)
+        return;
+
+    std::uint32_t fill;
+    if (flatColor)
+        fill = *flatColor;
+    else {
+        colors.clear();
+        for (size_t i = 0; i < count; ++i)
+            colors.push_back(vertices[i].color);
+        fill = meanColor(colors.data(), count);
+    }
+    fill = Effective(fill);
+
+    outline.clear();
+    double area = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        outline.push_back(ToWorld(vertices[i].x, vertices[i].y));
+        const Vertex& p = vertices[i];
+        const Vertex& q = vertices[(i + 1) % count];
+        area += (double)p.x * q.y - (double)q.x * p.y;
+    }
+    if (area == 0.0)
+        return;
+    if (area < 0.0)
+        std::reverse(outline.begin(), outline.end());
+
+    double tolerance = Tolerance();
+    std::uint64_t hash = hashMix(14695981039346656037ull, fill);
+    for (const WorldPoint& p : outline) {
+        hash = hashMix(hash, (std::uint64_t)std::llround(p.x / tolerance));
+        hash = hashMix(hash, (std::uint64_t)std::llround(p.y / tolerance));
+    }
+    if (lastWasFill && hash == lastFill) {
+        ++stats.duplicateFills;
+        return;
+    }
+
+    writer->Fill(outline.data(), outline.size(), fill);
+    lastFill = hash;
+    lastWasFill = true;
+    ++stats.fillsOut;
+}
+
+// ------------------ Export ------------------
+
+bool exportVectorFile(VectorExporter& exporter, const RenderJob& job, VectorFormat format, const std::string& path,
+    VectorExportStats* stats, long long* bytes) {
+    loadSheetCamera(job.zoom, job.scrollX, job.scrollY);
+
+    // Same black page as a --headless image
+    std::unique_ptr<VectorWriter> writer = createVectorWriter(format);
+    if (!writer->Open(path, exporter.Page(0xff000000)))
+        return false;
+
+    exporter.SetWriter(writer.get());
+    for (const SheetView* view : job.drawList)
+        drawSheetView(*view);
+    if (stats)
+        *stats = exporter.Stats();
+    exporter.SetWriter(nullptr);
+
+    bool ok = writer->Close();
+    if (!ok)
+        std::fprintf(stderr, "export: could not write %s\n", path.c_str());
+    if (bytes)
+        *bytes = writer->Bytes();
+    return ok;
+}
+
+int runVectorExport(const CommandLine& options, const std::vector<SheetView>& views) {
+    std::vector<RenderJob> jobs = selectRenderJobs(options, views);
+    if (jobs.empty()) {
+        std::fprintf(stderr, "export: unknown view '%s'\n", options.view.c_str());
+        printUsage();
+        return -1;
+    }
+
+    VectorExporter exporter(options.width, options.height);
+    setRenderBackend(&exporter);
+
+    int exitCode = 0;
+    long long totalBytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const RenderJob& job : jobs) {
+        std::string path = options.outputDir + "/" + job.name + "." + vectorExtension(options.vectorFormat);
+        VectorExportStats stats;
+        long long bytes = 0;
+        if (!exportVectorFile(exporter, job, options.vectorFormat, path, &stats, &bytes)) {
+            exitCode = -1;
+            continue;
+        }
+        totalBytes += bytes;
+        std::printf("export: %s  %lld segments -> %lld lines, %lld triangles -> %lld fills (%lld duplicates), %lld KB\n",
+            path.c_str(), stats.segmentsIn, stats.segmentsOut, stats.trianglesIn, stats.fillsOut,
+            stats.duplicateFills, (bytes + 1023) / 1024);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    setRenderBackend(nullptr);
+
+    std::printf("export: wrote %d file(s), %lld KB in %.3f s\n",
+        (int)jobs.size(), (totalBytes + 1023) / 1024, seconds);
+    return exitCode;
+}
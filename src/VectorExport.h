@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CommandLine.h"
+#include "Headless.h"
+#include "RenderBackend.h"
+#include "SheetView.h"
+#include "VectorWriter.h"
+
+// ------------------ Vector export ------------------
+// Render backend that turns the views' drawing calls into vector
+// primitives instead of pixels, so a drawing file holds exactly what the
+// Draw() methods put on screen: the same culling, level of detail and
+// painter's order as an image of the same size.
+//
+// Primitives are streamed to a VectorWriter as each draw call ends; only
+// the call in progress is held. On the way:
+//  - line segments of one call that lie on the same line, in the same
+//    colour and width, and touch or overlap are merged into one segment;
+//  - fan-ordered triangles (how GeometryBuffer stores quads, fans and
+//    polygons) are joined back into the polygons they came from;
+//  - a fill identical to the primitive written just before it (same
+//    colour and outline, to the export tolerance) is dropped. A repeat
+//    with anything written in between is kept, since it may paint over
+//    that; only a hash of the last fill is held.
+// Vector formats have flat colours: a shaded primitive takes the mean of
+// its vertex colours.
+
+struct VectorExportStats {
+    long long segmentsIn = 0, segmentsOut = 0;
+    long long trianglesIn = 0, fillsOut = 0;
+    long long duplicateFills = 0;
+
+    void Reset() { *this = VectorExportStats(); }
+};
+
+class VectorExporter : public RenderBackend {
+public:
+    VectorExporter(int width, int height) : width(width), height(height) {}
+
+    // The world window of the last LoadOrtho() as a page of width x height points
+    VectorPage Page(std::uint32_t background) const;
+
+    // Sends primitives to 'writer' (nullptr discards them) and forgets the
+    // fills written so far
+    void SetWriter(VectorWriter* target);
+
+    const VectorExportStats& Stats() const { return stats; }
+
+    // ---- RenderBackend ----
+    void LoadOrtho(float left, float right, float bottom, float top) override;
+    void GetViewport(int& viewportWidth, int& viewportHeight) const override;
+    void GetModelview(float matrix[16]) const override;
+
+    void Begin(GLenum mode) override;
+    void End() override;
+    void Vertex2f(float x, float y) override;
+    void Color4f(float r, float g, float b, float a) override;
+    void LineWidth(float width) override { lineWidth = width; }
+    void Enable(GLenum cap) override;
+    void Disable(GLenum cap) override;
+    void BlendFunc(GLenum source, GLenum destination) override;
+    void Hint(GLenum, GLenum) override {}
+
+    bool UsesOpenGL() const override { return false; }
+    void DrawArrays(GLenum mode, const PackedVertex* vertices, size_t first, size_t count) override;
+    void DrawLines(const float* positions, size_t first, size_t count) override;
+    void Finish() override {}
+
+private:
+    struct Vertex {
+        float x, y;     // render space
+        std::uint32_t color;
+    };
+
+    struct Segment {
+        WorldPoint a, b;
+        std::uint32_t color;
+    };
+
+    // Segment and its line: direction and distance from the origin,
+    // quantized to the tolerance, and its extent along that line
+    struct SegmentKey {
+        std::uint32_t color;
+        long long angle, offset;
+        double t0, t1;
+        size_t index;
+    };
+
+    // Merged segment and the submission index of its first piece
+    struct Run {
+        size_t order;
+        Segment segment;
+    };
+
+    WorldPoint ToWorld(float x, float y) const;
+    std::uint32_t Effective(std::uint32_t rgba) const;
+
+    // A hundredth of a pixel in world units: how close points must be to
+    // count as the same when merging and deduplicating
+    double Tolerance() const;
+
+    void AddSegment(const Vertex& a, const Vertex& b);
+    void FlushSegments();
+    void AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+    void AddPolygon(const Vertex* vertices, size_t count);
+    void FlushPolygon();
+
+    // Writes a polygon in its flat colour (or the mean of its vertex
+    // colours), counter-clockwise, unless it repeats the last primitive
+    void EmitFill(const Vertex* vertices, size_t count, const std::uint32_t* flatColor);
+
+    int width, height;
+    float left = -1.0f, right = 1.0f, bottom = -1.0f, top = 1.0f;
+    VectorWriter* writer = nullptr;
+    VectorExportStats stats;
+
+    std::uint32_t color = 0xffffffff;
+    float lineWidth = 1.0f;
+    bool blendEnabled = false;
+    bool alphaBlendFunc = false;
+
+    GLenum pendingMode = GL_LINES;
+    std::vector<Vertex> pending;            // between Begin() and End()
+    bool recording = false;
+
+    std::vector<Segment> segments;          // lines of the current draw call
+    std::vector<SegmentKey> keys;           // scratch for the merge
+    std::vector<Run> runs;
+
+    // Polygon being rebuilt from fan-ordered triangles, in render space
+    std::vector<Vertex> polygon;
+    std::uint32_t polygonColor = 0;
+    bool polygonClockwise = false;
+    std::vector<WorldPoint> outline;        // scratch for the writer
+    std::vector<std::uint32_t> colors;
+
+    std::uint64_t lastFill = 0;             // hash of the last primitive written,
+    bool lastWasFill = false;               // if it was a fill
+};
+
+// Draws 'job' through 'exporter' (the active render backend) into a new
+// vector file at 'path'. Returns false (after printing why) on failure.
+bool exportVectorFile(VectorExporter& exporter, const RenderJob& job, VectorFormat format, const std::string& path,
+    VectorExportStats* stats = nullptr, long long* bytes = nullptr);
+
+// Exports the views --view selects as one vector file per view (--format
+// svg|pdf|dxf), framed as the matching --headless image would be. Returns
+// the process exit code.
+int runVectorExport(const CommandLine& options, const std::vector<SheetView>& views);
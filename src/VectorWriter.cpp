@@ -0,0 +1,619 @@
+#include "VectorWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+const char* vectorExtension(VectorFormat format) {
+    switch (format) {
+    case VectorFormat::PDF: return "pdf";
+    case VectorFormat::DXF: return "dxf";
+    default: return "svg";
+    }
+}
+
+static unsigned channel(std::uint32_t color, int shift) {
+    return (color >> shift) & 0xff;
+}
+
+// ------------------ Buffered output ------------------
+
+// A file written through a fixed buffer, with the number formatting the
+// writers need. Write errors are remembered and reported by Close().
+class OutputFile {
+public:
+    ~OutputFile() { Close(); }
+
+    bool Open(const std::string& path) {
+        file = std::fopen(path.c_str(), "wb");
+        used = 0;
+        bytes = 0;
+        ok = file != nullptr;
+        return ok;
+    }
+
+    bool Close() {
+        if (!file)
+            return ok;
+        Drain();
+        ok &= std::fclose(file) == 0;
+        file = nullptr;
+        return ok;
+    }
+
+    long long Bytes() const { return bytes; }
+
+    void Write(const char* data, size_t length) {
+        if (used + length > sizeof(buffer))
+            Drain();
+        if (length > sizeof(buffer))
+            ok &= std::fwrite(data, 1, length, file) == length;
+        else {
+            std::memcpy(buffer + used, data, length);
+            used += length;
+        }
+        bytes += length;
+    }
+
+    void Text(const char* text) { Write(text, std::strlen(text)); }
+
+    void Char(char c) {
+        if (used == sizeof(buffer))
+            Drain();
+        buffer[used++] = c;
+        ++bytes;
+    }
+
+    void Integer(long long value) {
+        char digits[24];
+        int n = 0;
+        unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long)value : (unsigned long long)value;
+        do {
+            digits[n++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0)
+            Char('-');
+        while (n)
+            Char(digits[--n]);
+    }
+
+    // 'value' in units of 10^-decimals, written as a decimal with the
+    // trailing zeros dropped ("12.5", "3", "-0.07")
+    void Fixed(long long value, int decimals) {
+        long long scale = 1;
+        for (int i = 0; i < decimals; ++i)
+            scale *= 10;
+        if (value < 0) {
+            Char('-');
+            value = -value;
+        }
+        Integer(value / scale);
+        long long fraction = value % scale;
+        if (fraction == 0)
+            return;
+        Char('.');
+        for (long long digit = scale / 10; digit > 0 && fraction > 0; digit /= 10) {
+            Char((char)('0' + fraction / digit));
+            fraction %= digit;
+        }
+    }
+
+    void Hex(unsigned value, int digitCount) {
+        static const char kDigits[] = "0123456789abcdef";
+        for (int shift = 4 * (digitCount - 1); shift >= 0; shift -= 4)
+            Char(kDigits[(value >> shift) & 0xf]);
+    }
+
+private:
+    void Drain() {
+        if (used)
+            ok &= std::fwrite(buffer, 1, used, file) == used;
+        used = 0;
+    }
+
+    FILE* file = nullptr;
+    char buffer[1 << 16];
+    size_t used = 0;
+    long long bytes = 0;
+    bool ok = false;
+};
+
+// Page coordinates in hundredths of a point; two decimals are finer than
+// any printer or screen resolves
+typedef long long Centi;
+
+static Centi toCenti(double v) {
+    return (Centi)std::llround(v * 100.0);
+}
+
+// Maps the page window to points, y up
+struct PageMapping {
+    double minX, minY, scaleX, scaleY;
+
+    void Set(const VectorPage& page) {
+        minX = page.minX;
+        minY = page.minY;
+        scaleX = page.width / (page.maxX - page.minX);
+        scaleY = page.height / (page.maxY - page.minY);
+    }
+
+    Centi X(double x) const { return toCenti((x - minX) * scaleX); }
+    Centi Y(double y) const { return toCenti((y - minY) * scaleY); }
+};
+
+// ------------------ SVG ------------------
+// Consecutive opaque primitives of one style share a <path>; a line that
+// starts where the previous one ended continues the subpath without a
+// moveto. Translucent primitives get an element each, so overlaps blend as
+// they do on screen.
+
+class SvgWriter : public VectorWriter {
+public:
+    bool Open(const std::string& path, const VectorPage& page) override {
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "export: could not create %s\n", path.c_str());
+            return false;
+        }
+        mapping.Set(page);
+        height = (Centi)page.height * 100;
+
+        file.Text("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+        file.Integer(page.width);
+        file.Text("\" height=\"");
+        file.Integer(page.height);
+        file.Text("\" viewBox=\"0 0 ");
+        file.Integer(page.width);
+        file.Char(' ');
+        file.Integer(page.height);
+        file.Text("\">\n<rect width=\"100%\" height=\"100%\" fill=\"");
+        Color(page.background);
+        file.Text("\"/>\n");
+        element = Element::None;
+        return true;
+    }
+
+    void Line(double x1, double y1, double x2, double y2, std::uint32_t color, float width) override {
+        Centi w = toCenti(width);
+        if (element != Element::Stroke || color != style || w != strokeWidth || channel(color, 24) != 255) {
+            EndElement();
+            file.Text("<path fill=\"none\" stroke=\"");
+            Color(color);
+            file.Text("\" stroke-width=\"");
+            file.Fixed(w, 2);
+            Opacity("stroke-opacity", color);
+            file.Text("\" d=\"");
+            element = Element::Stroke;
+            style = color;
+            strokeWidth = w;
+        }
+
+        Centi ax = mapping.X(x1), ay = height - mapping.Y(y1);
+        Centi bx = mapping.X(x2), by = height - mapping.Y(y2);
+        if (!continuing || ax != lastX || ay != lastY) {
+            file.Char('M');
+            Point(ax, ay);
+        }
+        file.Char('L');
+        Point(bx, by);
+        continuing = true;
+        lastX = bx;
+        lastY = by;
+    }
+
+    void Fill(const WorldPoint* points, size_t count, std::uint32_t color) override {
+        if (element != Element::Fill || color != style || channel(color, 24) != 255) {
+            EndElement();
+            file.Text("<path fill=\"");
+            Color(color);
+            Opacity("fill-opacity", color);
+            file.Text("\" d=\"");
+            element = Element::Fill;
+            style = color;
+        }
+
+        file.Char('M');
+        Point(mapping.X(points[0].x), height - mapping.Y(points[0].y));
+        file.Char('L');
+        for (size_t i = 1; i < count; ++i) {
+            if (i > 1)
+                file.Char(' ');
+            Point(mapping.X(points[i].x), height - mapping.Y(points[i].y));
+        }
+        file.Char('Z');
+    }
+
+    bool Close() override {
+        EndElement();
+        file.Text("</svg>\n");
+        return file.Close();
+    }
+
+    long long Bytes() const override { return file.Bytes(); }
+
+private:
+    enum class Element { None, Stroke, Fill };
+
+    void EndElement() {
+        if (element != Element::None)
+            file.Text("\"/>\n");
+        element = Element::None;
+        continuing = false;
+    }
+
+    void Point(Centi x, Centi y) {
+        file.Fixed(x, 2);
+        file.Char(' ');
+        file.Fixed(y, 2);
+    }
+
+    void Color(std::uint32_t color) {
+        file.Char('#');
+        file.Hex(channel(color, 0), 2);
+        file.Hex(channel(color, 8), 2);
+        file.Hex(channel(color, 16), 2);
+    }
+
+    void Opacity(const char* attribute, std::uint32_t color) {
+        unsigned alpha = channel(color, 24);
+        if (alpha == 255)
+            return;
+        file.Text("\" ");
+        file.Text(attribute);
+        file.Text("=\"");
+        file.Fixed((alpha * 1000 + 127) / 255, 3);
+    }
+
+    OutputFile file;
+    PageMapping mapping;
+    Centi height = 0;
+
+    Element element = Element::None;
+    std::uint32_t style = 0;
+    Centi strokeWidth = 0;
+    bool continuing = false;
+    Centi lastX = 0, lastY = 0;
+};
+
+// ------------------ PDF ------------------
+// A single-page PDF 1.4 with an uncompressed content stream. The stream is
+// written as the primitives arrive, so its length and the opacity states it
+// uses go into objects after it. Graphics state (colour, width, opacity)
+// is only set when it changes, and consecutive opaque primitives of one
+// style are painted by one operator.
+
+class PdfWriter : public VectorWriter {
+public:
+    bool Open(const std::string& path, const VectorPage& page) override {
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "export: could not create %s\n", path.c_str());
+            return false;
+        }
+        mapping.Set(page);
+        offsets.assign(kObjectCount + 1, 0);
+        std::memset(alphaUsed, 0, sizeof(alphaUsed));
+
+        file.Text("%PDF-1.4\n%\xe2\xe3\xcf\xd3\n");
+        BeginObject(1);
+        file.Text("<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+        BeginObject(2);
+        file.Text("<< /Type /Pages /Kids [3 0 R] /Count 1 >>\nendobj\n");
+        BeginObject(3);
+        file.Text("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 ");
+        file.Integer(page.width);
+        file.Char(' ');
+        file.Integer(page.height);
+        file.Text("] /Contents 4 0 R /Resources 6 0 R >>\nendobj\n");
+        BeginObject(4);
+        file.Text("<< /Length 5 0 R >>\nstream\n");
+        streamStart = file.Bytes();
+
+        // Page background
+        Rgb(page.background);
+        file.Text(" rg\n0 0 ");
+        file.Integer(page.width);
+        file.Char(' ');
+        file.Integer(page.height);
+        file.Text(" re f\n");
+        fillColor = page.background;
+
+        paint = Paint::None;
+        strokeColor = 0xff000000;
+        lineWidth = 100;
+        alpha = 255;
+        return true;
+    }
+
+    void Line(double x1, double y1, double x2, double y2, std::uint32_t color, float width) override {
+        Centi w = toCenti(width);
+        bool opaque = channel(color, 24) == 255;
+        if (paint != Paint::Stroke || (color & 0xffffff) != (strokeColor & 0xffffff) || w != lineWidth ||
+            channel(color, 24) != alpha || !opaque) {
+            EndPaint();
+            if (w != lineWidth) {
+                file.Fixed(w, 2);
+                file.Text(" w\n");
+                lineWidth = w;
+            }
+            if ((color & 0xffffff) != (strokeColor & 0xffffff)) {
+                Rgb(color);
+                file.Text(" RG\n");
+            }
+            strokeColor = color;
+            Alpha(channel(color, 24));
+            paint = Paint::Stroke;
+        }
+
+        Centi ax = mapping.X(x1), ay = mapping.Y(y1);
+        Centi bx = mapping.X(x2), by = mapping.Y(y2);
+        if (!continuing || ax != lastX || ay != lastY) {
+            Point(ax, ay);
+            file.Text(" m ");
+        }
+        Point(bx, by);
+        file.Text(" l\n");
+        continuing = true;
+        lastX = bx;
+        lastY = by;
+    }
+
+    void Fill(const WorldPoint* points, size_t count, std::uint32_t color) override {
+        bool opaque = channel(color, 24) == 255;
+        if (paint != Paint::Fill || (color & 0xffffff) != (fillColor & 0xffffff) ||
+            channel(color, 24) != alpha || !opaque) {
+            EndPaint();
+            if ((color & 0xffffff) != (fillColor & 0xffffff)) {
+                Rgb(color);
+                file.Text(" rg\n");
+            }
+            fillColor = color;
+            Alpha(channel(color, 24));
+            paint = Paint::Fill;
+        }
+
+        Point(mapping.X(points[0].x), mapping.Y(points[0].y));
+        file.Text(" m");
+        for (size_t i = 1; i < count; ++i) {
+            file.Char(' ');
+            Point(mapping.X(points[i].x), mapping.Y(points[i].y));
+            file.Text(" l");
+        }
+        file.Text(" h\n");
+    }
+
+    bool Close() override {
+        EndPaint();
+        long long length = file.Bytes() - streamStart;
+        file.Text("endstream\nendobj\n");
+
+        BeginObject(5);
+        file.Integer(length);
+        file.Text("\nendobj\n");
+
+        // Opacity states: /A<alpha> sets fill and stroke opacity to alpha/255
+        BeginObject(6);
+        file.Text("<< /ExtGState <<");
+        for (int a = 0; a < 256; ++a) {
+            if (!alphaUsed[a])
+                continue;
+            file.Text(" /A");
+            file.Integer(a);
+            file.Text(" << /ca ");
+            file.Fixed((a * 1000 + 127) / 255, 3);
+            file.Text(" /CA ");
+            file.Fixed((a * 1000 + 127) / 255, 3);
+            file.Text(" >>");
+        }
+        file.Text(" >> >>\nendobj\n");
+
+        long long xref = file.Bytes();
+        file.Text("xref\n0 ");
+        file.Integer(kObjectCount + 1);
+        file.Text("\n0000000000 65535 f \n");
+        for (int i = 1; i <= kObjectCount; ++i) {
+            char entry[24];
+            std::snprintf(entry, sizeof(entry), "%010lld 00000 n \n", offsets[i]);
+            file.Text(entry);
+        }
+        file.Text("trailer\n<< /Size ");
+        file.Integer(kObjectCount + 1);
+        file.Text(" /Root 1 0 R >>\nstartxref\n");
+        file.Integer(xref);
+        file.Text("\n%%EOF\n");
+        return file.Close();
+    }
+
+    long long Bytes() const override { return file.Bytes(); }
+
+private:
+    enum class Paint { None, Stroke, Fill };
+
+    static const int kObjectCount = 6;
+
+    void BeginObject(int number) {
+        offsets[number] = file.Bytes();
+        file.Integer(number);
+        file.Text(" 0 obj\n");
+    }
+
+    void EndPaint() {
+        if (paint == Paint::Stroke)
+            file.Text("S\n");
+        else if (paint == Paint::Fill)
+            file.Text("f\n");
+        paint = Paint::None;
+        continuing = false;
+    }
+
+    void Alpha(unsigned a) {
+        if (a == alpha)
+            return;
+        alphaUsed[a] = true;
+        file.Text("/A");
+        file.Integer(a);
+        file.Text(" gs\n");
+        alpha = a;
+    }
+
+    void Rgb(std::uint32_t color) {
+        for (int shift = 0; shift < 24; shift += 8) {
+            if (shift)
+                file.Char(' ');
+            file.Fixed((channel(color, shift) * 1000 + 127) / 255, 3);
+        }
+    }
+
+    void Point(Centi x, Centi y) {
+        file.Fixed(x, 2);
+        file.Char(' ');
+        file.Fixed(y, 2);
+    }
+
+    OutputFile file;
+    PageMapping mapping;
+    std::vector<long long> offsets;
+    long long streamStart = 0;
+    bool alphaUsed[256];
+
+    Paint paint = Paint::None;
+    std::uint32_t strokeColor = 0, fillColor = 0;
+    Centi lineWidth = 100;
+    unsigned alpha = 255;
+    bool continuing = false;
+    Centi lastX = 0, lastY = 0;
+};
+
+// ------------------ DXF ------------------
+// AutoCAD R12 ASCII: LINE entities for lines and SOLID entities (at most
+// four corners each) for fills, in world units. R12 has no true colour
+// (group 420 came with R2004), so every entity carries the nearest basic
+// ACI colour. Line widths and opacity are not written.
+
+// Basic AutoCAD colour indices 1 to 9
+static const unsigned char kAciColors[9][3] = {
+    { 255, 0, 0 }, { 255, 255, 0 }, { 0, 255, 0 }, { 0, 255, 255 }, { 0, 0, 255 },
+    { 255, 0, 255 }, { 255, 255, 255 }, { 128, 128, 128 }, { 192, 192, 192 }
+};
+
+static int nearestAci(std::uint32_t color) {
+    int best = 7;
+    long bestDistance = -1;
+    for (int i = 0; i < 9; ++i) {
+        long distance = 0;
+        for (int k = 0; k < 3; ++k) {
+            long d = (long)channel(color, 8 * k) - kAciColors[i][k];
+            distance += d * d;
+        }
+        if (bestDistance < 0 || distance < bestDistance) {
+            bestDistance = distance;
+            best = i + 1;
+        }
+    }
+    return best;
+}
+
+class DxfWriter : public VectorWriter {
+public:
+    bool Open(const std::string& path, const VectorPage& page) override {
+        if (!file.Open(path)) {
+            std::fprintf(stderr, "export: could not create %s\n", path.c_str());
+            return false;
+        }
+
+        Group(0, "SECTION");
+        Group(2, "HEADER");
+        Group(9, "$ACADVER");
+        Group(1, "AC1009");
+        Group(9, "$EXTMIN");
+        Coordinate(10, page.minX);
+        Coordinate(20, page.minY);
+        Group(9, "$EXTMAX");
+        Coordinate(10, page.maxX);
+        Coordinate(20, page.maxY);
+        Group(0, "ENDSEC");
+        Group(0, "SECTION");
+        Group(2, "ENTITIES");
+        return true;
+    }
+
+    void Line(double x1, double y1, double x2, double y2, std::uint32_t color, float) override {
+        Entity("LINE", color);
+        Coordinate(10, x1);
+        Coordinate(20, y1);
+        Coordinate(30, 0.0);
+        Coordinate(11, x2);
+        Coordinate(21, y2);
+        Coordinate(31, 0.0);
+    }
+
+    void Fill(const WorldPoint* points, size_t count, std::uint32_t color) override {
+        // Fan the polygon into quads (p0, pi, pi+1, pi+2) and a final
+        // triangle. SOLID lists a quad's corners as 1, 2, 4, 3.
+        for (size_t i = 1; i + 1 < count; i += 2) {
+            const WorldPoint& a = points[0];
+            const WorldPoint& b = points[i];
+            const WorldPoint& c = points[i + 1];
+            const WorldPoint& d = i + 2 < count ? points[i + 2] : c;
+            Entity("SOLID", color);
+            Corner(0, a);
+            Corner(1, b);
+            Corner(2, d);
+            Corner(3, c);
+        }
+    }
+
+    bool Close() override {
+        Group(0, "ENDSEC");
+        Group(0, "EOF");
+        return file.Close();
+    }
+
+    long long Bytes() const override { return file.Bytes(); }
+
+private:
+    void Code(int code) {
+        if (code < 100)
+            file.Char(' ');
+        if (code < 10)
+            file.Char(' ');
+        file.Integer(code);
+        file.Char('\n');
+    }
+
+    void Group(int code, const char* value) {
+        Code(code);
+        file.Text(value);
+        file.Char('\n');
+    }
+
+    void Coordinate(int code, double value) {
+        Code(code);
+        file.Fixed(std::llround(value * 1e6), 6);
+        file.Char('\n');
+    }
+
+    void Corner(int index, const WorldPoint& p) {
+        Coordinate(10 + index, p.x);
+        Coordinate(20 + index, p.y);
+        Coordinate(30 + index, 0.0);
+    }
+
+    void Entity(const char* type, std::uint32_t color) {
+        Group(0, type);
+        Group(8, "0");
+        Code(62);
+        file.Integer(nearestAci(color));
+        file.Char('\n');
+    }
+
+    OutputFile file;
+};
+
+std::unique_ptr<VectorWriter> createVectorWriter(VectorFormat format) {
+    switch (format) {
+    case VectorFormat::PDF: return std::unique_ptr<VectorWriter>(new PdfWriter());
+    case VectorFormat::DXF: return std::unique_ptr<VectorWriter>(new DxfWriter());
+    default: return std::unique_ptr<VectorWriter>(new SvgWriter());
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "RenderOrigin.h"
+
+enum class VectorFormat {
+    SVG,
+    PDF,
+    DXF
+};
+
+// File extension without the dot ("svg" / "pdf" / "dxf")
+const char* vectorExtension(VectorFormat format);
+
+// ------------------ Vector writers ------------------
+// Stream a drawing to a vector file one primitive at a time; nothing but a
+// 64 KB output buffer (and for PDF the set of opacities used) is kept, so a
+// sheet of any size is written in constant memory.
+//
+// Positions are world coordinates. SVG and PDF map the page window onto a
+// page of width x height points (one point per pixel of the matching
+// image, so GL line widths carry over); DXF writes world units unchanged.
+// Colours are RGBA8 packed as in PackedVertex (red in the low byte).
+
+// The world window a page shows and the page's size in points
+struct VectorPage {
+    double minX, minY, maxX, maxY;
+    int width, height;
+    std::uint32_t background;   // opaque RGBA8; not written to DXF
+};
+
+class VectorWriter {
+public:
+    virtual ~VectorWriter() {}
+
+    // Creates 'path' and writes the file header. Returns false (after
+    // printing why) when the file cannot be created.
+    virtual bool Open(const std::string& path, const VectorPage& page) = 0;
+
+    // A line 'width' points wide
+    virtual void Line(double x1, double y1, double x2, double y2, std::uint32_t color, float width) = 0;
+
+    // A filled polygon, counter-clockwise, at least three points
+    virtual void Fill(const WorldPoint* points, size_t count, std::uint32_t color) = 0;
+
+    // Writes the trailer and closes the file. Returns false if any write failed.
+    virtual bool Close() = 0;
+
+    // Bytes written so far
+    virtual long long Bytes() const = 0;
+};
+
+std::unique_ptr<VectorWriter> createVectorWriter(VectorFormat format);
@@ -0,0 +1,213 @@
+#include "VertexStream.h"
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRANSFORM_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRANSFORM_SSE2 1
+#endif
+
+// ------------------ Vertex stream ------------------
+
+void VertexStream::Clear() {
+    x.clear();
+    y.clear();
+    r.clear();
+    g.clear();
+    b.clear();
+    a.clear();
+}
+
+void VertexStream::Reserve(size_t count) {
+    x.reserve(count);
+    y.reserve(count);
+    r.reserve(count);
+    g.reserve(count);
+    b.reserve(count);
+    a.reserve(count);
+}
+
+void VertexStream::Push(const PackedVertex& v) {
+    x.push_back(v.x);
+    y.push_back(v.y);
+    r.push_back(v.r);
+    g.push_back(v.g);
+    b.push_back(v.b);
+    a.push_back(v.a);
+}
+
+void VertexStream::Append(const VertexStream& source, size_t first, size_t count) {
+    size_t last = first + count;
+    x.insert(x.end(), source.x.begin() + first, source.x.begin() + last);
+    y.insert(y.end(), source.y.begin() + first, source.y.begin() + last);
+    r.insert(r.end(), source.r.begin() + first, source.r.begin() + last);
+    g.insert(g.end(), source.g.begin() + first, source.g.begin() + last);
+    b.insert(b.end(), source.b.begin() + first, source.b.begin() + last);
+    a.insert(a.end(), source.a.begin() + first, source.a.begin() + last);
+}
+
+void VertexStream::Pack(std::vector<PackedVertex>& out, float offsetX, float offsetY) const {
+    out.resize(Size());
+    if (offsetX == 0.0f && offsetY == 0.0f) {
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = At(i);
+        return;
+    }
+
+    // Translate a block at a time into scratch arrays, then interleave
+    const size_t kBlock = 256;
+    float blockX[kBlock], blockY[kBlock];
+    Affine2D offset = Affine2D::Placement(1.0f, 1.0f, offsetX, offsetY);
+    for (size_t first = 0; first < out.size(); first += kBlock) {
+        size_t count = out.size() - first < kBlock ? out.size() - first : kBlock;
+        transformPoints(offset, x.data() + first, y.data() + first, blockX, blockY, count);
+        for (size_t i = 0; i < count; ++i) {
+            PackedVertex& v = out[first + i];
+            v = At(first + i);
+            v.x = blockX[i];
+            v.y = blockY[i];
+        }
+    }
+}
+
+// ------------------ Transform kernels ------------------
+
+void transformPointsScalar(const Affine2D& m, const float* x, const float* y, float* outX, float* outY, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float px = x[i];
+        float py = y[i];
+        outX[i] = m.a * px + m.c * py + m.tx;
+        outY[i] = m.b * px + m.d * py + m.ty;
+    }
+}
+
+void transformPoints(const Affine2D& m, const float* x, const float* y, float* outX, float* outY, size_t count) {
+    size_t i = 0;
+#if defined(TRANSFORM_AVX)
+    const __m256 a = _mm256_set1_ps(m.a), b = _mm256_set1_ps(m.b);
+    const __m256 c = _mm256_set1_ps(m.c), d = _mm256_set1_ps(m.d);
+    const __m256 tx = _mm256_set1_ps(m.tx), ty = _mm256_set1_ps(m.ty);
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, px), _mm256_mul_ps(c, py)), tx);
+        __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b, px), _mm256_mul_ps(d, py)), ty);
+        _mm256_storeu_ps(outX + i, rx);
+        _mm256_storeu_ps(outY + i, ry);
+    }
+#elif defined(TRANSFORM_SSE2)
+    const __m128 a = _mm_set1_ps(m.a), b = _mm_set1_ps(m.b);
+    const __m128 c = _mm_set1_ps(m.c), d = _mm_set1_ps(m.d);
+    const __m128 tx = _mm_set1_ps(m.tx), ty = _mm_set1_ps(m.ty);
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, px), _mm_mul_ps(c, py)), tx);
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b, px), _mm_mul_ps(d, py)), ty);
+        _mm_storeu_ps(outX + i, rx);
+        _mm_storeu_ps(outY + i, ry);
+    }
+#endif
+    transformPointsScalar(m, x + i, y + i, outX + i, outY + i, count - i);
+}
+
+void translatePairs(float* xy, size_t count, float offsetX, float offsetY) {
+    size_t n = count * 2;
+    size_t i = 0;
+#if defined(TRANSFORM_AVX)
+    const __m256 offset = _mm256_setr_ps(offsetX, offsetY, offsetX, offsetY, offsetX, offsetY, offsetX, offsetY);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(xy + i, _mm256_add_ps(_mm256_loadu_ps(xy + i), offset));
+#elif defined(TRANSFORM_SSE2)
+    const __m128 offset = _mm_setr_ps(offsetX, offsetY, offsetX, offsetY);
+    for (; i + 4 <= n; i += 4)
+        _mm_storeu_ps(xy + i, _mm_add_ps(_mm_loadu_ps(xy + i), offset));
+#endif
+    for (; i < n; i += 2) {
+        xy[i] += offsetX;
+        xy[i + 1] += offsetY;
+    }
+}
+
+const char* transformKernelName() {
+#if defined(TRANSFORM_AVX)
+    return "avx";
+#elif defined(TRANSFORM_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void transformStream(const Affine2D& m, VertexStream& stream, size_t first) {
+    if (first >= stream.Size())
+        return;
+    float* x = stream.x.data() + first;
+    float* y = stream.y.data() + first;
+    transformPoints(m, x, y, x, y, stream.Size() - first);
+}
+
+// ------------------ Equivalence check ------------------
+
+bool checkTransformKernel(int trials, unsigned seed, std::FILE* out) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> coefficient(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_int_distribution<int> length(0, 1000);
+    std::uniform_int_distribution<int> misalign(0, 7);
+
+    std::vector<float> x, y, simdX, simdY, scalarX, scalarY;
+    long long points = 0;
+    double worst = 0.0;     // largest difference, in units of the tolerance
+
+    for (int trial = 0; trial < trials; ++trial) {
+        Affine2D m;
+        m.a = coefficient(random);
+        m.b = coefficient(random);
+        m.c = coefficient(random);
+        m.d = coefficient(random);
+        m.tx = coefficient(random) * 20.0f;
+        m.ty = coefficient(random) * 20.0f;
+
+        size_t count = (size_t)length(random);
+        size_t offset = (size_t)misalign(random); // start off the vector alignment
+        x.resize(offset + count);
+        y.resize(offset + count);
+        for (size_t i = 0; i < offset + count; ++i) {
+            x[i] = coordinate(random);
+            y[i] = coordinate(random);
+        }
+        simdX.assign(offset + count, 0.0f);
+        simdY.assign(offset + count, 0.0f);
+        scalarX.assign(offset + count, 0.0f);
+        scalarY.assign(offset + count, 0.0f);
+
+        transformPoints(m, x.data() + offset, y.data() + offset, simdX.data() + offset, simdY.data() + offset, count);
+        transformPointsScalar(m, x.data() + offset, y.data() + offset, scalarX.data() + offset, scalarY.data() + offset, count);
+
+        for (size_t i = offset; i < offset + count; ++i) {
+            // A few ulps of the terms' magnitude, in case the compiler fused a multiply-add
+            float toleranceX = 4.0f * FLT_EPSILON * (std::fabs(m.a * x[i]) + std::fabs(m.c * y[i]) + std::fabs(m.tx)) + FLT_MIN;
+            float toleranceY = 4.0f * FLT_EPSILON * (std::fabs(m.b * x[i]) + std::fabs(m.d * y[i]) + std::fabs(m.ty)) + FLT_MIN;
+            double errorX = std::fabs(simdX[i] - scalarX[i]) / toleranceX;
+            double errorY = std::fabs(simdY[i] - scalarY[i]) / toleranceY;
+            if (errorX > 1.0 || errorY > 1.0 || std::isnan(errorX) || std::isnan(errorY)) {
+                std::fprintf(out, "transform kernel (%s): mismatch in trial %d, point %zu of %zu: "
+                    "(%.9g, %.9g) vs scalar (%.9g, %.9g)\n", transformKernelName(), trial, i - offset, count,
+                    simdX[i], simdY[i], scalarX[i], scalarY[i]);
+                return false;
+            }
+            worst = std::fmax(worst, std::fmax(errorX, errorY));
+        }
+        points += (long long)count;
+    }
+
+    std::fprintf(out, "transform kernel (%s): %d trials, %lld points match the scalar reference "
+        "(worst difference %.3f of tolerance)\n", transformKernelName(), trials, points, worst);
+    return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// Interleaved vertex: position followed by an 8-bit RGBA colour (12 bytes).
+// The layout glVertexPointer/glColorPointer read from.
+struct PackedVertex {
+    float x, y;
+    GLubyte r, g, b, a;
+};
+
+// ------------------ Affine placement ------------------
+// x' = a x + c y + tx
+// y' = b x + d y + ty
+// (the same column order as a GL matrix). Views use it to place geometry
+// drawn in their own units onto the sheet.
+struct Affine2D {
+    float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f, tx = 0.0f, ty = 0.0f;
+
+    // Axis-aligned scale followed by a translation
+    static Affine2D Placement(float scaleX, float scaleY, float offsetX, float offsetY) {
+        Affine2D m;
+        m.a = scaleX;
+        m.d = scaleY;
+        m.tx = offsetX;
+        m.ty = offsetY;
+        return m;
+    }
+};
+
+// ------------------ Vertex stream ------------------
+// Structure-of-arrays vertex storage: every attribute in its own array, so
+// the transform kernels load x[] and y[] a full SIMD register at a time.
+// Interleaved into PackedVertex only when uploaded.
+struct VertexStream {
+    std::vector<float> x, y;
+    std::vector<GLubyte> r, g, b, a;
+
+    size_t Size() const { return x.size(); }
+    bool Empty() const { return x.empty(); }
+
+    void Clear();
+    void Reserve(size_t count);
+    void Push(const PackedVertex& v);
+
+    // Appends vertices [first, first + count) of 'source'
+    void Append(const VertexStream& source, size_t first, size_t count);
+
+    PackedVertex At(size_t i) const { return { x[i], y[i], r[i], g[i], b[i], a[i] }; }
+
+    // Interleaves the whole stream into 'out' (resized to Size()), moving
+    // every position by (offsetX, offsetY) through the transform kernel
+    void Pack(std::vector<PackedVertex>& out, float offsetX = 0.0f, float offsetY = 0.0f) const;
+};
+
+// ------------------ Transform kernels ------------------
+// Apply 'm' to 'count' points. The output may alias the input (in-place).
+//
+// transformPoints() uses the widest instruction set the build targets: AVX
+// (8 points per step) when compiled with /arch:AVX or higher, SSE2 (4 per
+// step) otherwise on x86/x64, with a scalar tail. transformPointsScalar() is
+// the reference it must match. Both evaluate (a x + c y) + tx in the same
+// order, so without FMA contraction the results are bit-identical.
+
+void transformPointsScalar(const Affine2D& m, const float* x, const float* y, float* outX, float* outY, size_t count);
+void transformPoints(const Affine2D& m, const float* x, const float* y, float* outX, float* outY, size_t count);
+
+// Moves 'count' interleaved x, y pairs by (offsetX, offsetY), in place
+void translatePairs(float* xy, size_t count, float offsetX, float offsetY);
+
+// "avx", "sse2" or "scalar"
+const char* transformKernelName();
+
+// Transforms vertices [first, Size()) of 'stream' in place
+void transformStream(const Affine2D& m, VertexStream& stream, size_t first = 0);
+
+// Randomised equivalence check of transformPoints() against the scalar
+// reference: random matrices, point counts (covering the SIMD tails) and
+// unaligned start offsets. Prints a summary to 'out' and returns false on
+// the first mismatch.
+bool checkTransformKernel(int trials, unsigned seed, std::FILE* out);